@@ -5,6 +5,7 @@
 #include "GameMode/RPGGameMode.h"
 #include "System/RPGGameplayTags.h"
 #include "System/RPGLogChannels.h"
+#include "System/RPGTimerWheelSubsystem.h"
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "Messages/RPGRespawnMessage.h"
@@ -16,6 +17,7 @@
 #include "AbilitySystem/Attributes/RPGAttributeSet.h"
 #include "UIExtensionSystem.h"
 #include "Blueprint/UserWidget.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGGA_AutoRespawn)
 
@@ -144,8 +146,16 @@ void URPGGA_AutoRespawn::OnDeathStarted(AActor* OwningActor)
 		MessageSubsystem->BroadcastMessage(RPGGameplayTags::Message_Respawn_Duration, Message);
 	}
 
-	// Start timer for execution
-	GetWorld()->GetTimerManager().SetTimer(RespawnTimerHandle, this, &ThisClass::ExecuteRespawn, RespawnDelayDuration, false);
+	// Start timer for execution, the wheel drops it if this ability instance goes away first
+	if (URPGTimerWheelSubsystem* TimerWheel = URPGTimerWheelSubsystem::Get(this))
+	{
+		TimerWheel->ClearTimer(RespawnTimerHandle);
+		RespawnTimerHandle = TimerWheel->SetTimer(this, &ThisClass::ExecuteRespawn, RespawnDelayDuration);
+	}
+	else
+	{
+		GetWorld()->GetTimerManager().SetTimer(RespawnFallbackTimerHandle, this, &ThisClass::ExecuteRespawn, RespawnDelayDuration, false);
+	}
 }
 
 void URPGGA_AutoRespawn::ExecuteRespawn()
@@ -161,7 +171,24 @@ void URPGGA_AutoRespawn::ExecuteRespawn()
 		RPGASC->FullResetAttributes();
 	}
 
-	// 3. Request restart from GameMode
+	// 3. Get rid of the old avatar actor to prevent "ghost" bodies. Characters finish their death sequence now,
+	// which parks them to be handed back to us; the deferred end of death queued by the death ability is bound
+	// to the life that died and does nothing once the character is unparked for the new one.
+	// Done before the restart request, the controller reset unpossesses the pawn and it can't be parked anymore.
+	if (LastBoundAvatarActor)
+	{
+		if (ARPGCharacter* RPGCharacter = Cast<ARPGCharacter>(LastBoundAvatarActor))
+		{
+			RPGCharacter->DestroyDueToDeath();
+		}
+		else
+		{
+			LastBoundAvatarActor->Destroy();
+		}
+		LastBoundAvatarActor = nullptr;
+	}
+
+	// 4. Request restart from GameMode
 	if (ARPGGameMode* GameMode = GetWorld()->GetAuthGameMode<ARPGGameMode>())
 	{
 		AController* Controller = GetPlayerControllerFromActorInfo();
@@ -171,14 +198,7 @@ void URPGGA_AutoRespawn::ExecuteRespawn()
 		}
 	}
 
-	// 3. Destroy the old avatar actor to prevent "ghost" bodies
-	if (LastBoundAvatarActor)
-	{
-		LastBoundAvatarActor->Destroy();
-		LastBoundAvatarActor = nullptr;
-	}
-
-	// 4. Broadcast completion message
+	// 5. Broadcast completion message
 	if (UGameplayMessageSubsystem* MessageSubsystem = UGameInstance::GetSubsystem<UGameplayMessageSubsystem>(GetWorld()->GetGameInstance()))
 	{
 		FRPGVerbMessage Message;
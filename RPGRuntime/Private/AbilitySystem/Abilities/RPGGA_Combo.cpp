@@ -3,13 +3,35 @@
 #include "AbilitySystem/Abilities/RPGGA_Combo.h"
 #include "AbilitySystemComponent.h"
 #include "System/RPGGameplayTags.h"
-#include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
-#include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "AbilitySystem/Abilities/Tasks/RPGAbilityTask_ComboGraph.h"
+#include "AbilitySystem/Abilities/Tasks/RPGAbilityTask_MeleeTrace.h"
+#include "AbilitySystemGlobals.h"
 #include "AbilitySystem/RPGAbilitySystemComponent.h"
+#include "Character/RPGCharacter.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
 #include "System/RPGLogChannels.h"
+#include "System/RPGRewindSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGGA_Combo)
 
+namespace RPGCombo
+{
+	// First section of combos that only have a ComboMontage
+	static const FName LegacyEntrySection(TEXT("Attack1"));
+};
+
+namespace RPGConsoleVariables
+{
+	static bool bRewindValidateMeleeHits = true;
+	static FAutoConsoleVariableRef CVarRewindValidateMeleeHits(
+		TEXT("rpg.rewind.ValidateMeleeHits"),
+		bRewindValidateMeleeHits,
+		TEXT("Rejects melee hits of remote players that miss the target rewound to what the player saw."),
+		ECVF_Default);
+};
+
 URPGGA_Combo::URPGGA_Combo(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -27,8 +49,11 @@ void URPGGA_Combo::ActivateAbility(const FGameplayAbilitySpecHandle Handle, cons
 	}
 
 	UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
-	if (!ASC || !ComboMontage)
+	UAnimMontage* Montage = ComboMontage ? ComboMontage.Get() : (ComboGraph ? ComboGraph->GetMontage() : nullptr);
+	const int32 EntryNode = ComboGraph ? ComboGraph->GetEntryNode() : INDEX_NONE;
+	if (!ASC || !Montage || (ComboGraph && (EntryNode == INDEX_NONE)))
 	{
+		UE_LOG(LogRPG, Warning, TEXT("URPGGA_Combo::ActivateAbility: [%s] needs a montage, and a combo graph with at least one node if it uses one."), *GetNameSafe(this));
 		EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
 		return;
 	}
@@ -38,104 +63,253 @@ void URPGGA_Combo::ActivateAbility(const FGameplayAbilitySpecHandle Handle, cons
 		RPGASC->SetLooseGameplayTagCount(FRPGGameplayTags::Get().Status_Action_Combo, 1);
 	}
 
-	// 1. Start the first attack
-	CurrentSectionName = TEXT("Attack1");
-	bInputBuffered = false;
-
-	// 2. Play Montage and wait for it to end
-	UAbilityTask_PlayMontageAndWait* PlayMontageTask = UAbilityTask_PlayMontageAndWait::CreatePlayMontageAndWaitProxy(
-		this,
-		TEXT("ComboPlayTask"),
-		ComboMontage,
-		1.0f,
-		CurrentSectionName
-	);
-
-	PlayMontageTask->OnCompleted.AddDynamic(this, &ThisClass::K2_EndAbility);
-	PlayMontageTask->OnInterrupted.AddDynamic(this, &ThisClass::K2_EndAbility);
-	PlayMontageTask->OnCancelled.AddDynamic(this, &ThisClass::K2_EndAbility);
-	PlayMontageTask->ReadyForActivation();
-
-	// 3. Listen for Gameplay events (Damage and Transitions)
-	// Transition events: Event.Combo.Transition.XXXX
-	UAbilityTask_WaitGameplayEvent* WaitTransitionTask = UAbilityTask_WaitGameplayEvent::WaitGameplayEvent(
-		this,
-		FRPGGameplayTags::Get().GameplayEvent_Combo_Transition,
-		nullptr,
-		false,
-		false
-	);
-	WaitTransitionTask->EventReceived.AddDynamic(this, &ThisClass::HandleComboEvent);
-	WaitTransitionTask->ReadyForActivation();
-
-	// Damage events: Event.Combo.Damage
-	UAbilityTask_WaitGameplayEvent* WaitDamageTask = UAbilityTask_WaitGameplayEvent::WaitGameplayEvent(
-		this,
-		FRPGGameplayTags::Get().GameplayEvent_Combo_Damage,
-		nullptr,
-		false,
-		false
-	);
-	WaitDamageTask->EventReceived.AddDynamic(this, &ThisClass::HandleComboEvent);
-	WaitDamageTask->ReadyForActivation();
-
-	// 4. Bind Input 
-	// In Lyra/RPG, we can override OnInputPressed if the component informs us
-	// For simplicity in C++, we'll use a direct binding to the spec handle if possible, 
-	// or rely on the AbilitySystemComponent's AbilityInputPressed delegate.
+	// 1. Start at the entry node of the graph. Without a graph the montage is played the legacy way:
+	// Attack1 first, then any press buffers the section named by the next transition event.
+	CurrentNodeIndex = EntryNode;
+	InputBuffer.Reset();
+	bLegacyInputBuffered = false;
+
+	const FName EntrySection = ComboGraph ? ComboGraph->GetNode(EntryNode)->SectionName : RPGCombo::LegacyEntrySection;
+
+	// 2. One task plays the montage and forwards both the transition and damage events
+	const FRPGGameplayTags& GameplayTags = FRPGGameplayTags::Get();
+	FGameplayTagContainer ComboEventTags;
+	ComboEventTags.AddTag(GameplayTags.GameplayEvent_Combo_Transition);
+	ComboEventTags.AddTag(GameplayTags.GameplayEvent_Combo_Damage);
+
+	ComboTask = URPGAbilityTask_ComboGraph::CreateComboGraphTask(this, Montage, EntrySection, ComboEventTags);
+	ComboTask->OnComboEvent.AddUObject(this, &ThisClass::HandleComboEvent);
+	ComboTask->OnMontageEnded.AddUObject(this, &ThisClass::HandleMontageEnded);
+	ComboTask->ReadyForActivation();
 }
 
-void URPGGA_Combo::HandleComboEvent(FGameplayEventData Payload)
+void URPGGA_Combo::HandleComboEvent(FGameplayTag EventTag, const FGameplayEventData& Payload)
 {
 	const FRPGGameplayTags& GameplayTags = FRPGGameplayTags::Get();
 
 	// A. Handle Damage
-	if (Payload.EventTag.MatchesTag(GameplayTags.GameplayEvent_Combo_Damage))
+	if (EventTag.MatchesTag(GameplayTags.GameplayEvent_Combo_Damage))
 	{
-		// Sát thương sẽ được xử lý ở đây (Sweep Trace hoặc Apply GE)
-		// UI/VFX cũng có thể lắng nghe tag này
-		UE_LOG(LogRPG, Log, TEXT("Combo: Gây sát thương tại Section %s"), *CurrentSectionName.ToString());
+		// Chỉ server mới trace và gây sát thương, UI/VFX vẫn có thể lắng nghe tag này
+		if (HasAuthority(&CurrentActivationInfo))
+		{
+			StartDamageWindow(Payload);
+		}
 		return;
 	}
 
 	// B. Handle Transition
-	if (Payload.EventTag.MatchesTag(GameplayTags.GameplayEvent_Combo_Transition))
+	if (EventTag.MatchesTag(GameplayTags.GameplayEvent_Combo_Transition))
 	{
-		// Nếu đã nhấn phím (Buffer), nhảy sang Section tiếp theo
-		if (bInputBuffered)
+		if (!ComboGraph)
+		{
+			HandleLegacyTransition(EventTag);
+			return;
+		}
+
+		const FRPGCompiledComboNode* CurrentNode = ComboGraph->GetNode(CurrentNodeIndex);
+		if (!CurrentNode)
+		{
+			return;
+		}
+
+		// Nếu đã nhấn phím trong cửa sổ input, tìm nhánh tương ứng (Tap/Hold) trong graph
+		ERPGComboInputType InputType = ERPGComboInputType::Any;
+		const float SectionTime = ComboTask ? ComboTask->GetCurrentSectionTime() : -1.0f;
+		if (InputBuffer.Consume(*CurrentNode, SectionTime, GetWorld()->GetTimeSeconds(), ComboGraph->GetInputBufferLifetime(), InputType))
 		{
-			// Lấy tên Section từ Tag (Ví dụ: Event.Combo.Transition.Attack2 -> Attack2)
-			FString TagString = Payload.EventTag.ToString();
-			FString SectionStr;
-			if (TagString.Split(TEXT("."), nullptr, &SectionStr, ESearchCase::IgnoreCase, ESearchDir::FromEnd))
+			const int32 NextNodeIndex = ComboGraph->FindTransition(CurrentNodeIndex, EventTag, InputType);
+			if (NextNodeIndex != INDEX_NONE)
 			{
-				AdvanceToNextSection(FName(*SectionStr));
+				AdvanceToNode(NextNodeIndex);
 			}
 		}
 	}
 }
 
-void URPGGA_Combo::AdvanceToNextSection(FName SectionName)
+void URPGGA_Combo::HandleLegacyTransition(const FGameplayTag& EventTag)
+{
+	// Nếu đã nhấn phím (Buffer), nhảy sang Section tiếp theo
+	if (!bLegacyInputBuffered || !ComboTask)
+	{
+		return;
+	}
+
+	// Lấy tên Section từ Tag (Ví dụ: Event.Combo.Transition.Attack2 -> Attack2)
+	FString SectionStr;
+	if (EventTag.ToString().Split(TEXT("."), nullptr, &SectionStr, ESearchCase::IgnoreCase, ESearchDir::FromEnd))
+	{
+		const FName SectionName(*SectionStr);
+		if (ComboTask->JumpToSection(SectionName))
+		{
+			bLegacyInputBuffered = false;
+
+			UE_LOG(LogRPG, Verbose, TEXT("Combo: Nhảy sang Section %s"), *SectionName.ToString());
+		}
+	}
+}
+
+void URPGGA_Combo::HandleMontageEnded(bool bInterrupted)
 {
-	UAbilitySystemComponent* ASC = GetAbilitySystemComponentFromActorInfo();
-	if (ASC)
+	K2_EndAbility();
+}
+
+void URPGGA_Combo::AdvanceToNode(int32 NodeIndex)
+{
+	const FRPGCompiledComboNode* Node = ComboGraph->GetNode(NodeIndex);
+	if (Node && ComboTask && ComboTask->JumpToSection(Node->SectionName))
 	{
-		// Nhảy Montage
-		ASC->CurrentMontageJumpToSection(SectionName);
-		
 		// Cập nhật trạng thái
-		CurrentSectionName = SectionName;
-		bInputBuffered = false;
-		
-		UE_LOG(LogRPG, Log, TEXT("Combo: Nhảy sang Section %s"), *SectionName.ToString());
+		CurrentNodeIndex = NodeIndex;
+		InputBuffer.Reset();
+
+		UE_LOG(LogRPG, Verbose, TEXT("Combo: Nhảy sang Section %s"), *Node->SectionName.ToString());
+	}
+}
+
+void URPGGA_Combo::StartDamageWindow(const FGameplayEventData& Payload)
+{
+	StopDamageWindow();
+
+	// Node damage first, then the per event map
+	const FRPGCompiledComboNode* CurrentNode = ComboGraph ? ComboGraph->GetNode(CurrentNodeIndex) : nullptr;
+	const TSubclassOf<UGameplayEffect> DamageEffect = (CurrentNode && CurrentNode->DamageEffect) ? CurrentNode->DamageEffect : FindDamageEffectForEvent(Payload.EventTag);
+	if (!DamageEffect)
+	{
+		UE_LOG(LogRPG, Warning, TEXT("URPGGA_Combo::StartDamageWindow: No damage effect mapped for [%s] in [%s]."), *Payload.EventTag.ToString(), *GetNameSafe(this));
+		return;
+	}
+
+	SwingDamageSpec = MakeOutgoingGameplayEffectSpec(DamageEffect, GetAbilityLevel());
+	if (!SwingDamageSpec.IsValid())
+	{
+		return;
+	}
+
+	if (Payload.EventMagnitude > 0.0f)
+	{
+		SwingDamageSpec.Data->SetSetByCallerMagnitude(RPGGameplayTags::SetByCaller_Damage, Payload.EventMagnitude);
+	}
+
+	ActiveMeleeTrace = URPGAbilityTask_MeleeTrace::CreateMeleeTrace(this, MeleeTraceSettings, DamageWindowDuration);
+	ActiveMeleeTrace->OnHit.AddUObject(this, &ThisClass::HandleMeleeHit);
+	ActiveMeleeTrace->ReadyForActivation();
+
+	UE_LOG(LogRPG, Verbose, TEXT("Combo: Gây sát thương tại Section %s"), CurrentNode ? *CurrentNode->SectionName.ToString() : TEXT("None"));
+}
+
+void URPGGA_Combo::StopDamageWindow()
+{
+	if (ActiveMeleeTrace)
+	{
+		ActiveMeleeTrace->EndTask();
+		ActiveMeleeTrace = nullptr;
 	}
+
+	SwingDamageSpec.Clear();
+}
+
+void URPGGA_Combo::HandleMeleeHit(const FHitResult& Hit)
+{
+	AActor* HitActor = Hit.GetActor();
+	if (!SwingDamageSpec.IsValid() || !HitActor || HitActor == GetAvatarActorFromActorInfo())
+	{
+		return;
+	}
+
+	if (!UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(HitActor))
+	{
+		return;
+	}
+
+	if (!ConfirmHitWithRewind(Hit))
+	{
+		return;
+	}
+
+	FGameplayAbilityTargetDataHandle TargetData;
+	TargetData.Add(new FGameplayAbilityTargetData_SingleTargetHit(Hit));
+
+	ApplyGameplayEffectSpecToTarget(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, SwingDamageSpec, TargetData);
+}
+
+bool URPGGA_Combo::ConfirmHitWithRewind(const FHitResult& Hit) const
+{
+	// AI and the listen server host see the same world the server traced
+	const APawn* Avatar = Cast<APawn>(GetAvatarActorFromActorInfo());
+	if (!RPGConsoleVariables::bRewindValidateMeleeHits || !Avatar || !Avatar->IsPlayerControlled() || Avatar->IsLocallyControlled())
+	{
+		return true;
+	}
+
+	const URPGRewindSubsystem* RewindSubsystem = URPGRewindSubsystem::Get(this);
+	const APlayerState* PlayerState = Avatar->GetPlayerState();
+	const ARPGCharacter* Target = Cast<ARPGCharacter>(Hit.GetActor());
+	if (!RewindSubsystem || !PlayerState || !Target)
+	{
+		return true;
+	}
+
+	// Simulated proxies are shown about one round trip behind the server
+	const float ViewTime = GetWorld()->GetTimeSeconds() - (PlayerState->GetPingInMilliseconds() * 0.001f);
+
+	// Targets without history yet keep the server's hit
+	FRPGRewindValidationResult Result;
+	if (!RewindSubsystem->ValidateSweep(Target, ViewTime, Hit.TraceStart, Hit.TraceEnd, MeleeTraceSettings.TraceRadius, Result) || Result.bHit)
+	{
+		return true;
+	}
+
+	UE_LOG(LogRPG, Verbose, TEXT("URPGGA_Combo::ConfirmHitWithRewind: Rejected hit on [%s], %.1f cm away at %.3f."), *GetNameSafe(Target), Result.Distance, Result.RewoundTimestamp);
+	return false;
+}
+
+TSubclassOf<UGameplayEffect> URPGGA_Combo::FindDamageEffectForEvent(const FGameplayTag& EventTag) const
+{
+	if (const TSubclassOf<UGameplayEffect>* ExactMatch = DamageEffectMap.Find(EventTag))
+	{
+		return *ExactMatch;
+	}
+
+	TSubclassOf<UGameplayEffect> BestEffect;
+	int32 BestDepth = -1;
+	for (const TPair<FGameplayTag, TSubclassOf<UGameplayEffect>>& Pair : DamageEffectMap)
+	{
+		if (EventTag.MatchesTag(Pair.Key))
+		{
+			const int32 Depth = Pair.Key.GetGameplayTagParents().Num();
+			if (Depth > BestDepth)
+			{
+				BestDepth = Depth;
+				BestEffect = Pair.Value;
+			}
+		}
+	}
+
+	return BestEffect;
 }
 
 void URPGGA_Combo::OnAbilityInputPressed()
 {
-	// Đánh dấu người chơi muốn đánh đòn tiếp theo
-	bInputBuffered = true;
-	UE_LOG(LogRPG, Log, TEXT("Combo: Đã nhận Input Buffer"));
+	if (!ComboGraph)
+	{
+		// Đánh dấu người chơi muốn đánh đòn tiếp theo
+		bLegacyInputBuffered = (ComboTask != nullptr);
+		return;
+	}
+
+	const FRPGCompiledComboNode* CurrentNode = ComboGraph ? ComboGraph->GetNode(CurrentNodeIndex) : nullptr;
+	const float SectionTime = ComboTask ? ComboTask->GetCurrentSectionTime() : -1.0f;
+	if (!CurrentNode || (SectionTime < 0.0f))
+	{
+		return;
+	}
+
+	// Đánh dấu người chơi muốn đánh đòn tiếp theo, chỉ khi nhấn trong cửa sổ input của node
+	if (InputBuffer.RecordPress(*CurrentNode, SectionTime, GetWorld()->GetTimeSeconds()))
+	{
+		UE_LOG(LogRPG, Verbose, TEXT("Combo: Đã nhận Input Buffer tại %.3fs của Section %s"), SectionTime, *CurrentNode->SectionName.ToString());
+	}
 }
 
 void URPGGA_Combo::InputPressed(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo)
@@ -144,8 +318,21 @@ void URPGGA_Combo::InputPressed(const FGameplayAbilitySpecHandle Handle, const F
 	OnAbilityInputPressed();
 }
 
+void URPGGA_Combo::InputReleased(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo)
+{
+	Super::InputReleased(Handle, ActorInfo, ActivationInfo);
+	InputBuffer.RecordRelease(GetWorld()->GetTimeSeconds());
+}
+
 void URPGGA_Combo::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
 {
+	StopDamageWindow();
+
+	ComboTask = nullptr;
+	CurrentNodeIndex = INDEX_NONE;
+	InputBuffer.Reset();
+	bLegacyInputBuffered = false;
+
 	if (URPGAbilitySystemComponent* ASC = GetRPGAbilitySystemComponentFromActorInfo())
 	{
 		ASC->SetLooseGameplayTagCount(FRPGGameplayTags::Get().Status_Action_Combo, 0);
@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/Abilities/Tasks/RPGAbilityTask_ComboGraph.h"
+#include "AbilitySystemComponent.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "System/RPGLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGAbilityTask_ComboGraph)
+
+URPGAbilityTask_ComboGraph* URPGAbilityTask_ComboGraph::CreateComboGraphTask(UGameplayAbility* OwningAbility, UAnimMontage* Montage, FName StartSection, const FGameplayTagContainer& EventTags, float PlayRate)
+{
+	URPGAbilityTask_ComboGraph* Task = NewAbilityTask<URPGAbilityTask_ComboGraph>(OwningAbility);
+	Task->Montage = Montage;
+	Task->StartSection = StartSection;
+	Task->EventTags = EventTags;
+	Task->PlayRate = PlayRate;
+	return Task;
+}
+
+void URPGAbilityTask_ComboGraph::Activate()
+{
+	Super::Activate();
+
+	UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+	UAnimInstance* AnimInstance = (Ability && Ability->GetCurrentActorInfo()) ? Ability->GetCurrentActorInfo()->GetAnimInstance() : nullptr;
+	if (!ASC || !AnimInstance || !Montage)
+	{
+		UE_LOG(LogRPG, Warning, TEXT("URPGAbilityTask_ComboGraph::Activate: Missing ability system, anim instance or montage for [%s]."), *GetNameSafe(Ability));
+		HandleMontageEnded(Montage, true);
+		return;
+	}
+
+	// Listen before playing, the first section can send events on its first frame
+	EventHandle = ASC->AddGameplayEventTagContainerDelegate(EventTags, FGameplayEventTagMulticastDelegate::FDelegate::CreateUObject(this, &ThisClass::HandleGameplayEvent));
+
+	const float Duration = ASC->PlayMontage(Ability, Ability->GetCurrentActivationInfo(), Montage, PlayRate, StartSection);
+	if (Duration <= 0.0f)
+	{
+		UE_LOG(LogRPG, Warning, TEXT("URPGAbilityTask_ComboGraph::Activate: Failed to play [%s] section [%s]."), *GetNameSafe(Montage), *StartSection.ToString());
+		HandleMontageEnded(Montage, true);
+		return;
+	}
+
+	FOnMontageEnded EndDelegate;
+	EndDelegate.BindUObject(this, &ThisClass::HandleMontageEnded);
+	AnimInstance->Montage_SetEndDelegate(EndDelegate, Montage);
+
+	SetWaitingOnAvatar();
+}
+
+bool URPGAbilityTask_ComboGraph::IsMontagePlaying() const
+{
+	const UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+	return ASC && Montage && (ASC->GetAnimatingAbility() == Ability) && (ASC->GetCurrentMontage() == Montage);
+}
+
+bool URPGAbilityTask_ComboGraph::JumpToSection(FName SectionName)
+{
+	if (!IsMontagePlaying())
+	{
+		return false;
+	}
+
+	AbilitySystemComponent->CurrentMontageJumpToSection(SectionName);
+	return true;
+}
+
+float URPGAbilityTask_ComboGraph::GetCurrentSectionTime() const
+{
+	const UAnimInstance* AnimInstance = (Ability && Ability->GetCurrentActorInfo()) ? Ability->GetCurrentActorInfo()->GetAnimInstance() : nullptr;
+	if (!AnimInstance || !IsMontagePlaying())
+	{
+		return -1.0f;
+	}
+
+	const float Position = AnimInstance->Montage_GetPosition(Montage);
+	const int32 SectionIndex = Montage->GetSectionIndexFromPosition(Position);
+	if (SectionIndex == INDEX_NONE)
+	{
+		return -1.0f;
+	}
+
+	float SectionStart = 0.0f;
+	float SectionEnd = 0.0f;
+	Montage->GetSectionStartAndEndTime(SectionIndex, SectionStart, SectionEnd);
+	return Position - SectionStart;
+}
+
+void URPGAbilityTask_ComboGraph::HandleGameplayEvent(FGameplayTag EventTag, const FGameplayEventData* Payload)
+{
+	if (ShouldBroadcastAbilityTaskDelegates())
+	{
+		FGameplayEventData TempPayload = Payload ? *Payload : FGameplayEventData();
+		TempPayload.EventTag = EventTag;
+		OnComboEvent.Broadcast(EventTag, TempPayload);
+	}
+}
+
+void URPGAbilityTask_ComboGraph::HandleMontageEnded(UAnimMontage* EndedMontage, bool bInterrupted)
+{
+	if (ShouldBroadcastAbilityTaskDelegates())
+	{
+		OnMontageEnded.Broadcast(bInterrupted);
+	}
+
+	EndTask();
+}
+
+void URPGAbilityTask_ComboGraph::OnDestroy(bool bInOwnerFinished)
+{
+	if (UAbilitySystemComponent* ASC = AbilitySystemComponent.Get())
+	{
+		if (EventHandle.IsValid())
+		{
+			ASC->RemoveGameplayEventTagContainerDelegate(EventTags, EventHandle);
+			EventHandle.Reset();
+		}
+
+		if (IsMontagePlaying())
+		{
+			// Don't call back into a task that is going away
+			if (UAnimInstance* AnimInstance = Ability->GetCurrentActorInfo()->GetAnimInstance())
+			{
+				if (FOnMontageEnded* EndDelegate = AnimInstance->Montage_GetEndedDelegate(Montage))
+				{
+					EndDelegate->Unbind();
+				}
+			}
+
+			if (bInOwnerFinished)
+			{
+				ASC->CurrentMontageStop();
+			}
+		}
+	}
+
+	Super::OnDestroy(bInOwnerFinished);
+}
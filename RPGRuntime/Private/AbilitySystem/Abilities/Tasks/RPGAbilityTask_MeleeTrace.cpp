@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/Abilities/Tasks/RPGAbilityTask_MeleeTrace.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "System/RPGLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGAbilityTask_MeleeTrace)
+
+URPGAbilityTask_MeleeTrace::URPGAbilityTask_MeleeTrace(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bTickingTask = true;
+}
+
+URPGAbilityTask_MeleeTrace* URPGAbilityTask_MeleeTrace::CreateMeleeTrace(UGameplayAbility* OwningAbility, const FRPGMeleeTraceSettings& Settings, float WindowDuration)
+{
+	URPGAbilityTask_MeleeTrace* Task = NewAbilityTask<URPGAbilityTask_MeleeTrace>(OwningAbility);
+	Task->Settings = Settings;
+	Task->WindowDuration = WindowDuration;
+	return Task;
+}
+
+void URPGAbilityTask_MeleeTrace::Activate()
+{
+	Super::Activate();
+
+	const ACharacter* Character = Cast<ACharacter>(GetAvatarActor());
+	TracedMesh = Character ? Character->GetMesh() : nullptr;
+
+	if (!TracedMesh)
+	{
+		UE_LOG(LogRPG, Warning, TEXT("URPGAbilityTask_MeleeTrace::Activate: Avatar [%s] has no skeletal mesh to trace."), *GetNameSafe(GetAvatarActor()));
+		EndTask();
+		return;
+	}
+
+	// Dedicated servers don't render the mesh, make sure the sockets follow the montage during the window
+	if (TracedMesh->VisibilityBasedAnimTickOption != EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones)
+	{
+		SavedAnimTickOption = TracedMesh->VisibilityBasedAnimTickOption;
+		TracedMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+		bOverrodeAnimTickOption = true;
+	}
+
+	FRPGMeleeBladePose InitialPose;
+	if (!SampleBladePose(InitialPose))
+	{
+		UE_LOG(LogRPG, Warning, TEXT("URPGAbilityTask_MeleeTrace::Activate: Mesh [%s] is missing socket [%s] or [%s]."),
+			*GetNameSafe(TracedMesh), *Settings.BladeStartSocket.ToString(), *Settings.BladeEndSocket.ToString());
+		EndTask();
+		return;
+	}
+
+	Swing.Begin(Settings, InitialPose);
+	ElapsedTime = 0.0f;
+}
+
+bool URPGAbilityTask_MeleeTrace::SampleBladePose(FRPGMeleeBladePose& OutPose) const
+{
+	const AActor* Avatar = GetAvatarActor();
+	if (!TracedMesh || !Avatar || !TracedMesh->DoesSocketExist(Settings.BladeStartSocket) || !TracedMesh->DoesSocketExist(Settings.BladeEndSocket))
+	{
+		return false;
+	}
+
+	OutPose.ActorTransform = Avatar->GetActorTransform();
+	OutPose.LocalStart = OutPose.ActorTransform.InverseTransformPosition(TracedMesh->GetSocketLocation(Settings.BladeStartSocket));
+	OutPose.LocalEnd = OutPose.ActorTransform.InverseTransformPosition(TracedMesh->GetSocketLocation(Settings.BladeEndSocket));
+	return true;
+}
+
+void URPGAbilityTask_MeleeTrace::TickTask(float DeltaTime)
+{
+	Super::TickTask(DeltaTime);
+
+	if (!Swing.IsActive())
+	{
+		return;
+	}
+
+	// Past the window only the sweeps still in flight are collected
+	const bool bWindowOpen = (ElapsedTime < WindowDuration);
+
+	FRPGMeleeBladePose Pose;
+	if (bWindowOpen && SampleBladePose(Pose))
+	{
+		Swing.AddSample(Pose);
+	}
+
+	FlushAndBroadcast();
+
+	ElapsedTime += DeltaTime;
+	if ((ElapsedTime >= WindowDuration) && !Swing.HasSweepsInFlight())
+	{
+		Swing.End();
+
+		if (ShouldBroadcastAbilityTaskDelegates())
+		{
+			OnFinished.Broadcast();
+		}
+
+		EndTask();
+	}
+}
+
+void URPGAbilityTask_MeleeTrace::FlushAndBroadcast()
+{
+	TArray<const AActor*> IgnoredActors;
+	IgnoredActors.Add(GetAvatarActor());
+
+	TArray<FHitResult> NewHits;
+	Swing.FlushSweeps(GetWorld(), IgnoredActors, NewHits);
+
+	if (ShouldBroadcastAbilityTaskDelegates())
+	{
+		for (const FHitResult& Hit : NewHits)
+		{
+			OnHit.Broadcast(Hit);
+		}
+	}
+}
+
+void URPGAbilityTask_MeleeTrace::OnDestroy(bool bInOwnerFinished)
+{
+	Swing.End();
+
+	if (bOverrodeAnimTickOption && TracedMesh)
+	{
+		TracedMesh->VisibilityBasedAnimTickOption = SavedAnimTickOption;
+	}
+	bOverrodeAnimTickOption = false;
+	TracedMesh = nullptr;
+
+	Super::OnDestroy(bInOwnerFinished);
+}
@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/Abilities/Tasks/RPGAbilityTask_WaitWheelDelay.h"
+#include "System/RPGLogChannels.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGAbilityTask_WaitWheelDelay)
+
+URPGAbilityTask_WaitWheelDelay::URPGAbilityTask_WaitWheelDelay(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+URPGAbilityTask_WaitWheelDelay* URPGAbilityTask_WaitWheelDelay::WaitWheelDelay(UGameplayAbility* OwningAbility, float Time)
+{
+	URPGAbilityTask_WaitWheelDelay* Task = NewAbilityTask<URPGAbilityTask_WaitWheelDelay>(OwningAbility);
+	Task->Time = Time;
+	return Task;
+}
+
+void URPGAbilityTask_WaitWheelDelay::Activate()
+{
+	Super::Activate();
+
+	URPGTimerWheelSubsystem* TimerWheel = URPGTimerWheelSubsystem::Get(this);
+	if (!TimerWheel)
+	{
+		// Same behavior as WaitDelay in worlds that have no wheel
+		UE_LOG(LogRPG, Verbose, TEXT("URPGAbilityTask_WaitWheelDelay::Activate: No timer wheel in the world of [%s], using the timer manager."), *GetNameSafe(Ability));
+
+		FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+		if (Time <= 0.0f)
+		{
+			FallbackTimerHandle = TimerManager.SetTimerForNextTick(this, &ThisClass::OnTimeFinish);
+		}
+		else
+		{
+			TimerManager.SetTimer(FallbackTimerHandle, this, &ThisClass::OnTimeFinish, Time, false);
+		}
+		return;
+	}
+
+	if (Time <= 0.0f)
+	{
+		TimerWheel->SetTimerForNextTick(this, &ThisClass::OnTimeFinish);
+	}
+	else
+	{
+		TimerHandle = TimerWheel->SetTimer(this, &ThisClass::OnTimeFinish, Time);
+	}
+}
+
+void URPGAbilityTask_WaitWheelDelay::OnDestroy(bool bInOwnerFinished)
+{
+	URPGTimerWheelSubsystem::ClearWheelTimer(this, TimerHandle);
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(FallbackTimerHandle);
+	}
+
+	Super::OnDestroy(bInOwnerFinished);
+}
+
+void URPGAbilityTask_WaitWheelDelay::OnTimeFinish()
+{
+	// Deferred calls from SetTimerForNextTick have no handle to cancel
+	if (!IsActive())
+	{
+		return;
+	}
+
+	if (ShouldBroadcastAbilityTaskDelegates())
+	{
+		OnFinish.Broadcast();
+	}
+	EndTask();
+}
+
+FString URPGAbilityTask_WaitWheelDelay::GetDebugString() const
+{
+	float TimeLeft = 0.0f;
+	if (const URPGTimerWheelSubsystem* TimerWheel = URPGTimerWheelSubsystem::Get(this))
+	{
+		TimeLeft = TimerWheel->GetTimerRemaining(TimerHandle);
+	}
+	else if (const UWorld* World = GetWorld())
+	{
+		TimeLeft = FMath::Max(World->GetTimerManager().GetTimerRemaining(FallbackTimerHandle), 0.0f);
+	}
+	return FString::Printf(TEXT("WaitWheelDelay. Time: %.2f. TimeLeft: %.2f"), Time, TimeLeft);
+}
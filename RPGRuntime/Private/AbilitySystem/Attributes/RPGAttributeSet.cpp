@@ -3,6 +3,7 @@
 #include "AbilitySystem/Attributes/RPGAttributeSet.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystem/RPGAbilitySystemComponent.h"
+#include "AbilitySystem/RPGDamageAccumulator.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameplayEffectExtension.h"
 #include "Net/UnrealNetwork.h"
@@ -38,7 +39,15 @@ URPGAttributeSet::URPGAttributeSet()
 		return;
 	}
 
-	const URPGGameData& GameData = URPGAssetManager::Get().GetGameData();
+	// Attribute sets are created with the pawn, the RequestGameData startup job must have loaded the game data by then.
+	// Missing it is a startup ordering bug, the blocking load only keeps the authored defaults correct in that case.
+	const URPGGameData* LoadedGameData = URPGAssetManager::Get().GetGameDataIfLoaded();
+	if (!ensureMsgf(LoadedGameData, TEXT("URPGAttributeSet: RPGGameData is not loaded when creating [%s], the startup jobs must load it first."), *GetPathNameSafe(this)))
+	{
+		LoadedGameData = &URPGAssetManager::Get().GetGameData();
+	}
+
+	const URPGGameData& GameData = *LoadedGameData;
 
 	Health.SetBaseValue(GameData.DefaultHealth);
 	Health.SetCurrentValue(GameData.DefaultHealth);
@@ -127,6 +136,16 @@ bool URPGAttributeSet::PreGameplayEffectExecute(FGameplayEffectModCallbackData&
 		return false;
 	}
 
+	// Damage buffered earlier this frame came before this effect, apply it first so the modification (heal, direct set,
+	// max health change...) lands on the up to date health and in order
+	if (Data.EvaluatedData.Attribute != GetDamageAttribute())
+	{
+		if (URPGDamageAccumulatorSubsystem* DamageAccumulator = URPGDamageAccumulatorSubsystem::Get(this))
+		{
+			DamageAccumulator->FlushTarget(this);
+		}
+	}
+
 	HealthBeforeAttributeChange = GetHealth();
 	MaxHealthBeforeAttributeChange = GetMaxHealth();
 	StaminaBeforeAttributeChange = GetStamina();
@@ -150,8 +169,15 @@ void URPGAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 
 		if (LocalDamageDone > 0.0f)
 		{
-			const float NewHealth = GetHealth() - LocalDamageDone;
-			SetHealth(FMath::Clamp(NewHealth, 0.0f, GetMaxHealth()));
+			// Multi-hit and area damage is merged and applied once per frame per target
+			URPGDamageAccumulatorSubsystem* DamageAccumulator = URPGDamageAccumulatorSubsystem::Get(this);
+			if (!DamageAccumulator || !DamageAccumulator->QueueDamage(this, Data.EffectSpec, LocalDamageDone))
+			{
+				const float NewHealth = GetHealth() - LocalDamageDone;
+				SetHealth(FMath::Clamp(NewHealth, 0.0f, GetMaxHealth()));
+
+				HandleHealthChanged(Instigator, Causer, Data.EffectSpec, LocalDamageDone, HealthBeforeAttributeChange);
+			}
 		}
 	}
 	else if (Data.EvaluatedData.Attribute == GetHealingAttribute())
@@ -161,8 +187,12 @@ void URPGAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 
 		if (LocalHealingDone > 0.0f)
 		{
-			const float NewHealth = GetHealth() + LocalHealingDone;
+			// The damage buffered this frame was flushed in PreGameplayEffectExecute
+			const float OldHealth = GetHealth();
+			const float NewHealth = OldHealth + LocalHealingDone;
 			SetHealth(FMath::Clamp(NewHealth, 0.0f, GetMaxHealth()));
+
+			HandleHealthChanged(Instigator, Causer, Data.EffectSpec, LocalHealingDone, OldHealth);
 		}
 	}
 
@@ -170,30 +200,7 @@ void URPGAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 	{
 		SetHealth(FMath::Clamp(GetHealth(), 0.0f, GetMaxHealth()));
 
-		if (GetHealth() != HealthBeforeAttributeChange)
-		{
-			OnHealthChanged.Broadcast(Instigator, Causer, &Data.EffectSpec, Data.EvaluatedData.Magnitude, HealthBeforeAttributeChange, GetHealth());
-		}
-
-		if ((GetHealth() <= 0.0f) && !bOutOfHealth)
-		{
-			OnOutOfHealth.Broadcast(Instigator, Causer, &Data.EffectSpec, Data.EvaluatedData.Magnitude, HealthBeforeAttributeChange, GetHealth());
-
-			// Send the death event
-			FGameplayEventData Payload;
-			Payload.EventTag = RPGGameplayTags::GameplayEvent_Death;
-			Payload.Instigator = Instigator;
-			Payload.Target = Data.Target.GetAvatarActor();
-			Payload.OptionalObject = Data.EffectSpec.Def;
-			Payload.ContextHandle = Data.EffectSpec.GetEffectContext();
-			Payload.InstigatorTags = *Data.EffectSpec.CapturedSourceTags.GetAggregatedTags();
-			Payload.TargetTags = *Data.EffectSpec.CapturedTargetTags.GetAggregatedTags();
-			Payload.EventMagnitude = Data.EvaluatedData.Magnitude;
-
-			Data.Target.HandleGameplayEvent(Payload.EventTag, &Payload);
-		}
-
-		bOutOfHealth = (GetHealth() <= 0.0f);
+		HandleHealthChanged(Instigator, Causer, Data.EffectSpec, Data.EvaluatedData.Magnitude, HealthBeforeAttributeChange);
 	}
 	else if (Data.EvaluatedData.Attribute == GetMaxHealthAttribute())
 	{
@@ -218,6 +225,61 @@ void URPGAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 	}
 }
 
+void URPGAttributeSet::HandleHealthChanged(AActor* Instigator, AActor* Causer, const FGameplayEffectSpec& EffectSpec, float Magnitude, float OldHealth)
+{
+	if (GetHealth() != OldHealth)
+	{
+		OnHealthChanged.Broadcast(Instigator, Causer, &EffectSpec, Magnitude, OldHealth, GetHealth());
+	}
+
+	if ((GetHealth() <= 0.0f) && !bOutOfHealth)
+	{
+		// The health component sends the death event from its OnOutOfHealth handler
+		OnOutOfHealth.Broadcast(Instigator, Causer, &EffectSpec, Magnitude, OldHealth, GetHealth());
+	}
+
+	bOutOfHealth = (GetHealth() <= 0.0f);
+}
+
+void URPGAttributeSet::ApplyCoalescedDamage(TConstArrayView<FRPGDamageContribution> Contributions)
+{
+	if (Contributions.Num() == 0)
+	{
+		return;
+	}
+
+	const float OldHealth = GetHealth();
+
+	// Replay the contributions in order so the killing blow is attributed to the right instigator
+	const FRPGDamageContribution* KillingContribution = nullptr;
+	const FRPGDamageContribution* LargestContribution = &Contributions[0];
+	float RemainingHealth = OldHealth;
+	float TotalDamage = 0.0f;
+
+	for (const FRPGDamageContribution& Contribution : Contributions)
+	{
+		if (!KillingContribution && (RemainingHealth > 0.0f) && (RemainingHealth - Contribution.Damage <= 0.0f))
+		{
+			KillingContribution = &Contribution;
+		}
+
+		if (Contribution.Damage > LargestContribution->Damage)
+		{
+			LargestContribution = &Contribution;
+		}
+
+		RemainingHealth -= Contribution.Damage;
+		TotalDamage += Contribution.Damage;
+	}
+
+	SetHealth(FMath::Clamp(OldHealth - TotalDamage, 0.0f, GetMaxHealth()));
+
+	OnDamageCoalesced.Broadcast(Contributions, OldHealth, GetHealth());
+
+	const FRPGDamageContribution& Primary = KillingContribution ? *KillingContribution : *LargestContribution;
+	HandleHealthChanged(Primary.Instigator.Get(), Primary.Causer.Get(), Primary.Spec, TotalDamage, OldHealth);
+}
+
 void URPGAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
 {
 	Super::PostAttributeChange(Attribute, OldValue, NewValue);
@@ -0,0 +1,227 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/RPGComboGraph.h"
+#include "Animation/AnimMontage.h"
+#include "GameplayEffect.h"
+#include "System/RPGLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGComboGraph)
+
+//////////////////////////////////////////////////////////////////////
+// FRPGComboInputBuffer
+
+void FRPGComboInputBuffer::Reset()
+{
+	bHasPress = false;
+	bReleased = false;
+}
+
+bool FRPGComboInputBuffer::RecordPress(const FRPGCompiledComboNode& Node, float SectionTime, double WorldTime)
+{
+	if (!Node.IsInInputWindow(SectionTime))
+	{
+		return false;
+	}
+
+	// The latest press inside the window wins
+	PressWorldTime = WorldTime;
+	PressSectionTime = SectionTime;
+	PressFrame = GFrameCounter;
+	bHasPress = true;
+	bReleased = false;
+	return true;
+}
+
+void FRPGComboInputBuffer::RecordRelease(double WorldTime)
+{
+	if (bHasPress && !bReleased)
+	{
+		ReleaseWorldTime = WorldTime;
+		bReleased = true;
+	}
+}
+
+bool FRPGComboInputBuffer::Consume(const FRPGCompiledComboNode& Node, float SectionTime, double WorldTime, float MaxAge, ERPGComboInputType& OutInputType)
+{
+	if (!bHasPress)
+	{
+		return false;
+	}
+
+	// Montage time from the press to the event, world time only if the section was rewound in between
+	double Age = 0.0;
+	if (PressFrame != GFrameCounter)
+	{
+		Age = ((SectionTime >= 0.0f) && (SectionTime >= PressSectionTime)) ? (SectionTime - PressSectionTime) : (WorldTime - PressWorldTime);
+	}
+
+	if ((MaxAge > 0.0f) && (Age > MaxAge))
+	{
+		Reset();
+		return false;
+	}
+
+	const double HeldDuration = bReleased ? (ReleaseWorldTime - PressWorldTime) : (WorldTime - PressWorldTime);
+	OutInputType = (HeldDuration >= Node.HoldThreshold) ? ERPGComboInputType::Hold : ERPGComboInputType::Tap;
+
+	Reset();
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// URPGComboGraph
+
+void URPGComboGraph::PostLoad()
+{
+	Super::PostLoad();
+
+	CompileGraph();
+}
+
+#if WITH_EDITOR
+void URPGComboGraph::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	CompileGraph();
+}
+#endif
+
+void URPGComboGraph::EnsureCompiled() const
+{
+	if (!bCompiled)
+	{
+		const_cast<URPGComboGraph*>(this)->CompileGraph();
+	}
+}
+
+void URPGComboGraph::CompileGraph()
+{
+	CompiledNodes.Reset(Nodes.Num());
+	CompiledBranches.Reset();
+	TransitionTable.Reset();
+	CompiledEntryNode = INDEX_NONE;
+
+	TMap<FName, int32> NodeIndexBySection;
+	NodeIndexBySection.Reserve(Nodes.Num());
+
+	for (const FRPGComboGraphNode& Node : Nodes)
+	{
+		if (Node.SectionName.IsNone() || NodeIndexBySection.Contains(Node.SectionName))
+		{
+			UE_LOG(LogRPG, Warning, TEXT("URPGComboGraph::CompileGraph: Skipping node with empty or duplicate section [%s] in %s."), *Node.SectionName.ToString(), *GetNameSafe(this));
+			continue;
+		}
+
+		FRPGCompiledComboNode& CompiledNode = CompiledNodes.AddDefaulted_GetRef();
+		CompiledNode.SectionName = Node.SectionName;
+		CompiledNode.InputWindowStart = Node.InputWindowStart;
+		CompiledNode.InputWindowEnd = Node.InputWindowEnd;
+		CompiledNode.HoldThreshold = Node.HoldThreshold;
+		CompiledNode.DamageEffect = Node.DamageEffect;
+
+		NodeIndexBySection.Add(Node.SectionName, CompiledNodes.Num() - 1);
+	}
+
+	// Branches leaving a node on the same event are stored contiguously
+	TSet<FName> CompiledSections;
+	for (const FRPGComboGraphNode& Node : Nodes)
+	{
+		const int32* NodeIndex = NodeIndexBySection.Find(Node.SectionName);
+		bool bAlreadyCompiled = false;
+		CompiledSections.Add(Node.SectionName, &bAlreadyCompiled);
+		if (!NodeIndex || bAlreadyCompiled)
+		{
+			continue;
+		}
+
+		TArray<FGameplayTag, TInlineAllocator<4>> NodeTransitionTags;
+		for (const FRPGComboGraphBranch& Branch : Node.Branches)
+		{
+			NodeTransitionTags.AddUnique(Branch.TransitionTag);
+		}
+
+		for (const FGameplayTag& TransitionTag : NodeTransitionTags)
+		{
+			FBranchRange Range;
+			Range.First = CompiledBranches.Num();
+
+			for (const FRPGComboGraphBranch& Branch : Node.Branches)
+			{
+				if (Branch.TransitionTag != TransitionTag)
+				{
+					continue;
+				}
+
+				const int32* TargetNode = NodeIndexBySection.Find(Branch.TargetSection);
+				if (!TargetNode)
+				{
+					UE_LOG(LogRPG, Warning, TEXT("URPGComboGraph::CompileGraph: Branch from [%s] targets unknown section [%s] in %s."), *Node.SectionName.ToString(), *Branch.TargetSection.ToString(), *GetNameSafe(this));
+					continue;
+				}
+
+				FCompiledBranch& CompiledBranch = CompiledBranches.AddDefaulted_GetRef();
+				CompiledBranch.InputType = Branch.InputType;
+				CompiledBranch.TargetNode = *TargetNode;
+			}
+
+			Range.Num = CompiledBranches.Num() - Range.First;
+			if (Range.Num > 0)
+			{
+				TransitionTable.Add({ *NodeIndex, TransitionTag }, Range);
+			}
+		}
+	}
+
+	if (const int32* EntryNode = NodeIndexBySection.Find(EntrySection))
+	{
+		CompiledEntryNode = *EntryNode;
+	}
+	else if (CompiledNodes.Num() > 0)
+	{
+		CompiledEntryNode = 0;
+	}
+
+	bCompiled = true;
+}
+
+int32 URPGComboGraph::GetEntryNode() const
+{
+	EnsureCompiled();
+	return CompiledEntryNode;
+}
+
+const FRPGCompiledComboNode* URPGComboGraph::GetNode(int32 NodeIndex) const
+{
+	EnsureCompiled();
+	return CompiledNodes.IsValidIndex(NodeIndex) ? &CompiledNodes[NodeIndex] : nullptr;
+}
+
+int32 URPGComboGraph::FindTransition(int32 NodeIndex, const FGameplayTag& TransitionTag, ERPGComboInputType InputType) const
+{
+	EnsureCompiled();
+
+	const FBranchRange* Range = TransitionTable.Find({ NodeIndex, TransitionTag });
+	if (!Range)
+	{
+		return INDEX_NONE;
+	}
+
+	// An exact input match wins over an Any branch
+	int32 AnyTarget = INDEX_NONE;
+	for (int32 BranchIndex = Range->First; BranchIndex < Range->First + Range->Num; ++BranchIndex)
+	{
+		const FCompiledBranch& Branch = CompiledBranches[BranchIndex];
+		if (Branch.InputType == InputType)
+		{
+			return Branch.TargetNode;
+		}
+
+		if ((Branch.InputType == ERPGComboInputType::Any) && (AnyTarget == INDEX_NONE))
+		{
+			AnyTarget = Branch.TargetNode;
+		}
+	}
+
+	return AnyTarget;
+}
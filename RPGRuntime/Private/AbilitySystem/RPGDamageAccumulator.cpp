@@ -0,0 +1,173 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/RPGDamageAccumulator.h"
+#include "AbilitySystem/Attributes/RPGAttributeSet.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGDamageAccumulator)
+
+DECLARE_STATS_GROUP(TEXT("RPG Damage"), STATGROUP_RPGDamage, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RPGDamage Flush"), STAT_RPGDamage_Flush, STATGROUP_RPGDamage);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Hits"), STAT_RPGDamage_QueuedHits, STATGROUP_RPGDamage);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Applied Executions"), STAT_RPGDamage_AppliedExecutions, STATGROUP_RPGDamage);
+
+namespace RPGConsoleVariables
+{
+	static bool bCoalesceDamage = true;
+	static FAutoConsoleVariableRef CVarCoalesceDamage(
+		TEXT("rpg.damage.Coalesce"),
+		bCoalesceDamage,
+		TEXT("Merges the damage a target takes during a frame into a single health change on the server."),
+		ECVF_Default);
+
+	static float DamageCoalesceWindow = 0.0f;
+	static FAutoConsoleVariableRef CVarDamageCoalesceWindow(
+		TEXT("rpg.damage.CoalesceWindow"),
+		DamageCoalesceWindow,
+		TEXT("Seconds damage is buffered before being applied. 0 applies it at the end of every frame."),
+		ECVF_Default);
+};
+
+URPGDamageAccumulatorSubsystem* URPGDamageAccumulatorSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<URPGDamageAccumulatorSubsystem>() : nullptr;
+}
+
+bool URPGDamageAccumulatorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void URPGDamageAccumulatorSubsystem::Deinitialize()
+{
+	PendingTargets.Reset();
+	PendingIndexByTarget.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId URPGDamageAccumulatorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGDamageAccumulatorSubsystem, STATGROUP_Tickables);
+}
+
+bool URPGDamageAccumulatorSubsystem::IsTickable() const
+{
+	return PendingTargets.Num() > 0;
+}
+
+bool URPGDamageAccumulatorSubsystem::QueueDamage(URPGAttributeSet* Target, const FGameplayEffectSpec& Spec, float Damage)
+{
+	// Damage applied while flushing (e.g. reactions to a death) goes through immediately
+	if (!RPGConsoleVariables::bCoalesceDamage || bIsFlushing || !Target || (GetWorld()->GetNetMode() == NM_Client))
+	{
+		return false;
+	}
+
+	int32& PendingIndex = PendingIndexByTarget.FindOrAdd(Target, INDEX_NONE);
+	if (PendingIndex == INDEX_NONE)
+	{
+		PendingIndex = PendingTargets.AddDefaulted();
+		PendingTargets[PendingIndex].Target = Target;
+		PendingTargets[PendingIndex].TargetKey = Target;
+	}
+
+	FPendingTarget& Pending = PendingTargets[PendingIndex];
+
+	const FGameplayEffectContextHandle& EffectContext = Spec.GetEffectContext();
+	AActor* Instigator = EffectContext.GetOriginalInstigator();
+	const TObjectKey<UGameplayEffect> EffectDef(Spec.Def.Get());
+
+	FRPGDamageContribution* Contribution = Pending.Contributions.FindByPredicate([Instigator, &EffectDef](const FRPGDamageContribution& Existing)
+	{
+		return (Existing.Instigator.Get() == Instigator) && (Existing.EffectDef == EffectDef);
+	});
+
+	if (!Contribution)
+	{
+		Contribution = &Pending.Contributions.AddDefaulted_GetRef();
+		Contribution->Instigator = Instigator;
+		Contribution->Causer = EffectContext.GetEffectCauser();
+		Contribution->EffectDef = EffectDef;
+		Contribution->Spec = Spec;
+	}
+
+	Contribution->Damage += Damage;
+	++Contribution->NumHits;
+
+	INC_DWORD_STAT(STAT_RPGDamage_QueuedHits);
+	return true;
+}
+
+void URPGDamageAccumulatorSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceLastFlush += DeltaTime;
+	if (TimeSinceLastFlush >= RPGConsoleVariables::DamageCoalesceWindow)
+	{
+		FlushAll();
+	}
+}
+
+void URPGDamageAccumulatorSubsystem::FlushPendingTarget(FPendingTarget& Pending)
+{
+	if (URPGAttributeSet* Target = Pending.Target.Get())
+	{
+		if (Pending.Contributions.Num() > 0)
+		{
+			Target->ApplyCoalescedDamage(Pending.Contributions);
+			INC_DWORD_STAT(STAT_RPGDamage_AppliedExecutions);
+		}
+	}
+
+	Pending.Contributions.Reset();
+}
+
+void URPGDamageAccumulatorSubsystem::FlushTarget(URPGAttributeSet* Target)
+{
+	int32 PendingIndex = INDEX_NONE;
+	if (!PendingIndexByTarget.RemoveAndCopyValue(Target, PendingIndex))
+	{
+		return;
+	}
+
+	TGuardValue<bool> FlushGuard(bIsFlushing, true);
+
+	FPendingTarget Pending = MoveTemp(PendingTargets[PendingIndex]);
+	PendingTargets.RemoveAtSwap(PendingIndex);
+
+	// Re-key the entry swapped into the slot, or drop it with its key if its attribute set is gone
+	while (PendingTargets.IsValidIndex(PendingIndex))
+	{
+		const FPendingTarget& MovedPending = PendingTargets[PendingIndex];
+		if (MovedPending.Target.IsValid())
+		{
+			PendingIndexByTarget.Add(MovedPending.TargetKey, PendingIndex);
+			break;
+		}
+
+		PendingIndexByTarget.Remove(MovedPending.TargetKey);
+		PendingTargets.RemoveAtSwap(PendingIndex);
+	}
+
+	FlushPendingTarget(Pending);
+}
+
+void URPGDamageAccumulatorSubsystem::FlushAll()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGDamage_Flush);
+
+	TimeSinceLastFlush = 0.0f;
+
+	// Swap out so callbacks can't modify the array being iterated
+	TArray<FPendingTarget> TargetsToFlush = MoveTemp(PendingTargets);
+	PendingTargets.Reset();
+	PendingIndexByTarget.Reset();
+
+	TGuardValue<bool> FlushGuard(bIsFlushing, true);
+	for (FPendingTarget& Pending : TargetsToFlush)
+	{
+		FlushPendingTarget(Pending);
+	}
+}
@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/RPGMeleeHitDetection.h"
+#include "CollisionQueryParams.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGMeleeHitDetection)
+
+DECLARE_CYCLE_STAT(TEXT("RPGMelee FlushSweeps"), STAT_RPGMelee_FlushSweeps, STATGROUP_Game);
+
+//////////////////////////////////////////////////////////////////////
+// FRPGMeleeBladePose
+
+FRPGMeleeBladePose FRPGMeleeBladePose::Lerp(const FRPGMeleeBladePose& A, const FRPGMeleeBladePose& B, float Alpha)
+{
+	FRPGMeleeBladePose Result;
+	Result.LocalStart = FMath::Lerp(A.LocalStart, B.LocalStart, Alpha);
+	Result.LocalEnd = FMath::Lerp(A.LocalEnd, B.LocalEnd, Alpha);
+	Result.ActorTransform.Blend(A.ActorTransform, B.ActorTransform, Alpha);
+	return Result;
+}
+
+//////////////////////////////////////////////////////////////////////
+// FRPGMeleeSwing
+
+void FRPGMeleeSwing::Begin(const FRPGMeleeTraceSettings& InSettings, const FRPGMeleeBladePose& InitialPose)
+{
+	Settings = InSettings;
+	LastPose = InitialPose;
+	PendingSegments.Reset();
+	InFlightSweeps.Reset();
+	HitActors.Reset();
+	bActive = true;
+}
+
+void FRPGMeleeSwing::End()
+{
+	PendingSegments.Reset();
+	InFlightSweeps.Reset();
+	bActive = false;
+}
+
+void FRPGMeleeSwing::AddSample(const FRPGMeleeBladePose& Pose)
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	BuildSegments(Settings, LastPose, Pose, PendingSegments);
+	LastPose = Pose;
+}
+
+void FRPGMeleeSwing::BuildSegments(const FRPGMeleeTraceSettings& Settings, const FRPGMeleeBladePose& From, const FRPGMeleeBladePose& To, TArray<FRPGMeleeSweepSegment>& OutSegments)
+{
+	// The tip moves the most, use it to decide how many sub-steps are needed
+	const float TipTravel = FVector::Dist(From.GetWorldEnd(), To.GetWorldEnd());
+	const int32 NumSubsteps = FMath::Clamp(FMath::CeilToInt(TipTravel / FMath::Max(Settings.MaxSubstepDistance, 1.0f)), 1, FMath::Max(Settings.MaxSubsteps, 1));
+	const int32 NumPoints = FMath::Clamp(Settings.PointsAlongBlade, 2, 8);
+
+	OutSegments.Reserve(OutSegments.Num() + (NumSubsteps * NumPoints));
+
+	FRPGMeleeBladePose StepStart = From;
+	for (int32 StepIndex = 1; StepIndex <= NumSubsteps; ++StepIndex)
+	{
+		const FRPGMeleeBladePose StepEnd = (StepIndex == NumSubsteps) ? To : FRPGMeleeBladePose::Lerp(From, To, (float)StepIndex / (float)NumSubsteps);
+
+		const FVector StartA = StepStart.GetWorldStart();
+		const FVector StartB = StepStart.GetWorldEnd();
+		const FVector EndA = StepEnd.GetWorldStart();
+		const FVector EndB = StepEnd.GetWorldEnd();
+
+		for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+		{
+			const float BladeAlpha = (float)PointIndex / (float)(NumPoints - 1);
+
+			FRPGMeleeSweepSegment& Segment = OutSegments.AddDefaulted_GetRef();
+			Segment.Start = FMath::Lerp(StartA, StartB, BladeAlpha);
+			Segment.End = FMath::Lerp(EndA, EndB, BladeAlpha);
+		}
+
+		StepStart = StepEnd;
+	}
+}
+
+bool FRPGMeleeSwing::RegisterHit(const AActor* Actor)
+{
+	for (const TWeakObjectPtr<const AActor>& HitActor : HitActors)
+	{
+		if (HitActor.Get() == Actor)
+		{
+			return false;
+		}
+	}
+
+	HitActors.Add(Actor);
+	return true;
+}
+
+void FRPGMeleeSwing::FlushSweeps(UWorld* World, const TArray<const AActor*>& IgnoredActors, TArray<FHitResult>& OutNewHits)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGMelee_FlushSweeps);
+
+	if (!World)
+	{
+		PendingSegments.Reset();
+		InFlightSweeps.Reset();
+		return;
+	}
+
+	// Results of last frame's batch, a handle that is no longer valid (a frame was skipped) is dropped
+	FTraceDatum SweepData;
+	for (const FTraceHandle& Handle : InFlightSweeps)
+	{
+		if (!World->QueryTraceData(Handle, SweepData))
+		{
+			continue;
+		}
+
+		for (const FHitResult& Hit : SweepData.OutHits)
+		{
+			const AActor* HitActor = Hit.GetActor();
+			if (HitActor && RegisterHit(HitActor))
+			{
+				OutNewHits.Add(Hit);
+			}
+		}
+	}
+	InFlightSweeps.Reset();
+
+	if (PendingSegments.Num() == 0)
+	{
+		return;
+	}
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RPGMeleeSwing), false);
+	QueryParams.AddIgnoredActors(IgnoredActors);
+
+	// No point sweeping against targets already hit this swing
+	for (const TWeakObjectPtr<const AActor>& HitActor : HitActors)
+	{
+		if (const AActor* Actor = HitActor.Get())
+		{
+			QueryParams.AddIgnoredActor(Actor);
+		}
+	}
+
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(Settings.TraceRadius);
+
+	InFlightSweeps.Reserve(PendingSegments.Num());
+	for (const FRPGMeleeSweepSegment& Segment : PendingSegments)
+	{
+		InFlightSweeps.Add(World->AsyncSweepByChannel(EAsyncTraceType::Multi, Segment.Start, Segment.End, FQuat::Identity, Settings.TraceChannel, Sphere, QueryParams));
+	}
+
+	PendingSegments.Reset();
+}
@@ -7,6 +7,12 @@
 #include "KismetAnimationLibrary.h"
 #include "Animation/AnimSequence.h"
 #include "Math/UnrealMathUtility.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("RPG Animation"), STATGROUP_RPGAnimation, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RPGAnim GameThread Update"), STAT_RPGAnim_GameThreadUpdate, STATGROUP_RPGAnimation);
+DECLARE_CYCLE_STAT(TEXT("RPGAnim ThreadSafe Update"), STAT_RPGAnim_ThreadSafeUpdate, STATGROUP_RPGAnimation);
+DECLARE_CYCLE_STAT(TEXT("RPGAnim Equipment Snapshot Refresh"), STAT_RPGAnim_SnapshotRefresh, STATGROUP_RPGAnimation);
 
 // Sửa constructor - tên phải khớp với class
 URPGAnimInstance::URPGAnimInstance(const FObjectInitializer& ObjectInitializer)
@@ -50,34 +56,125 @@ void URPGAnimInstance::NativeInitializeAnimation()
     {
         PreviousLocation = OwningPawn->GetActorLocation();
     }
+
+    BindToEquipmentEvents();
+}
+
+void URPGAnimInstance::NativeBeginPlay()
+{
+    Super::NativeBeginPlay();
+
+    // Component có thể chưa tồn tại lúc InitializeAnimation (ví dụ trong editor preview)
+    BindToEquipmentEvents();
+}
+
+void URPGAnimInstance::NativeUninitializeAnimation()
+{
+    UnbindFromEquipmentEvents();
+
+    Super::NativeUninitializeAnimation();
 }
 
 void URPGAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
+    SCOPE_CYCLE_COUNTER(STAT_RPGAnim_GameThreadUpdate);
+
     Super::NativeUpdateAnimation(DeltaSeconds);
 
-    bIsWeaponEquipped = false;
-    CurrentWeaponTags.Reset();
+    // Chỉ publish snapshot khi có sự kiện trang bị, không còn tìm component mỗi frame
+    if (bEquipmentSnapshotDirty)
+    {
+        bIsWeaponEquipped = PendingEquipmentSnapshot.bIsWeaponEquipped;
+        CurrentWeaponTags = PendingEquipmentSnapshot.CosmeticTags;
+        CurrentWeaponAnimLayer = PendingEquipmentSnapshot.WeaponAnimLayer;
+        bEquipmentSnapshotDirty = false;
+    }
+}
+
+void URPGAnimInstance::BindToEquipmentEvents()
+{
+    if (!OwningPawn || BoundEquipmentManager.IsValid())
+    {
+        return;
+    }
 
-    if (OwningCharacter)
+    URPGEquipmentManagerComponent* EquipManager = OwningPawn->FindComponentByClass<URPGEquipmentManagerComponent>();
+    if (!EquipManager)
+    {
+        return;
+    }
+
+    BoundEquipmentManager = EquipManager;
+    EquipmentChangedHandle = EquipManager->OnEquipmentOfClassChanged(URPGWeaponInstance::StaticClass()).AddUObject(this, &ThisClass::HandleEquipmentOfClassChanged);
+
+    RefreshEquipmentSnapshot();
+}
+
+void URPGAnimInstance::UnbindFromEquipmentEvents()
+{
+    if (URPGWeaponInstance* Weapon = BoundWeapon.Get())
     {
-        if (URPGEquipmentManagerComponent* EquipManager = OwningCharacter->FindComponentByClass<URPGEquipmentManagerComponent>())
+        Weapon->OnCosmeticStateChanged.Remove(WeaponCosmeticChangedHandle);
+    }
+    BoundWeapon.Reset();
+    WeaponCosmeticChangedHandle.Reset();
+
+    if (URPGEquipmentManagerComponent* EquipManager = BoundEquipmentManager.Get())
+    {
+        EquipManager->OnEquipmentOfClassChanged(URPGWeaponInstance::StaticClass()).Remove(EquipmentChangedHandle);
+    }
+    BoundEquipmentManager.Reset();
+    EquipmentChangedHandle.Reset();
+}
+
+void URPGAnimInstance::HandleEquipmentOfClassChanged(URPGEquipmentManagerComponent* EquipmentManager, TSubclassOf<URPGWeaponInstance> InstanceType)
+{
+    RefreshEquipmentSnapshot();
+}
+
+void URPGAnimInstance::HandleWeaponCosmeticStateChanged(URPGWeaponInstance* WeaponInstance)
+{
+    RefreshEquipmentSnapshot();
+}
+
+void URPGAnimInstance::RefreshEquipmentSnapshot()
+{
+    SCOPE_CYCLE_COUNTER(STAT_RPGAnim_SnapshotRefresh);
+
+    URPGEquipmentManagerComponent* EquipManager = BoundEquipmentManager.Get();
+
+    // Tìm vũ khí đầu tiên đang trang bị (Lyra style thường có 1 weapon instance chính)
+    URPGWeaponInstance* CurrentWeapon = EquipManager ? EquipManager->GetFirstInstanceOfType(URPGWeaponInstance::StaticClass()) : nullptr;
+
+    if (BoundWeapon.Get() != CurrentWeapon)
+    {
+        if (URPGWeaponInstance* OldWeapon = BoundWeapon.Get())
+        {
+            OldWeapon->OnCosmeticStateChanged.Remove(WeaponCosmeticChangedHandle);
+        }
+        WeaponCosmeticChangedHandle.Reset();
+
+        BoundWeapon = CurrentWeapon;
+        if (CurrentWeapon)
         {
-            // Tìm vũ khí đầu tiên đang trang bị (Lyra style thường có 1 weapon instance chính)
-            if (URPGWeaponInstance* CurrentWeapon = EquipManager->GetFirstInstanceOfType(URPGWeaponInstance::StaticClass()))
-            {
-                if (CurrentWeapon->IsEquipped())
-                {
-                    bIsWeaponEquipped = true;
-                    CurrentWeaponTags = CurrentWeapon->CosmeticTags;
-                }
-            }
+            WeaponCosmeticChangedHandle = CurrentWeapon->OnCosmeticStateChanged.AddUObject(this, &ThisClass::HandleWeaponCosmeticStateChanged);
         }
     }
+
+    PendingEquipmentSnapshot = FRPGAnimEquipmentSnapshot();
+    if (CurrentWeapon && CurrentWeapon->IsEquipped())
+    {
+        PendingEquipmentSnapshot.bIsWeaponEquipped = true;
+        PendingEquipmentSnapshot.CosmeticTags = CurrentWeapon->CosmeticTags;
+        PendingEquipmentSnapshot.WeaponAnimLayer = CurrentWeapon->EquippedAnimLayer;
+    }
+    bEquipmentSnapshotDirty = true;
 }
 
 void URPGAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
 {
+    SCOPE_CYCLE_COUNTER(STAT_RPGAnim_ThreadSafeUpdate);
+
     Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
 
     if (!OwningPawn)
@@ -90,6 +187,8 @@ void URPGAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
     {
         UpdateVelocityData(DeltaSeconds);
     }
+
+    bIsCrouching = OwningCharacter ? OwningCharacter->bIsCrouched : false;
 }
 
 void URPGAnimInstance::UpdateVelocityData(float DeltaSeconds)
@@ -4,6 +4,7 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GameplayTagsManager.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "System/RPGCosmeticPolicy.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGAnimNotify_SendGameplayEvent)
 
@@ -16,6 +17,16 @@ void URPGAnimNotify_SendGameplayEvent::Notify(USkeletalMeshComponent* MeshComp,
 {
 	Super::Notify(MeshComp, Animation, EventReference);
 
+	if (bIsCosmetic)
+	{
+		RPGCosmeticPolicy::ReportCosmeticPath(MeshComp, TEXT("URPGAnimNotify_SendGameplayEvent::Notify"));
+
+		if (!RPGCosmeticPolicy::ShouldRunCosmetics(MeshComp))
+		{
+			return;
+		}
+	}
+
 	if (MeshComp && MeshComp->GetOwner())
 	{
 		FGameplayEventData Payload;
@@ -11,10 +11,16 @@
 #include "Player/RPGPlayerController.h"
 #include "Player/RPGPlayerState.h"
 #include "Character/RPGCharacterMovementComponent.h"
+#include "Character/RPGCorpseSubsystem.h"
+#include "Character/RPGPawnRecycleSubsystem.h"
 #include "System/RPGGameplayTags.h"
 #include "System/RPGLogChannels.h"
-#include "Net/UnrealNetwork.h"
+#include "System/RPGRewindSubsystem.h"
+#include "System/RPGSignificanceSubsystem.h"
+#include "System/RPGSpatialHashSubsystem.h"
+#include "System/RPGTimerWheelSubsystem.h"
 #include "TimerManager.h"
+#include "Net/UnrealNetwork.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGCharacter)
 
@@ -87,6 +93,26 @@ void ARPGCharacter::PreInitializeComponents()
 void ARPGCharacter::BeginPlay()
 {
 	Super::BeginPlay();
+
+	RegisterWithCharacterSubsystems();
+}
+
+void ARPGCharacter::RegisterWithCharacterSubsystems()
+{
+	if (URPGSignificanceSubsystem* SignificanceSubsystem = URPGSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->RegisterCharacter(this);
+	}
+
+	if (URPGRewindSubsystem* RewindSubsystem = URPGRewindSubsystem::Get(this))
+	{
+		RewindSubsystem->RegisterCharacter(this);
+	}
+
+	if (URPGSpatialHashSubsystem* SpatialHashSubsystem = URPGSpatialHashSubsystem::Get(this))
+	{
+		SpatialHashSubsystem->RegisterCharacter(this);
+	}
 }
 
 void ARPGCharacter::Tick(float DeltaSeconds)
@@ -98,9 +124,29 @@ void ARPGCharacter::Tick(float DeltaSeconds)
 
 void ARPGCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	UnregisterFromCharacterSubsystems();
+
 	Super::EndPlay(EndPlayReason);
 }
 
+void ARPGCharacter::UnregisterFromCharacterSubsystems()
+{
+	if (URPGSignificanceSubsystem* SignificanceSubsystem = URPGSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->UnregisterCharacter(this);
+	}
+
+	if (URPGRewindSubsystem* RewindSubsystem = URPGRewindSubsystem::Get(this))
+	{
+		RewindSubsystem->UnregisterCharacter(this);
+	}
+
+	if (URPGSpatialHashSubsystem* SpatialHashSubsystem = URPGSpatialHashSubsystem::Get(this))
+	{
+		SpatialHashSubsystem->UnregisterCharacter(this);
+	}
+}
+
 void ARPGCharacter::Reset()
 {
 	DisableMovementAndCollision();
@@ -115,6 +161,7 @@ void ARPGCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutL
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	DOREPLIFETIME_CONDITION(ThisClass, ReplicatedAcceleration, COND_SimulatedOnly);
+	DOREPLIFETIME(ThisClass, bIsParkedForRecycling);
 }
 
 void ARPGCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
@@ -138,6 +185,11 @@ void ARPGCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTr
 void ARPGCharacter::NotifyControllerChanged()
 {
 	Super::NotifyControllerChanged();
+
+	if (URPGSpatialHashSubsystem* SpatialHashSubsystem = URPGSpatialHashSubsystem::Get(this))
+	{
+		SpatialHashSubsystem->RefreshCharacterTeam(this);
+	}
 }
 
 ARPGPlayerController* ARPGCharacter::GetRPGPlayerController() const
@@ -206,6 +258,11 @@ void ARPGCharacter::OnRep_PlayerState()
 	Super::OnRep_PlayerState();
 
 	PawnExtComponent->HandlePlayerStateReplicated();
+
+	if (URPGSpatialHashSubsystem* SpatialHashSubsystem = URPGSpatialHashSubsystem::Get(this))
+	{
+		SpatialHashSubsystem->RefreshCharacterTeam(this);
+	}
 }
 
 void ARPGCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -271,11 +328,37 @@ void ARPGCharacter::FellOutOfWorld(const class UDamageType& dmgType)
 void ARPGCharacter::OnDeathStarted(AActor*)
 {
 	DisableMovementAndCollision();
+
+	if (HasAuthority())
+	{
+		if (URPGPawnRecycleSubsystem* RecycleSubsystem = URPGPawnRecycleSubsystem::Get(this))
+		{
+			RecycleSubsystem->NotifyPawnDied(this);
+		}
+	}
 }
 
 void ARPGCharacter::OnDeathFinished(AActor*)
 {
-	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ThisClass::DestroyDueToDeath);
+	// Bound to this life, respawn can end the death itself and unpark the character before the call runs
+	const FTimerDelegate FinishDeathDelegate = FTimerDelegate::CreateUObject(this, &ThisClass::DestroyDueToDeathForLife, LifeSerial);
+
+	if (URPGTimerWheelSubsystem* TimerWheel = URPGTimerWheelSubsystem::Get(this))
+	{
+		TimerWheel->SetTimerForNextTick(FinishDeathDelegate);
+	}
+	else
+	{
+		GetWorldTimerManager().SetTimerForNextTick(FinishDeathDelegate);
+	}
+}
+
+void ARPGCharacter::DestroyDueToDeathForLife(uint32 DeathLifeSerial)
+{
+	if (DeathLifeSerial == LifeSerial)
+	{
+		DestroyDueToDeath();
+	}
 }
 
 
@@ -298,8 +381,31 @@ void ARPGCharacter::DisableMovementAndCollision()
 
 void ARPGCharacter::DestroyDueToDeath()
 {
+	// Respawn may have ended the death sequence before the deferred call
+	if (bDeathSequenceEnded)
+	{
+		return;
+	}
+
+	bDeathSequenceEnded = true;
+
 	K2_OnDeathFinished();
 
+	// Leave a pooled corpse behind so the character itself can go away now
+	if (URPGCorpseSubsystem* CorpseSubsystem = URPGCorpseSubsystem::Get(this))
+	{
+		CorpseSubsystem->CreateCorpse(this);
+	}
+
+	// Players keep their pawn around to get it back on respawn
+	if (URPGPawnRecycleSubsystem* RecycleSubsystem = URPGPawnRecycleSubsystem::Get(this))
+	{
+		if (RecycleSubsystem->TryParkPawn(this))
+		{
+			return;
+		}
+	}
+
 	UninitAndDestroy();
 }
 
@@ -324,6 +430,90 @@ void ARPGCharacter::UninitAndDestroy()
 	SetActorHiddenInGame(true);
 }
 
+void ARPGCharacter::ParkForRecycling()
+{
+	check(HasAuthority());
+
+	if (bIsParkedForRecycling)
+	{
+		return;
+	}
+
+	bIsParkedForRecycling = true;
+
+	// Roll back the init state while still possessed so dependent features can clean up against the player state
+	OnParkedStateChanged(true);
+
+	DetachFromControllerPendingDestroy();
+
+	ForceNetUpdate();
+}
+
+void ARPGCharacter::UnparkForRecycling(const FTransform& SpawnTransform)
+{
+	check(HasAuthority());
+
+	if (!bIsParkedForRecycling)
+	{
+		return;
+	}
+
+	bIsParkedForRecycling = false;
+
+	SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	OnParkedStateChanged(false);
+
+	ForceNetUpdate();
+}
+
+void ARPGCharacter::OnRep_IsParkedForRecycling()
+{
+	OnParkedStateChanged(bIsParkedForRecycling);
+}
+
+void ARPGCharacter::OnParkedStateChanged(bool bParked)
+{
+	if (bParked)
+	{
+		PawnExtComponent->ResetInitState();
+
+		UnregisterFromCharacterSubsystems();
+
+		SetActorHiddenInGame(true);
+		SetActorEnableCollision(false);
+		SetActorTickEnabled(false);
+		return;
+	}
+
+	HealthComponent->ResetDeathState();
+	bDeathSequenceEnded = false;
+	++LifeSerial;
+
+	UCapsuleComponent* CapsuleComp = GetCapsuleComponent();
+	check(CapsuleComp);
+	CapsuleComp->SetCollisionProfileName(NAME_RPGCharacterCollisionProfile_Capsule);
+
+	// Undo whatever the death did to the mesh (ragdoll, frozen pose)
+	USkeletalMeshComponent* MeshComp = GetMesh();
+	check(MeshComp);
+	MeshComp->SetAllBodiesSimulatePhysics(false);
+	MeshComp->SetSimulatePhysics(false);
+	MeshComp->AttachToComponent(CapsuleComp, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	MeshComp->SetRelativeLocationAndRotation(GetBaseTranslationOffset(), GetBaseRotationOffset());
+	MeshComp->SetCollisionProfileName(NAME_RPGCharacterCollisionProfile_Mesh);
+	MeshComp->bPauseAnims = false;
+	MeshComp->SetComponentTickEnabled(true);
+
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	SetActorEnableCollision(true);
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+
+	RegisterWithCharacterSubsystems();
+}
+
 void ARPGCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
 {
 	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
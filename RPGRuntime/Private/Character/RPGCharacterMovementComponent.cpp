@@ -6,6 +6,7 @@
 #include "Components/CapsuleComponent.h"
 #include "Engine/World.h"
 #include "GameFramework/Character.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGCharacterMovementComponent)
 
@@ -73,6 +74,7 @@ const FRPGCharacterGroundInfo& URPGCharacterMovementComponent::GetGroundInfo()
 		const FVector TraceEnd(TraceStart.X, TraceStart.Y, (TraceStart.Z - RPGCharacter::GroundTraceDistance - CapsuleHalfHeight));
 
 		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(RPGCharacterMovementComponent_GetGroundInfo), false, CharacterOwner);
+		QueryParams.bReturnPhysicalMaterial = true;
 		FCollisionResponseParams ResponseParam;
 		InitCollisionParams(QueryParams, ResponseParam);
 
@@ -92,6 +94,21 @@ const FRPGCharacterGroundInfo& URPGCharacterMovementComponent::GetGroundInfo()
 		}
 	}
 
+	// Floor sweeps don't return a physical material, fall back to the one on the hit component's body
+	const FHitResult& GroundHit = CachedGroundInfo.GroundHitResult;
+	const UPhysicalMaterial* GroundPhysMaterial = GroundHit.PhysMaterial.Get();
+	if (!GroundPhysMaterial && GroundHit.bBlockingHit)
+	{
+		if (const UPrimitiveComponent* GroundComponent = GroundHit.GetComponent())
+		{
+			if (const FBodyInstance* BodyInstance = GroundComponent->GetBodyInstance())
+			{
+				GroundPhysMaterial = BodyInstance->GetSimplePhysicalMaterial();
+			}
+		}
+	}
+	CachedGroundInfo.SurfaceType = UPhysicalMaterial::DetermineSurfaceType(GroundPhysMaterial);
+
 	CachedGroundInfo.LastUpdateFrame = GFrameCounter;
 
 	return CachedGroundInfo;
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/RPGCorpseActor.h"
+#include "Animation/AnimSequence.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGCorpseActor)
+
+ARPGCorpseActor::ARPGCorpseActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetReplicates(false);
+
+	CorpseMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("CorpseMesh"));
+	CorpseMesh->SetCollisionProfileName(TEXT("Ragdoll"));
+	CorpseMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	CorpseMesh->SetGenerateOverlapEvents(false);
+	CorpseMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	RootComponent = CorpseMesh;
+
+	SetActorHiddenInGame(true);
+}
+
+void ARPGCorpseActor::InitializeFrom(const USkeletalMeshComponent* SourceMesh, UAnimSequence* BakedDeathPose)
+{
+	if (!SourceMesh || !SourceMesh->GetSkeletalMeshAsset())
+	{
+		return;
+	}
+
+	CorpseMesh->SetSkeletalMesh(SourceMesh->GetSkeletalMeshAsset());
+	CorpseMesh->SetWorldTransform(SourceMesh->GetComponentTransform());
+
+	const TArray<UMaterialInterface*> Materials = SourceMesh->GetMaterials();
+	for (int32 MaterialIndex = 0; MaterialIndex < Materials.Num(); ++MaterialIndex)
+	{
+		CorpseMesh->SetMaterial(MaterialIndex, Materials[MaterialIndex]);
+	}
+
+	if (BakedDeathPose)
+	{
+		// Evaluate the last frame once, then stop ticking the pose
+		CorpseMesh->SetAnimationMode(EAnimationMode::AnimationSingleNode);
+		CorpseMesh->OverrideAnimationData(BakedDeathPose, false, false, BakedDeathPose->GetPlayLength(), 0.0f);
+		CorpseMesh->TickAnimation(0.0f, false);
+		CorpseMesh->RefreshBoneTransforms();
+	}
+	else
+	{
+		// Keep the pose the character died in
+		CorpseMesh->SetAnimationMode(EAnimationMode::AnimationCustomMode);
+		const TArray<FTransform>& SourceTransforms = SourceMesh->GetComponentSpaceTransforms();
+		TArray<FTransform>& CorpseTransforms = CorpseMesh->GetEditableComponentSpaceTransforms();
+		if (CorpseTransforms.Num() == SourceTransforms.Num())
+		{
+			CorpseTransforms = SourceTransforms;
+			CorpseMesh->ApplyEditedComponentSpaceTransforms();
+		}
+	}
+
+	CorpseMesh->bPauseAnims = true;
+	CorpseMesh->SetComponentTickEnabled(false);
+	CorpseMesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	SetActorHiddenInGame(false);
+}
+
+void ARPGCorpseActor::ResetCorpse()
+{
+	SetActorHiddenInGame(true);
+
+	CorpseMesh->SetSimulatePhysics(false);
+	CorpseMesh->SetAllBodiesSimulatePhysics(false);
+	CorpseMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	CorpseMesh->SetComponentTickEnabled(false);
+	CorpseMesh->EmptyOverrideMaterials();
+	CorpseMesh->SetSkeletalMesh(nullptr);
+}
@@ -0,0 +1,339 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/RPGCorpseSubsystem.h"
+#include "Character/RPGCharacter.h"
+#include "Character/RPGCorpseActor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "System/RPGCosmeticPolicy.h"
+#include "System/RPGSignificanceSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGCorpseSubsystem)
+
+DECLARE_STATS_GROUP(TEXT("RPG Corpses"), STATGROUP_RPGCorpses, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RPGCorpses Update"), STAT_RPGCorpses_Update, STATGROUP_RPGCorpses);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulating Ragdolls"), STAT_RPGCorpses_NumRagdolls, STATGROUP_RPGCorpses);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Corpses"), STAT_RPGCorpses_NumCorpses, STATGROUP_RPGCorpses);
+
+namespace RPGConsoleVariables
+{
+	static int32 MaxSimulatingRagdolls = 8;
+	static FAutoConsoleVariableRef CVarMaxSimulatingRagdolls(
+		TEXT("rpg.corpse.MaxSimulatingRagdolls"),
+		MaxSimulatingRagdolls,
+		TEXT("Maximum number of ragdolls simulating at once. The oldest one is frozen to make room."),
+		ECVF_Default);
+
+	static int32 MaxRagdollSignificanceBucket = 1;
+	static FAutoConsoleVariableRef CVarMaxRagdollSignificanceBucket(
+		TEXT("rpg.corpse.MaxRagdollBucket"),
+		MaxRagdollSignificanceBucket,
+		TEXT("Characters in a less significant bucket than this don't ragdoll and use their baked death pose."),
+		ECVF_Default);
+
+	static float RagdollSettleVelocity = 15.0f;
+	static FAutoConsoleVariableRef CVarRagdollSettleVelocity(
+		TEXT("rpg.corpse.SettleVelocity"),
+		RagdollSettleVelocity,
+		TEXT("Speed (cm/s) under which a ragdoll is considered at rest."),
+		ECVF_Default);
+
+	static float RagdollSettleTime = 0.5f;
+	static FAutoConsoleVariableRef CVarRagdollSettleTime(
+		TEXT("rpg.corpse.SettleTime"),
+		RagdollSettleTime,
+		TEXT("Seconds a ragdoll must stay at rest before it is frozen."),
+		ECVF_Default);
+
+	static float MaxRagdollTime = 5.0f;
+	static FAutoConsoleVariableRef CVarMaxRagdollTime(
+		TEXT("rpg.corpse.MaxRagdollTime"),
+		MaxRagdollTime,
+		TEXT("Seconds after which a ragdoll is frozen even if it is still moving."),
+		ECVF_Default);
+
+	static int32 MaxCorpses = 32;
+	static FAutoConsoleVariableRef CVarMaxCorpses(
+		TEXT("rpg.corpse.MaxCorpses"),
+		MaxCorpses,
+		TEXT("Size of the corpse pool. The oldest corpse is recycled when it is exhausted."),
+		ECVF_Default);
+
+	static float CorpseLifetime = 20.0f;
+	static FAutoConsoleVariableRef CVarCorpseLifetime(
+		TEXT("rpg.corpse.Lifetime"),
+		CorpseLifetime,
+		TEXT("Seconds a corpse stays visible before going back to the pool."),
+		ECVF_Default);
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpRPGCorpses(
+	TEXT("RPG.DumpCorpses"),
+	TEXT("Prints the ragdoll budget and corpse pool counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const URPGCorpseSubsystem* Subsystem = URPGCorpseSubsystem::Get(World))
+		{
+			Subsystem->DumpToOutputDevice(Ar);
+		}
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// URPGCorpseSubsystem
+
+URPGCorpseSubsystem* URPGCorpseSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<URPGCorpseSubsystem>() : nullptr;
+}
+
+bool URPGCorpseSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void URPGCorpseSubsystem::Deinitialize()
+{
+	ActiveRagdolls.Reset();
+	ActiveCorpses.Reset();
+	FreeCorpses.Reset();
+	CorpsePool.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId URPGCorpseSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGCorpseSubsystem, STATGROUP_Tickables);
+}
+
+bool URPGCorpseSubsystem::IsTickable() const
+{
+	return (ActiveRagdolls.Num() > 0) || (ActiveCorpses.Num() > 0);
+}
+
+int32 URPGCorpseSubsystem::FindRagdoll(const USkeletalMeshComponent* Mesh) const
+{
+	return ActiveRagdolls.IndexOfByPredicate([Mesh](const FRagdollEntry& Entry) { return Entry.Mesh.Get() == Mesh; });
+}
+
+bool URPGCorpseSubsystem::RequestRagdoll(USkeletalMeshComponent* Mesh, const AActor* Owner)
+{
+	if (!Mesh || !RPGCosmeticPolicy::ShouldRunCosmetics(Owner))
+	{
+		return false;
+	}
+
+	if (FindRagdoll(Mesh) != INDEX_NONE)
+	{
+		return true;
+	}
+
+	// Far away or off screen deaths are not worth a simulation
+	const URPGSignificanceSubsystem* SignificanceSubsystem = URPGSignificanceSubsystem::Get(this);
+	if (SignificanceSubsystem && (SignificanceSubsystem->GetSignificanceBucket(Owner) > RPGConsoleVariables::MaxRagdollSignificanceBucket))
+	{
+		++NumRagdollsDenied;
+		return false;
+	}
+
+	const int32 MaxRagdolls = RPGConsoleVariables::MaxSimulatingRagdolls;
+	if (MaxRagdolls <= 0)
+	{
+		++NumRagdollsDenied;
+		return false;
+	}
+
+	// The oldest ragdoll had the most time to settle, freeze it to make room
+	while (ActiveRagdolls.Num() >= MaxRagdolls)
+	{
+		USkeletalMeshComponent* OldestMesh = ActiveRagdolls[0].Mesh.Get();
+		ActiveRagdolls.RemoveAt(0);
+		FreezeRagdoll(OldestMesh);
+		++NumRagdollsEvicted;
+	}
+
+	StartSimulating(Mesh);
+	++NumRagdollsStarted;
+	return true;
+}
+
+void URPGCorpseSubsystem::StartSimulating(USkeletalMeshComponent* Mesh)
+{
+	Mesh->SetComponentTickEnabled(true);
+	Mesh->SetCollisionProfileName(TEXT("Ragdoll"));
+	Mesh->SetAllBodiesSimulatePhysics(true);
+	Mesh->SetSimulatePhysics(true);
+	Mesh->WakeAllRigidBodies();
+
+	FRagdollEntry& Entry = ActiveRagdolls.AddDefaulted_GetRef();
+	Entry.Mesh = Mesh;
+
+	SET_DWORD_STAT(STAT_RPGCorpses_NumRagdolls, ActiveRagdolls.Num());
+}
+
+void URPGCorpseSubsystem::FreezeRagdoll(USkeletalMeshComponent* Mesh)
+{
+	if (!Mesh)
+	{
+		return;
+	}
+
+	// Sleeping bodies cost nothing in the solver. Only the static world can still touch them so they stay asleep.
+	Mesh->PutAllRigidBodiesToSleep();
+	Mesh->SetCollisionResponseToAllChannels(ECR_Ignore);
+	Mesh->SetCollisionResponseToChannel(ECC_WorldStatic, ECR_Block);
+	Mesh->bPauseAnims = true;
+	Mesh->SetComponentTickEnabled(false);
+}
+
+void URPGCorpseSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGCorpses_Update);
+
+	const float SettleVelocitySquared = FMath::Square(RPGConsoleVariables::RagdollSettleVelocity);
+	for (int32 Index = ActiveRagdolls.Num() - 1; Index >= 0; --Index)
+	{
+		FRagdollEntry& Entry = ActiveRagdolls[Index];
+		USkeletalMeshComponent* Mesh = Entry.Mesh.Get();
+		if (!Mesh)
+		{
+			ActiveRagdolls.RemoveAt(Index);
+			continue;
+		}
+
+		Entry.SimulatedTime += DeltaTime;
+
+		const bool bAtRest = Mesh->GetPhysicsLinearVelocity().SizeSquared() <= SettleVelocitySquared;
+		Entry.SettledTime = bAtRest ? (Entry.SettledTime + DeltaTime) : 0.0f;
+
+		if ((Entry.SettledTime >= RPGConsoleVariables::RagdollSettleTime) || (Entry.SimulatedTime >= RPGConsoleVariables::MaxRagdollTime))
+		{
+			ActiveRagdolls.RemoveAt(Index);
+			FreezeRagdoll(Mesh);
+			++NumRagdollsSettled;
+		}
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	while ((ActiveCorpses.Num() > 0) && (ActiveCorpses[0].ExpireTime <= Now))
+	{
+		ARPGCorpseActor* Corpse = ActiveCorpses[0].Corpse.Get();
+		ActiveCorpses.RemoveAt(0);
+		ReleaseCorpse(Corpse);
+	}
+
+	SET_DWORD_STAT(STAT_RPGCorpses_NumRagdolls, ActiveRagdolls.Num());
+	SET_DWORD_STAT(STAT_RPGCorpses_NumCorpses, ActiveCorpses.Num());
+}
+
+ARPGCorpseActor* URPGCorpseSubsystem::AcquireCorpse()
+{
+	if (FreeCorpses.Num() > 0)
+	{
+		return FreeCorpses.Pop();
+	}
+
+	if (CorpsePool.Num() < FMath::Max(RPGConsoleVariables::MaxCorpses, 1))
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		ARPGCorpseActor* Corpse = GetWorld()->SpawnActor<ARPGCorpseActor>(ARPGCorpseActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (Corpse)
+		{
+			CorpsePool.Add(Corpse);
+		}
+		return Corpse;
+	}
+
+	// Pool exhausted, recycle the oldest corpse
+	while (ActiveCorpses.Num() > 0)
+	{
+		ARPGCorpseActor* Corpse = ActiveCorpses[0].Corpse.Get();
+		ActiveCorpses.RemoveAt(0);
+		if (Corpse)
+		{
+			const int32 RagdollIndex = FindRagdoll(Corpse->GetCorpseMesh());
+			if (RagdollIndex != INDEX_NONE)
+			{
+				ActiveRagdolls.RemoveAt(RagdollIndex);
+			}
+
+			Corpse->ResetCorpse();
+			++NumCorpsesRecycled;
+			return Corpse;
+		}
+	}
+
+	return nullptr;
+}
+
+void URPGCorpseSubsystem::ReleaseCorpse(ARPGCorpseActor* Corpse)
+{
+	if (!Corpse)
+	{
+		return;
+	}
+
+	const int32 RagdollIndex = FindRagdoll(Corpse->GetCorpseMesh());
+	if (RagdollIndex != INDEX_NONE)
+	{
+		ActiveRagdolls.RemoveAt(RagdollIndex);
+	}
+
+	Corpse->ResetCorpse();
+	FreeCorpses.Add(Corpse);
+}
+
+void URPGCorpseSubsystem::CreateCorpse(ARPGCharacter* Character)
+{
+	USkeletalMeshComponent* SourceMesh = Character ? Character->GetMesh() : nullptr;
+	if (!SourceMesh || !SourceMesh->GetSkeletalMeshAsset() || !RPGCosmeticPolicy::ShouldRunCosmetics(Character))
+	{
+		return;
+	}
+
+	ARPGCorpseActor* Corpse = AcquireCorpse();
+	if (!Corpse)
+	{
+		return;
+	}
+
+	// A ragdoll that is still falling keeps simulating on the corpse, otherwise the pose is frozen (or baked)
+	const int32 SourceRagdollIndex = FindRagdoll(SourceMesh);
+	const bool bWasSimulating = (SourceRagdollIndex != INDEX_NONE);
+	const bool bWasRagdoll = bWasSimulating || SourceMesh->IsSimulatingPhysics();
+	if (bWasSimulating)
+	{
+		ActiveRagdolls.RemoveAt(SourceRagdollIndex);
+	}
+
+	Corpse->InitializeFrom(SourceMesh, bWasRagdoll ? nullptr : Character->GetBakedDeathPose());
+
+	if (bWasSimulating)
+	{
+		StartSimulating(Corpse->GetCorpseMesh());
+	}
+
+	FCorpseEntry& Entry = ActiveCorpses.AddDefaulted_GetRef();
+	Entry.Corpse = Corpse;
+	Entry.ExpireTime = GetWorld()->GetTimeSeconds() + RPGConsoleVariables::CorpseLifetime;
+
+	// The character is hidden and destroyed right after, stop its simulation now
+	if (bWasRagdoll)
+	{
+		SourceMesh->SetAllBodiesSimulatePhysics(false);
+		SourceMesh->SetSimulatePhysics(false);
+	}
+}
+
+void URPGCorpseSubsystem::DumpToOutputDevice(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("RPGCorpseSubsystem: %d simulating ragdolls (max %d), %d active corpses, pool %d (%d free)"),
+		ActiveRagdolls.Num(), RPGConsoleVariables::MaxSimulatingRagdolls, ActiveCorpses.Num(), CorpsePool.Num(), FreeCorpses.Num());
+	Ar.Logf(TEXT("  Ragdolls: %d started, %d denied, %d evicted, %d settled. Corpses recycled early: %d"),
+		NumRagdollsStarted, NumRagdollsDenied, NumRagdollsEvicted, NumRagdollsSettled, NumCorpsesRecycled);
+}
@@ -0,0 +1,491 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/RPGCrowdSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Character/RPGEnemy_Character.h"
+#include "Character/RPGHealthComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GenericTeamAgentInterface.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "System/RPGLogChannels.h"
+#include "System/RPGSpatialHashSubsystem.h"
+#include "Teams/RPGTeamAgentInterface.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGCrowdSubsystem)
+
+DECLARE_STATS_GROUP(TEXT("RPG Crowd"), STATGROUP_RPGCrowd, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RPGCrowd Simulate"), STAT_RPGCrowd_Simulate, STATGROUP_RPGCrowd);
+DECLARE_CYCLE_STAT(TEXT("RPGCrowd Transitions"), STAT_RPGCrowd_Transitions, STATGROUP_RPGCrowd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Agents"), STAT_RPGCrowd_NumAgents, STATGROUP_RPGCrowd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Promoted Agents"), STAT_RPGCrowd_NumPromoted, STATGROUP_RPGCrowd);
+
+namespace RPGConsoleVariables
+{
+	static bool bCrowdEnabled = true;
+	static FAutoConsoleVariableRef CVarCrowdEnabled(
+		TEXT("rpg.crowd.Enabled"),
+		bCrowdEnabled,
+		TEXT("Enables the simulation of lightweight crowd agents."),
+		ECVF_Default);
+
+	static int32 CrowdMaxPromotionsPerFrame = 8;
+	static FAutoConsoleVariableRef CVarCrowdMaxPromotionsPerFrame(
+		TEXT("rpg.crowd.MaxPromotionsPerFrame"),
+		CrowdMaxPromotionsPerFrame,
+		TEXT("Maximum number of agents promoted to actors (and demoted back) per frame."),
+		ECVF_Default);
+
+	static int32 CrowdBatchSize = 256;
+	static FAutoConsoleVariableRef CVarCrowdBatchSize(
+		TEXT("rpg.crowd.BatchSize"),
+		CrowdBatchSize,
+		TEXT("Number of agents simulated per parallel task."),
+		ECVF_Default);
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpRPGCrowd(
+	TEXT("RPG.DumpCrowd"),
+	TEXT("Prints the crowd simulation counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const URPGCrowdSubsystem* Subsystem = URPGCrowdSubsystem::Get(World))
+		{
+			Subsystem->DumpToOutputDevice(Ar);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarRPGCrowdSoak(
+	TEXT("RPG.CrowdSoak"),
+	TEXT("Spawns simulated enemies and logs the server frame time after the duration. Usage: RPG.CrowdSoak [NumAgents=2000] [Seconds=60] [EnemyClassPath]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		URPGCrowdSubsystem* Subsystem = URPGCrowdSubsystem::Get(World);
+		if (!Subsystem)
+		{
+			return;
+		}
+
+		const int32 NumAgents = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 2000);
+		const float Duration = FMath::Max(1.0f, Args.IsValidIndex(1) ? FCString::Atof(*Args[1]) : 60.0f);
+
+		TSubclassOf<ARPGEnemy_Character> EnemyClass = Subsystem->GetDefaultEnemyClass();
+		if (Args.IsValidIndex(2))
+		{
+			EnemyClass = LoadClass<ARPGEnemy_Character>(nullptr, *Args[2]);
+		}
+
+		Subsystem->StartSoak(NumAgents, Duration, EnemyClass, Ar);
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// URPGCrowdSubsystem
+
+URPGCrowdSubsystem* URPGCrowdSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<URPGCrowdSubsystem>() : nullptr;
+}
+
+bool URPGCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void URPGCrowdSubsystem::Deinitialize()
+{
+	Agents.Reset();
+	PendingTransitions.Reset();
+	FreeAgentIds.Reset();
+	PromotedActors.Reset();
+	EnemyClasses.Reset();
+	NumActiveAgents = 0;
+
+	Super::Deinitialize();
+}
+
+TStatId URPGCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGCrowdSubsystem, STATGROUP_Tickables);
+}
+
+bool URPGCrowdSubsystem::IsTickable() const
+{
+	return RPGConsoleVariables::bCrowdEnabled && ((NumActiveAgents > 0) || Soak.bActive) && (GetWorld()->GetNetMode() != NM_Client);
+}
+
+TSubclassOf<ARPGEnemy_Character> URPGCrowdSubsystem::GetDefaultEnemyClass() const
+{
+	return DefaultEnemyClass.IsNull() ? TSubclassOf<ARPGEnemy_Character>(ARPGEnemy_Character::StaticClass()) : DefaultEnemyClass.LoadSynchronous();
+}
+
+int32 URPGCrowdSubsystem::SpawnAgent(TSubclassOf<ARPGEnemy_Character> EnemyClass, const FVector& Location, int32 TeamId, float Health, float MaxHealth)
+{
+	if (!EnemyClass || (GetWorld()->GetNetMode() == NM_Client))
+	{
+		return INDEX_NONE;
+	}
+
+	int32 ClassIndex = EnemyClasses.AddUnique(EnemyClass);
+
+	const int32 AgentId = (FreeAgentIds.Num() > 0) ? FreeAgentIds.Pop() : Agents.AddDefaulted();
+	PendingTransitions.SetNumZeroed(Agents.Num());
+
+	FRPGCrowdAgent& Agent = Agents[AgentId];
+	Agent = FRPGCrowdAgent();
+	Agent.Location = FVector3f(Location);
+	Agent.HomeLocation = Agent.Location;
+	Agent.MoveTarget = Agent.Location;
+	Agent.Health = Health;
+	Agent.MaxHealth = MaxHealth;
+	Agent.RandomSeed = (int32)GetTypeHash(AgentId) ^ (int32)GFrameCounter;
+	Agent.ClassIndex = (uint16)ClassIndex;
+	Agent.TeamId = (TeamId == INDEX_NONE) ? 0xFF : (uint8)TeamId;
+	Agent.bActive = true;
+
+	++NumActiveAgents;
+	SET_DWORD_STAT(STAT_RPGCrowd_NumAgents, NumActiveAgents);
+
+	return AgentId;
+}
+
+void URPGCrowdSubsystem::RemoveAgent(int32 AgentId)
+{
+	if (!Agents.IsValidIndex(AgentId) || !Agents[AgentId].bActive)
+	{
+		return;
+	}
+
+	TWeakObjectPtr<ARPGEnemy_Character> PromotedActor;
+	if (PromotedActors.RemoveAndCopyValue(AgentId, PromotedActor))
+	{
+		if (ARPGEnemy_Character* Enemy = PromotedActor.Get())
+		{
+			Enemy->SetCrowdAgentId(INDEX_NONE);
+			Enemy->Destroy();
+		}
+	}
+
+	Agents[AgentId] = FRPGCrowdAgent();
+	PendingTransitions[AgentId] = ETransition::None;
+	FreeAgentIds.Add(AgentId);
+	--NumActiveAgents;
+
+	SET_DWORD_STAT(STAT_RPGCrowd_NumAgents, NumActiveAgents);
+	SET_DWORD_STAT(STAT_RPGCrowd_NumPromoted, PromotedActors.Num());
+}
+
+void URPGCrowdSubsystem::NotifyPromotedEnemyDied(int32 AgentId)
+{
+	// The actor finishes its own death sequence, only forget about the agent
+	PromotedActors.Remove(AgentId);
+	RemoveAgent(AgentId);
+}
+
+void URPGCrowdSubsystem::Tick(float DeltaTime)
+{
+	const double SimulationStart = FPlatformTime::Seconds();
+
+	GatherPlayerLocations();
+	SimulateAgents(DeltaTime);
+	ProcessTransitions();
+
+	LastSimulationMs = (FPlatformTime::Seconds() - SimulationStart) * 1000.0;
+
+	UpdateSoak(DeltaTime);
+}
+
+void URPGCrowdSubsystem::GatherPlayerLocations()
+{
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(FVector3f(Pawn->GetActorLocation()));
+		}
+	}
+}
+
+void URPGCrowdSubsystem::SimulateAgents(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGCrowd_Simulate);
+
+	const int32 BatchSize = FMath::Max(RPGConsoleVariables::CrowdBatchSize, 1);
+	const int32 NumBatches = FMath::DivideAndRoundUp(Agents.Num(), BatchSize);
+
+	const float PromotionRadiusSquared = FMath::Square(PromotionRadius);
+	const float DemotionRadiusSquared = FMath::Square(FMath::Max(DemotionRadius, PromotionRadius));
+	const float StepDistance = MoveSpeed * DeltaTime;
+	const float LocalWanderRadius = WanderRadius;
+	const TArray<FVector3f>& LocalPlayerLocations = PlayerLocations;
+
+	// Every task only writes the agents (and transitions) of its own batch
+	ParallelFor(NumBatches, [&](int32 BatchIndex)
+	{
+		const int32 FirstAgent = BatchIndex * BatchSize;
+		const int32 LastAgent = FMath::Min(FirstAgent + BatchSize, Agents.Num());
+
+		for (int32 AgentId = FirstAgent; AgentId < LastAgent; ++AgentId)
+		{
+			FRPGCrowdAgent& Agent = Agents[AgentId];
+			PendingTransitions[AgentId] = ETransition::None;
+
+			if (!Agent.bActive)
+			{
+				continue;
+			}
+
+			float ClosestPlayerDistanceSquared = UE_BIG_NUMBER;
+			for (const FVector3f& PlayerLocation : LocalPlayerLocations)
+			{
+				ClosestPlayerDistanceSquared = FMath::Min(ClosestPlayerDistanceSquared, FVector3f::DistSquared2D(PlayerLocation, Agent.Location));
+			}
+
+			if (Agent.bPromoted)
+			{
+				// The actor owns the state while promoted
+				if (ClosestPlayerDistanceSquared > DemotionRadiusSquared)
+				{
+					PendingTransitions[AgentId] = ETransition::Demote;
+				}
+				continue;
+			}
+
+			if (ClosestPlayerDistanceSquared < PromotionRadiusSquared)
+			{
+				PendingTransitions[AgentId] = ETransition::Promote;
+			}
+
+			Agent.StateTimeRemaining -= DeltaTime;
+
+			switch (Agent.Behavior)
+			{
+			case ERPGCrowdBehavior::Idle:
+				if (Agent.StateTimeRemaining <= 0.0f)
+				{
+					FRandomStream Random(Agent.RandomSeed);
+					const FVector2f Offset = FVector2f(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f)) * LocalWanderRadius;
+					Agent.MoveTarget = Agent.HomeLocation + FVector3f(Offset.X, Offset.Y, 0.0f);
+					Agent.StateTimeRemaining = Random.FRandRange(5.0f, 15.0f);
+					Agent.RandomSeed = Random.GetCurrentSeed();
+					Agent.Behavior = ERPGCrowdBehavior::Wander;
+				}
+				break;
+
+			case ERPGCrowdBehavior::Wander:
+				{
+					const FVector3f ToTarget = Agent.MoveTarget - Agent.Location;
+					const float Distance = ToTarget.Size2D();
+					if ((Distance <= StepDistance) || (Agent.StateTimeRemaining <= 0.0f))
+					{
+						Agent.Location = FVector3f(Agent.MoveTarget.X, Agent.MoveTarget.Y, Agent.Location.Z);
+						FRandomStream Random(Agent.RandomSeed);
+						Agent.StateTimeRemaining = Random.FRandRange(2.0f, 8.0f);
+						Agent.RandomSeed = Random.GetCurrentSeed();
+						Agent.Behavior = ERPGCrowdBehavior::Idle;
+					}
+					else
+					{
+						Agent.Location += FVector3f(ToTarget.X, ToTarget.Y, 0.0f) * (StepDistance / Distance);
+					}
+				}
+				break;
+			}
+		}
+	}, (NumBatches <= 1) ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void URPGCrowdSubsystem::ProcessTransitions()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGCrowd_Transitions);
+
+	// Promoted actors destroyed by something else than the crowd lose their agent
+	TArray<int32, TInlineAllocator<8>> LostAgentIds;
+	for (const TPair<int32, TWeakObjectPtr<ARPGEnemy_Character>>& Pair : PromotedActors)
+	{
+		if (!Pair.Value.IsValid())
+		{
+			LostAgentIds.Add(Pair.Key);
+		}
+	}
+
+	for (const int32 AgentId : LostAgentIds)
+	{
+		RemoveAgent(AgentId);
+	}
+
+	int32 Budget = FMath::Max(RPGConsoleVariables::CrowdMaxPromotionsPerFrame, 0);
+	for (int32 AgentId = 0; (AgentId < PendingTransitions.Num()) && (Budget > 0); ++AgentId)
+	{
+		switch (PendingTransitions[AgentId])
+		{
+		case ETransition::Promote:
+			if (PromoteAgent(AgentId))
+			{
+				--Budget;
+			}
+			break;
+
+		case ETransition::Demote:
+			DemoteAgent(AgentId);
+			--Budget;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_RPGCrowd_NumPromoted, PromotedActors.Num());
+}
+
+bool URPGCrowdSubsystem::PromoteAgent(int32 AgentId)
+{
+	FRPGCrowdAgent& Agent = Agents[AgentId];
+	const TSubclassOf<ARPGEnemy_Character> EnemyClass = EnemyClasses.IsValidIndex(Agent.ClassIndex) ? EnemyClasses[Agent.ClassIndex] : nullptr;
+	if (!EnemyClass)
+	{
+		return false;
+	}
+
+	const FTransform SpawnTransform(FRotator::ZeroRotator, FVector(Agent.Location));
+	ARPGEnemy_Character* Enemy = GetWorld()->SpawnActorDeferred<ARPGEnemy_Character>(EnemyClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!Enemy)
+	{
+		return false;
+	}
+
+	Enemy->InitializeFromCrowd(AgentId, Agent.Health);
+	Enemy->FinishSpawning(SpawnTransform);
+
+	if (Enemy->GetController() == nullptr)
+	{
+		Enemy->SpawnDefaultController();
+	}
+
+	if (IGenericTeamAgentInterface* TeamAgent = Cast<IGenericTeamAgentInterface>(Enemy->GetController()))
+	{
+		TeamAgent->SetGenericTeamId(IntegerToGenericTeamId((Agent.TeamId == 0xFF) ? INDEX_NONE : Agent.TeamId));
+	}
+
+	Agent.bPromoted = true;
+	PromotedActors.Add(AgentId, Enemy);
+	++NumPromotions;
+
+	return true;
+}
+
+void URPGCrowdSubsystem::DemoteAgent(int32 AgentId)
+{
+	FRPGCrowdAgent& Agent = Agents[AgentId];
+
+	TWeakObjectPtr<ARPGEnemy_Character> PromotedActor;
+	PromotedActors.RemoveAndCopyValue(AgentId, PromotedActor);
+
+	if (ARPGEnemy_Character* Enemy = PromotedActor.Get())
+	{
+		// Carry the actor state back into the packed agent
+		Agent.Location = FVector3f(Enemy->GetActorLocation());
+
+		if (const URPGHealthComponent* HealthComponent = URPGHealthComponent::FindHealthComponent(Enemy))
+		{
+			if (HealthComponent->GetMaxHealth() > 0.0f)
+			{
+				Agent.Health = HealthComponent->GetHealth();
+				Agent.MaxHealth = HealthComponent->GetMaxHealth();
+			}
+		}
+
+		const int32 TeamId = URPGSpatialHashSubsystem::ResolveTeamId(Enemy);
+		Agent.TeamId = (TeamId == INDEX_NONE) ? 0xFF : (uint8)TeamId;
+
+		Enemy->SetCrowdAgentId(INDEX_NONE);
+		if (AController* Controller = Enemy->GetController())
+		{
+			Controller->Destroy();
+		}
+		Enemy->Destroy();
+	}
+
+	Agent.bPromoted = false;
+	Agent.Behavior = ERPGCrowdBehavior::Idle;
+	Agent.StateTimeRemaining = 0.0f;
+	++NumDemotions;
+}
+
+void URPGCrowdSubsystem::StartSoak(int32 NumAgents, float Duration, TSubclassOf<ARPGEnemy_Character> EnemyClass, FOutputDevice& Ar)
+{
+	if (!EnemyClass)
+	{
+		Ar.Logf(TEXT("RPG.CrowdSoak: No enemy class."));
+		return;
+	}
+
+	GatherPlayerLocations();
+	const FVector Center = (PlayerLocations.Num() > 0) ? FVector(PlayerLocations[0]) : FVector::ZeroVector;
+
+	// Spread the agents on a ring so only the closest ones get promoted
+	FRandomStream Random(1234);
+	const float InnerRadius = PromotionRadius * 0.5f;
+	const float OuterRadius = PromotionRadius * 10.0f;
+	for (int32 Index = 0; Index < NumAgents; ++Index)
+	{
+		const float Angle = Random.FRandRange(0.0f, UE_TWO_PI);
+		const float Distance = Random.FRandRange(InnerRadius, OuterRadius);
+		const FVector Location = Center + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0);
+		SpawnAgent(EnemyClass, Location, INDEX_NONE, 100.0f, 100.0f);
+	}
+
+	Soak = FSoakState();
+	Soak.bActive = true;
+	Soak.TimeRemaining = Duration;
+	Soak.FrameTimesMs.Reserve(FMath::CeilToInt(Duration * 120.0f));
+
+	Ar.Logf(TEXT("RPG.CrowdSoak: Started with %d agents (%d total) of [%s] for %.0f s."), NumAgents, NumActiveAgents, *GetNameSafe(EnemyClass), Duration);
+}
+
+void URPGCrowdSubsystem::UpdateSoak(float DeltaTime)
+{
+	if (!Soak.bActive)
+	{
+		return;
+	}
+
+	// Busy time of the last frame, excluding the idle time of a tick rate limited server
+	const double FrameMs = FMath::Max(FApp::GetDeltaTime() - FApp::GetIdleTime(), 0.0) * 1000.0;
+	Soak.FrameTimesMs.Add((float)FrameMs);
+	Soak.TotalFrameMs += FrameMs;
+	Soak.TotalSimulationMs += LastSimulationMs;
+	++Soak.NumFrames;
+
+	Soak.TimeRemaining -= DeltaTime;
+	if (Soak.TimeRemaining > 0.0f)
+	{
+		return;
+	}
+
+	Soak.FrameTimesMs.Sort();
+	const int32 NumSamples = Soak.FrameTimesMs.Num();
+	const float P95 = (NumSamples > 0) ? Soak.FrameTimesMs[FMath::Min(NumSamples - 1, (NumSamples * 95) / 100)] : 0.0f;
+	const float MaxFrame = (NumSamples > 0) ? Soak.FrameTimesMs.Last() : 0.0f;
+
+	UE_LOG(LogRPG, Display, TEXT("RPG.CrowdSoak: %d frames, %d agents (%d promoted), %d promotions, %d demotions"),
+		Soak.NumFrames, NumActiveAgents, PromotedActors.Num(), NumPromotions, NumDemotions);
+	UE_LOG(LogRPG, Display, TEXT("RPG.CrowdSoak: Frame %.2f ms avg, %.2f ms p95, %.2f ms max. Crowd update %.3f ms avg."),
+		Soak.TotalFrameMs / FMath::Max(Soak.NumFrames, 1), P95, MaxFrame, Soak.TotalSimulationMs / FMath::Max(Soak.NumFrames, 1));
+
+	Soak = FSoakState();
+}
+
+void URPGCrowdSubsystem::DumpToOutputDevice(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("RPGCrowdSubsystem: %d agents (%d slots, %d promoted), %.1f KB packed, last update %.3f ms"),
+		NumActiveAgents, Agents.Num(), PromotedActors.Num(), Agents.GetAllocatedSize() / 1024.0, LastSimulationMs);
+	Ar.Logf(TEXT("  Promotions: %d, demotions: %d, promotion radius %.0f, demotion radius %.0f"),
+		NumPromotions, NumDemotions, PromotionRadius, DemotionRadius);
+}
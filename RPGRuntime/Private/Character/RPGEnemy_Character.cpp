@@ -1,6 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Character/RPGEnemy_Character.h"
+#include "AbilitySystem/Attributes/RPGAttributeSet.h"
+#include "AbilitySystem/RPGAbilitySystemComponent.h"
+#include "Character/RPGCrowdSubsystem.h"
 #include "Perception/AIPerceptionSystem.h"
 #include "Perception/AISense_Sight.h"
 
@@ -15,9 +18,39 @@ void ARPGEnemy_Character::OnDeathStarted(AActor* OwningActor)
 {
 	Super::OnDeathStarted(OwningActor);
 
+	if (CrowdAgentId != INDEX_NONE)
+	{
+		if (URPGCrowdSubsystem* CrowdSubsystem = URPGCrowdSubsystem::Get(this))
+		{
+			CrowdSubsystem->NotifyPromotedEnemyDied(CrowdAgentId);
+		}
+		CrowdAgentId = INDEX_NONE;
+	}
+
 	// Unregister from AI senses (specifically Sight)
 	if (UAIPerceptionSystem* PerceptionSystem = UAIPerceptionSystem::GetCurrent(GetWorld()))
 	{
 		PerceptionSystem->UnregisterSource(*this, UAISense_Sight::StaticClass());
 	}
 }
+
+void ARPGEnemy_Character::InitializeFromCrowd(int32 AgentId, float Health)
+{
+	CrowdAgentId = AgentId;
+	PendingCrowdHealth = Health;
+	bHasPendingCrowdHealth = true;
+}
+
+void ARPGEnemy_Character::OnAbilitySystemInitialized()
+{
+	Super::OnAbilitySystemInitialized();
+
+	if (bHasPendingCrowdHealth && HasAuthority())
+	{
+		if (URPGAbilitySystemComponent* RPGASC = GetRPGAbilitySystemComponent())
+		{
+			RPGASC->SetNumericAttributeBase(URPGAttributeSet::GetHealthAttribute(), PendingCrowdHealth);
+		}
+		bHasPendingCrowdHealth = false;
+	}
+}
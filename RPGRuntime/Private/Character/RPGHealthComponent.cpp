@@ -204,6 +204,13 @@ void URPGHealthComponent::OnRep_DeathState(ERPGDeathState OldDeathState)
 
 	DeathState = OldDeathState;
 
+	// Going back to NotDead only happens when the server recycles the pawn
+	if ((NewDeathState == ERPGDeathState::NotDead) && (OldDeathState != ERPGDeathState::NotDead))
+	{
+		ResetDeathState();
+		return;
+	}
+
 	if (OldDeathState > NewDeathState)
 	{
 		return;
@@ -274,6 +281,23 @@ void URPGHealthComponent::FinishDeath()
 	Owner->ForceNetUpdate();
 }
 
+void URPGHealthComponent::ResetDeathState()
+{
+	if (DeathState == ERPGDeathState::NotDead)
+	{
+		return;
+	}
+
+	DeathState = ERPGDeathState::NotDead;
+
+	ClearGameplayTags();
+
+	if (AActor* Owner = GetOwner())
+	{
+		Owner->ForceNetUpdate();
+	}
+}
+
 void URPGHealthComponent::DamageSelfDestruct(bool bFellOutOfWorld)
 {
 	if ((DeathState == ERPGDeathState::NotDead) && AbilitySystemComponent)
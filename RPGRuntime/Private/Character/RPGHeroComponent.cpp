@@ -4,6 +4,7 @@
 #include "Components/GameFrameworkComponentDelegates.h"
 #include "Logging/MessageLog.h"
 #include "System/RPGLogChannels.h"
+#include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Player/RPGPlayerController.h"
 #include "Player/RPGPlayerState.h"
@@ -189,7 +190,44 @@ void URPGHeroComponent::OnActorInitStateChanged(const FActorInitStateChangedPara
 		{
 			CheckDefaultInitialization();
 		}
+		else if (Params.FeatureState == RPGGameplayTags::InitState_Spawned)
+		{
+			// The pawn extension rolled back, the pawn is being recycled
+			ResetInitState();
+		}
+	}
+}
+
+void URPGHeroComponent::ResetInitState()
+{
+	APawn* Pawn = GetPawn<APawn>();
+	UGameFrameworkComponentManager* Manager = UGameFrameworkComponentManager::GetForActor(Pawn);
+	if (!Manager || !Manager->HasFeatureReachedInitState(Pawn, NAME_ActorFeatureName, RPGGameplayTags::InitState_DataAvailable))
+	{
+		return;
+	}
+
+	// Take back the pawn data ability sets, they are granted again by the next initialization
+	if (ARPGPlayerState* RPGPS = GetPlayerState<ARPGPlayerState>())
+	{
+		if (URPGAbilitySystemComponent* RPGASC = RPGPS->GetRPGAbilitySystemComponent())
+		{
+			for (FRPGAbilitySet_GrantedHandles& Handles : GlobalAbilitySetHandles)
+			{
+				Handles.TakeFromAbilitySystem(RPGASC);
+			}
+		}
 	}
+	GlobalAbilitySetHandles.Empty();
+
+	// The input component may survive the unpossess, don't bind everything twice
+	if (UEnhancedInputComponent* EnhancedIC = Cast<UEnhancedInputComponent>(Pawn->InputComponent))
+	{
+		EnhancedIC->ClearBindingsForObject(this);
+	}
+	bReadyToBindInputs = false;
+
+	Manager->ChangeFeatureInitState(Pawn, NAME_ActorFeatureName, this, RPGGameplayTags::InitState_Spawned);
 }
 
 void URPGHeroComponent::CheckDefaultInitialization()
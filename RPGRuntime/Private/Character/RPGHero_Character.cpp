@@ -2,6 +2,7 @@
 
 #include "Character/RPGHero_Character.h"
 #include "Character/RPGHeroComponent.h"
+#include "Character/RPGCorpseSubsystem.h"
 #include "Animation/AnimMontage.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Equipment/RPGEquipmentManagerComponent.h"
@@ -12,11 +13,19 @@
 #include "Inventory/RPGInventoryManagerComponent.h"
 #include "Inventory/RPGQuickbarComponent.h"
 #include "Character/RPGPawnExtensionComponent.h"
+#include "Components/GameFrameworkComponentManager.h"
+#include "Feedback/ContextEffects/RPGContextEffectComponent.h"
+#include "System/RPGCosmeticPolicy.h"
 #include "System/RPGGameplayTags.h"
+#include "System/RPGLogChannels.h"
+#include "System/RPGSignificanceSubsystem.h"
 #include "GameFramework/Controller.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGHero_Character)
 
+DECLARE_STATS_GROUP(TEXT("RPG Hero"), STATGROUP_RPGHero, STATCAT_Advanced);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Possession To Equipped (ms)"), STAT_RPGHero_PossessionToEquipped, STATGROUP_RPGHero);
+
 ARPGHero_Character::ARPGHero_Character(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -30,10 +39,18 @@ void ARPGHero_Character::PossessedBy(AController* NewController)
 	// Grant initial items on the server
 	if (HasAuthority())
 	{
+		PossessedTime = FPlatformTime::Seconds();
 		TryAddInitialInventory();
 	}
 }
 
+void ARPGHero_Character::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ClearInventoryReadyListeners();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ARPGHero_Character::OnDeathStarted(AActor* OwningActor)
 {
 	Super::OnDeathStarted(OwningActor);
@@ -42,8 +59,29 @@ void ARPGHero_Character::OnDeathStarted(AActor* OwningActor)
 	HideEquippedWeapons();
 }
 
+void ARPGHero_Character::OnParkedStateChanged(bool bParked)
+{
+	Super::OnParkedStateChanged(bParked);
+
+	// Equipment stays on a recycled hero, only show it again
+	if (!bParked)
+	{
+		if (URPGEquipmentManagerComponent* EquipmentManager = FindComponentByClass<URPGEquipmentManagerComponent>())
+		{
+			EquipmentManager->SetAllWeaponsHidden(false);
+		}
+	}
+}
+
 void ARPGHero_Character::StartRagdoll()
 {
+	// The corpse subsystem decides whether this death is worth a simulation; if it says no the death pose is kept
+	if (URPGCorpseSubsystem* CorpseSubsystem = URPGCorpseSubsystem::Get(this))
+	{
+		CorpseSubsystem->RequestRagdoll(GetMesh(), this);
+		return;
+	}
+
 	if (USkeletalMeshComponent* MeshComp = GetMesh())
 	{
 		MeshComp->SetCollisionProfileName(TEXT("Ragdoll"));
@@ -63,13 +101,27 @@ void ARPGHero_Character::HideEquippedWeapons()
 
 void ARPGHero_Character::AnimMotionEffect_Implementation(const FName Bone, const FGameplayTag MotionEffect, USceneComponent* StaticMeshComponent, const FVector LocationOffset, const FRotator RotationOffset, const UAnimSequenceBase* AnimationSequence, const bool bHitSuccess, const FHitResult HitResult, FGameplayTagContainer Contexts, FVector VFXScale, float AudioVolume, float AudioPitch)
 {
-	// Ensure we only run this on server or as appropriate for effects
-	// The user specified: "Logic này chỉ chạy trên Server để đảm bảo tính đồng bộ hoặc quản lý Actor một cách tập trung."
-	if (!HasAuthority())
+	RPGCosmeticPolicy::ReportCosmeticPath(this, TEXT("ARPGHero_Character::AnimMotionEffect"));
+
+	// Footstep effects are purely cosmetic: run them on clients and listen-server hosts, never on a dedicated server
+	if (!RPGCosmeticPolicy::ShouldRunCosmetics(this))
+	{
+		return;
+	}
+
+	// Low significance characters don't emit context effects
+	if (!URPGSignificanceSubsystem::ShouldEmitContextEffectsFor(this))
 	{
 		return;
 	}
 
+	// Prefer the pooled context effects component when the hero has one
+	if (URPGContextEffectComponent* ContextEffectComponent = FindComponentByClass<URPGContextEffectComponent>())
+	{
+		IRPGContextEffectsInterface::Execute_AnimMotionEffect(ContextEffectComponent, Bone, MotionEffect, StaticMeshComponent, LocationOffset, RotationOffset, AnimationSequence, bHitSuccess, HitResult, Contexts, VFXScale, AudioVolume, AudioPitch);
+		return;
+	}
+
 	if (!FootStepActor && FootStepActorClass)
 	{
 		FActorSpawnParameters SpawnParams;
@@ -99,30 +151,68 @@ void ARPGHero_Character::TryAddInitialInventory()
 
 	AController* C = GetController();
 	URPGPawnExtensionComponent* PawnExtComp = URPGPawnExtensionComponent::FindPawnExtensionComponent(this);
-	
+	UGameFrameworkComponentManager* Manager = UGameFrameworkComponentManager::GetForActor(this);
+	if (!C || !PawnExtComp || !Manager)
+	{
+		return;
+	}
+
 	// Guard 2: Pawn Extension must be ready (Data & ASC initialized)
-	if (!PawnExtComp || !PawnExtComp->HasReachedInitState(RPGGameplayTags::InitState_GameplayReady))
+	const bool bPawnReady = PawnExtComp->HasReachedInitState(RPGGameplayTags::InitState_GameplayReady);
+
+	// Guard 3: Controller components must be added by Experience and ready
+	const bool bInventoryReady = URPGQuickbarComponent::IsInventoryReady(C);
+
+	if (bPawnReady && bInventoryReady)
 	{
-		GetWorldTimerManager().SetTimer(TimerHandle_InventoryReady, this, &ARPGHero_Character::TryAddInitialInventory, 0.1f, false);
+		ClearInventoryReadyListeners();
+		AddInitialInventory(C->FindComponentByClass<URPGInventoryManagerComponent>(), C->FindComponentByClass<URPGQuickbarComponent>());
 		return;
 	}
 
-	// Guard 3: Controller components must be added by Experience
-	if (C)
+	// Wait for whatever is missing, each listener calls back in here when its feature gets ready
+	if (!bPawnReady && !PawnReadyHandle.IsValid())
+	{
+		PawnReadyHandle = Manager->RegisterAndCallForActorInitState(this, URPGPawnExtensionComponent::NAME_ActorFeatureName, RPGGameplayTags::InitState_GameplayReady,
+			FActorInitStateChangedDelegate::CreateUObject(this, &ThisClass::OnInventoryDependencyReady), /*bCallImmediately=*/ false);
+	}
+
+	if (!bInventoryReady && (!InventoryReadyHandle.IsValid() || (InventoryReadyController.Get() != C)))
+	{
+		if (AController* OldController = InventoryReadyController.Get())
+		{
+			Manager->UnregisterActorInitStateDelegate(OldController, InventoryReadyHandle);
+		}
+
+		InventoryReadyController = C;
+		InventoryReadyHandle = Manager->RegisterAndCallForActorInitState(C, URPGQuickbarComponent::NAME_ActorFeatureName, RPGGameplayTags::InitState_GameplayReady,
+			FActorInitStateChangedDelegate::CreateUObject(this, &ThisClass::OnInventoryDependencyReady), /*bCallImmediately=*/ false);
+	}
+}
+
+void ARPGHero_Character::OnInventoryDependencyReady(const FActorInitStateChangedParams& Params)
+{
+	TryAddInitialInventory();
+}
+
+void ARPGHero_Character::ClearInventoryReadyListeners()
+{
+	if (UGameFrameworkComponentManager* Manager = UGameFrameworkComponentManager::GetForActor(this))
 	{
-		URPGInventoryManagerComponent* InventoryMgr = C->FindComponentByClass<URPGInventoryManagerComponent>();
-		URPGQuickbarComponent* Quickbar = C->FindComponentByClass<URPGQuickbarComponent>();
+		if (PawnReadyHandle.IsValid())
+		{
+			Manager->UnregisterActorInitStateDelegate(this, PawnReadyHandle);
+		}
 
-		if (InventoryMgr && Quickbar)
+		if (AController* OldController = InventoryReadyController.Get())
 		{
-			AddInitialInventory(InventoryMgr, Quickbar);
-			GetWorldTimerManager().ClearTimer(TimerHandle_InventoryReady);
-			return;
+			Manager->UnregisterActorInitStateDelegate(OldController, InventoryReadyHandle);
 		}
 	}
 
-	// If we get here, components aren't ready yet, retry
-	GetWorldTimerManager().SetTimer(TimerHandle_InventoryReady, this, &ARPGHero_Character::TryAddInitialInventory, 0.1f, false);
+	PawnReadyHandle.Reset();
+	InventoryReadyHandle.Reset();
+	InventoryReadyController.Reset();
 }
 
 void ARPGHero_Character::AddInitialInventory(URPGInventoryManagerComponent* InventoryMgr, URPGQuickbarComponent* Quickbar)
@@ -154,4 +244,8 @@ void ARPGHero_Character::AddInitialInventory(URPGInventoryManagerComponent* Inve
 	}
 
 	bInventoryInitialized = true;
+
+	const float PossessionToEquippedMs = static_cast<float>((FPlatformTime::Seconds() - PossessedTime) * 1000.0);
+	SET_FLOAT_STAT(STAT_RPGHero_PossessionToEquipped, PossessionToEquippedMs);
+	UE_LOG(LogRPG, Log, TEXT("ARPGHero_Character::AddInitialInventory: %s fully equipped %.2f ms after possession"), *GetNameSafe(this), PossessionToEquippedMs);
 }
@@ -154,8 +154,14 @@ void URPGPawnExtensionComponent::InitializeAbilitySystem(URPGAbilitySystemCompon
 
 		// Grant initial equipment
 		URPGEquipmentManagerComponent* EquipmentManager = Pawn->FindComponentByClass<URPGEquipmentManagerComponent>();
-		if (EquipmentManager)
+		if (bInitialEquipmentGranted)
 		{
+			UE_LOG(LogRPG, Verbose, TEXT("InitializeAbilitySystem: Pawn %s is recycled, keeping its equipment."), *GetNameSafe(Pawn));
+		}
+		else if (EquipmentManager)
+		{
+			bInitialEquipmentGranted = Pawn->HasAuthority();
+
 			UE_LOG(LogRPG, Log, TEXT("InitializeAbilitySystem: Granting %d initial equipment items."), PawnData->InitialEquipment.Num());
 			for (const TSubclassOf<URPGEquipmentDefinition>& EquipmentDef : PawnData->InitialEquipment)
 			{
@@ -232,6 +238,19 @@ void URPGPawnExtensionComponent::SetupPlayerInputComponent()
 	CheckDefaultInitialization();
 }
 
+void URPGPawnExtensionComponent::ResetInitState()
+{
+	UninitializeAbilitySystem();
+
+	if (UGameFrameworkComponentManager* Manager = UGameFrameworkComponentManager::GetForActor(GetOwner()))
+	{
+		if (Manager->HasFeatureReachedInitState(GetOwner(), NAME_ActorFeatureName, RPGGameplayTags::InitState_DataAvailable))
+		{
+			Manager->ChangeFeatureInitState(GetOwner(), NAME_ActorFeatureName, this, RPGGameplayTags::InitState_Spawned);
+		}
+	}
+}
+
 void URPGPawnExtensionComponent::CheckDefaultInitialization()
 {
 	// Before checking our progress, try progressing any other features we might depend on
@@ -0,0 +1,225 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/RPGPawnRecycleSubsystem.h"
+#include "Character/RPGCharacter.h"
+#include "Character/RPGPawnData.h"
+#include "Character/RPGPawnExtensionComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "System/RPGLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGPawnRecycleSubsystem)
+
+DECLARE_STATS_GROUP(TEXT("RPG Respawn"), STATGROUP_RPGRespawn, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Park Pawn"), STAT_RPGRespawn_Park, STATGROUP_RPGRespawn);
+DECLARE_CYCLE_STAT(TEXT("Unpark Pawn"), STAT_RPGRespawn_Unpark, STATGROUP_RPGRespawn);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Parked Pawns"), STAT_RPGRespawn_NumParked, STATGROUP_RPGRespawn);
+
+namespace RPGConsoleVariables
+{
+	static bool bRecyclePawns = true;
+	static FAutoConsoleVariableRef CVarRecyclePawns(
+		TEXT("rpg.respawn.RecyclePawns"),
+		bRecyclePawns,
+		TEXT("Should dead player pawns be parked and given back on respawn instead of being destroyed and spawned again?"),
+		ECVF_Default);
+
+	static bool bLogRespawnLatency = false;
+	static FAutoConsoleVariableRef CVarLogRespawnLatency(
+		TEXT("rpg.respawn.LogLatency"),
+		bLogRespawnLatency,
+		TEXT("Should every measured death to control latency be logged?"),
+		ECVF_Default);
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpRPGPawnRecycle(
+	TEXT("RPG.DumpPawnRecycle"),
+	TEXT("Prints the parked pawns and the death to control latency of recycled and freshly spawned pawns."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const URPGPawnRecycleSubsystem* Subsystem = URPGPawnRecycleSubsystem::Get(World))
+		{
+			Subsystem->DumpToOutputDevice(Ar);
+		}
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// URPGPawnRecycleSubsystem
+
+URPGPawnRecycleSubsystem* URPGPawnRecycleSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<URPGPawnRecycleSubsystem>() : nullptr;
+}
+
+bool URPGPawnRecycleSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void URPGPawnRecycleSubsystem::Deinitialize()
+{
+	ParkedPawns.Reset();
+	PendingRespawns.Reset();
+
+	Super::Deinitialize();
+}
+
+bool URPGPawnRecycleSubsystem::TryParkPawn(ARPGCharacter* Character)
+{
+	if (!RPGConsoleVariables::bRecyclePawns || !Character || !Character->HasAuthority() || Character->IsParkedForRecycling())
+	{
+		return false;
+	}
+
+	// Only players come back through RequestPlayerRestartNextFrame, other pawns are never asked for again
+	APlayerController* PC = Cast<APlayerController>(Character->GetController());
+	if (!PC || PC->IsPendingKillPending())
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RPGRespawn_Park);
+
+	ReleaseParkedPawn(PC);
+
+	Character->ParkForRecycling();
+	ParkedPawns.Add(PC, Character);
+	++NumParked;
+
+	SET_DWORD_STAT(STAT_RPGRespawn_NumParked, ParkedPawns.Num());
+
+	UE_LOG(LogRPG, Verbose, TEXT("URPGPawnRecycleSubsystem::TryParkPawn: Parked %s for %s"), *GetNameSafe(Character), *GetNameSafe(PC));
+	return true;
+}
+
+ARPGCharacter* URPGPawnRecycleSubsystem::TakeParkedPawn(AController* Controller, UClass* PawnClass, const URPGPawnData* PawnData, const FTransform& SpawnTransform)
+{
+	TWeakObjectPtr<ARPGCharacter> ParkedPawn;
+	if (!Controller || !ParkedPawns.RemoveAndCopyValue(Controller, ParkedPawn))
+	{
+		return nullptr;
+	}
+
+	SET_DWORD_STAT(STAT_RPGRespawn_NumParked, ParkedPawns.Num());
+
+	ARPGCharacter* Character = ParkedPawn.Get();
+	if (!Character || Character->IsPendingKillPending())
+	{
+		return nullptr;
+	}
+
+	// The experience may have changed what this player should spawn as
+	const URPGPawnExtensionComponent* PawnExtComp = URPGPawnExtensionComponent::FindPawnExtensionComponent(Character);
+	const bool bMatchesClass = (PawnClass == nullptr) || (Character->GetClass() == PawnClass);
+	const bool bMatchesPawnData = (PawnData == nullptr) || (PawnExtComp && (PawnExtComp->GetPawnData<URPGPawnData>() == PawnData));
+	if (!bMatchesClass || !bMatchesPawnData)
+	{
+		UE_LOG(LogRPG, Log, TEXT("URPGPawnRecycleSubsystem::TakeParkedPawn: Discarding %s, it no longer matches the pawn wanted for %s"), *GetNameSafe(Character), *GetNameSafe(Controller));
+		Character->Destroy();
+		++NumDiscarded;
+		return nullptr;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RPGRespawn_Unpark);
+
+	Character->UnparkForRecycling(SpawnTransform);
+	++NumRecycled;
+
+	if (FRespawnRecord* Record = PendingRespawns.Find(Controller))
+	{
+		Record->bRecycledPawn = true;
+	}
+
+	return Character;
+}
+
+void URPGPawnRecycleSubsystem::ReleaseParkedPawn(AController* Controller)
+{
+	TWeakObjectPtr<ARPGCharacter> ParkedPawn;
+	if (Controller && ParkedPawns.RemoveAndCopyValue(Controller, ParkedPawn))
+	{
+		if (ARPGCharacter* Character = ParkedPawn.Get())
+		{
+			Character->Destroy();
+		}
+
+		SET_DWORD_STAT(STAT_RPGRespawn_NumParked, ParkedPawns.Num());
+	}
+}
+
+void URPGPawnRecycleSubsystem::HandleControllerLogout(AController* Controller)
+{
+	ReleaseParkedPawn(Controller);
+	PendingRespawns.Remove(Controller);
+}
+
+void URPGPawnRecycleSubsystem::NotifyPawnDied(ARPGCharacter* Character)
+{
+	AController* Controller = Character ? Character->GetController() : nullptr;
+	if (Cast<APlayerController>(Controller))
+	{
+		FRespawnRecord& Record = PendingRespawns.FindOrAdd(Controller);
+		Record.DeathTime = FPlatformTime::Seconds();
+		Record.bRecycledPawn = false;
+	}
+}
+
+void URPGPawnRecycleSubsystem::NotifyPlayerRestarted(AController* Controller, double RestartSeconds)
+{
+	FRespawnRecord Record;
+	if (!Controller || !PendingRespawns.RemoveAndCopyValue(Controller, Record))
+	{
+		// First spawn, nothing to measure
+		return;
+	}
+
+	FRPGRespawnLatencySample Sample;
+	Sample.DeathToControlSeconds = FPlatformTime::Seconds() - Record.DeathTime;
+	Sample.RestartMilliseconds = RestartSeconds * 1000.0;
+	Sample.bRecycledPawn = Record.bRecycledPawn;
+
+	(Sample.bRecycledPawn ? RecycledStats : SpawnedStats).AddSample(Sample);
+
+	UE_CLOG(RPGConsoleVariables::bLogRespawnLatency, LogRPG, Log, TEXT("URPGPawnRecycleSubsystem::NotifyPlayerRestarted: %s back in control after %.3f s (restart %.3f ms, %s)"),
+		*GetNameSafe(Controller), Sample.DeathToControlSeconds, Sample.RestartMilliseconds, Sample.bRecycledPawn ? TEXT("recycled") : TEXT("spawned"));
+
+	OnRespawnLatencyMeasured.Broadcast(Controller, Sample);
+}
+
+void URPGPawnRecycleSubsystem::FLatencyStats::AddSample(const FRPGRespawnLatencySample& Sample)
+{
+	++NumSamples;
+	TotalDeathToControl += Sample.DeathToControlSeconds;
+	MaxDeathToControl = FMath::Max(MaxDeathToControl, Sample.DeathToControlSeconds);
+	TotalRestartMs += Sample.RestartMilliseconds;
+	MaxRestartMs = FMath::Max(MaxRestartMs, Sample.RestartMilliseconds);
+}
+
+void URPGPawnRecycleSubsystem::DumpToOutputDevice(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("RPGPawnRecycleSubsystem: %d parked pawns (recycling %s), %d parked, %d recycled, %d discarded in total"),
+		ParkedPawns.Num(), RPGConsoleVariables::bRecyclePawns ? TEXT("on") : TEXT("off"), NumParked, NumRecycled, NumDiscarded);
+
+	for (const TPair<TObjectKey<AController>, TWeakObjectPtr<ARPGCharacter>>& Pair : ParkedPawns)
+	{
+		Ar.Logf(TEXT("  %s -> %s"), *GetNameSafe(Pair.Key.ResolveObjectPtr()), *GetNameSafe(Pair.Value.Get()));
+	}
+
+	auto DumpStats = [&Ar](const TCHAR* Label, const FLatencyStats& Stats)
+	{
+		if (Stats.NumSamples > 0)
+		{
+			Ar.Logf(TEXT("  %s: %d respawns, death to control avg %.3f s max %.3f s, restart avg %.3f ms max %.3f ms"),
+				Label, Stats.NumSamples, Stats.TotalDeathToControl / Stats.NumSamples, Stats.MaxDeathToControl, Stats.TotalRestartMs / Stats.NumSamples, Stats.MaxRestartMs);
+		}
+		else
+		{
+			Ar.Logf(TEXT("  %s: no respawns measured"), Label);
+		}
+	};
+
+	DumpStats(TEXT("Recycled"), RecycledStats);
+	DumpStats(TEXT("Spawned"), SpawnedStats);
+}
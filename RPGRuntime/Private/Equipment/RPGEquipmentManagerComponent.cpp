@@ -14,7 +14,14 @@ void FRPGEquipmentList::PreReplicatedRemove(const TArrayView<int32> RemovedIndic
 	for (int32 Index : RemovedIndices)
 	{
 		const FRPGAppliedEquipmentEntry& Entry = Entries[Index];
-		if (Entry.Instance) Entry.Instance->Unequip();
+		if (Entry.Instance)
+		{
+			Entry.Instance->Unequip();
+			if (URPGEquipmentManagerComponent* Manager = Cast<URPGEquipmentManagerComponent>(OwnerComponent))
+			{
+				Manager->RemoveInstanceFromIndex(Entry.Instance);
+			}
+		}
 	}
 }
 
@@ -23,12 +30,31 @@ void FRPGEquipmentList::PostReplicatedAdd(const TArrayView<int32> AddedIndices,
 	for (int32 Index : AddedIndices)
 	{
 		const FRPGAppliedEquipmentEntry& Entry = Entries[Index];
-		if (Entry.Instance) Entry.Instance->Equip();
+		if (Entry.Instance)
+		{
+			Entry.Instance->Equip();
+			if (URPGEquipmentManagerComponent* Manager = Cast<URPGEquipmentManagerComponent>(OwnerComponent))
+			{
+				Manager->AddInstanceToIndex(Entry.Instance);
+			}
+		}
 	}
 }
 
 void FRPGEquipmentList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
 {
+	// The instance subobject may resolve after the entry was added; make sure it ends up in the index
+	if (URPGEquipmentManagerComponent* Manager = Cast<URPGEquipmentManagerComponent>(OwnerComponent))
+	{
+		for (int32 Index : ChangedIndices)
+		{
+			const FRPGAppliedEquipmentEntry& Entry = Entries[Index];
+			if (Entry.Instance)
+			{
+				Manager->AddInstanceToIndex(Entry.Instance);
+			}
+		}
+	}
 }
 
 URPGWeaponInstance* FRPGEquipmentList::AddEntry(TSubclassOf<URPGEquipmentDefinition> EquipmentDefinition)
@@ -88,6 +114,7 @@ URPGWeaponInstance* URPGEquipmentManagerComponent::EquipItem(TSubclassOf<URPGEqu
 	if (Result)
 	{
 		AddReplicatedSubObject(Result);
+		AddInstanceToIndex(Result);
 	}
 	return Result;
 }
@@ -98,18 +125,121 @@ void URPGEquipmentManagerComponent::UnequipItem(URPGWeaponInstance* ItemInstance
 	{
 		RemoveReplicatedSubObject(ItemInstance);
 		EquipmentList.RemoveEntry(ItemInstance);
+		RemoveInstanceFromIndex(ItemInstance);
 	}
 }
 
 URPGWeaponInstance* URPGEquipmentManagerComponent::GetFirstInstanceOfType(TSubclassOf<URPGWeaponInstance> InstanceType)
 {
-	for (FRPGAppliedEquipmentEntry& Entry : EquipmentList.Entries)
+	if (const FRPGEquipmentInstanceBucket* Bucket = InstancesByClass.Find(InstanceType.Get()))
 	{
-		if (Entry.Instance && Entry.Instance->IsA(InstanceType)) return Entry.Instance;
+		return Bucket->Instances.Num() > 0 ? Bucket->Instances[0].Get() : nullptr;
 	}
 	return nullptr;
 }
 
+TArray<URPGWeaponInstance*> URPGEquipmentManagerComponent::GetEquipmentInstancesOfType(TSubclassOf<URPGWeaponInstance> InstanceType) const
+{
+	TArray<URPGWeaponInstance*> Results;
+	if (const FRPGEquipmentInstanceBucket* Bucket = InstancesByClass.Find(InstanceType.Get()))
+	{
+		Results.Append(Bucket->Instances);
+	}
+	return Results;
+}
+
+FRPGEquipmentOfClassChanged& URPGEquipmentManagerComponent::OnEquipmentOfClassChanged(TSubclassOf<URPGWeaponInstance> InstanceType)
+{
+	return ClassChangedDelegates.FindOrAdd(InstanceType.Get());
+}
+
+const TArray<TObjectPtr<UClass>>& URPGEquipmentManagerComponent::GetClassChain(UClass* InstanceClass)
+{
+	if (const FRPGEquipmentClassChain* Cached = ClassChainCache.Find(InstanceClass))
+	{
+		return Cached->Classes;
+	}
+
+	// Walk up to (and including) URPGWeaponInstance; nothing above it can be queried through TSubclassOf
+	FRPGEquipmentClassChain& NewChain = ClassChainCache.Add(InstanceClass);
+	for (UClass* Class = InstanceClass; Class; Class = Class->GetSuperClass())
+	{
+		NewChain.Classes.Add(Class);
+		if (Class == URPGWeaponInstance::StaticClass())
+		{
+			break;
+		}
+	}
+	return NewChain.Classes;
+}
+
+void URPGEquipmentManagerComponent::AddInstanceToIndex(URPGWeaponInstance* Instance)
+{
+	check(Instance);
+
+	const TArray<TObjectPtr<UClass>>& ClassChain = GetClassChain(Instance->GetClass());
+
+	// The most derived bucket tells us if we already indexed this instance (e.g. add followed by change on clients)
+	if (const FRPGEquipmentInstanceBucket* ExactBucket = InstancesByClass.Find(Instance->GetClass()))
+	{
+		if (ExactBucket->Instances.Contains(Instance))
+		{
+			return;
+		}
+	}
+
+	for (UClass* Class : ClassChain)
+	{
+		InstancesByClass.FindOrAdd(Class).Instances.Add(Instance);
+	}
+
+	BroadcastClassChanged(ClassChain);
+}
+
+void URPGEquipmentManagerComponent::RemoveInstanceFromIndex(URPGWeaponInstance* Instance)
+{
+	check(Instance);
+
+	const TArray<TObjectPtr<UClass>>& ClassChain = GetClassChain(Instance->GetClass());
+
+	bool bRemoved = false;
+	for (UClass* Class : ClassChain)
+	{
+		if (FRPGEquipmentInstanceBucket* Bucket = InstancesByClass.Find(Class))
+		{
+			bRemoved |= (Bucket->Instances.RemoveSingle(Instance) > 0);
+			if (Bucket->Instances.Num() == 0)
+			{
+				InstancesByClass.Remove(Class);
+			}
+		}
+	}
+
+	if (bRemoved)
+	{
+		BroadcastClassChanged(ClassChain);
+	}
+}
+
+void URPGEquipmentManagerComponent::BroadcastClassChanged(const TArray<TObjectPtr<UClass>>& ClassChain)
+{
+	if (ClassChangedDelegates.Num() == 0)
+	{
+		return;
+	}
+
+	// Copy the chain and delegates, listeners may equip/unequip or register from inside the callback
+	const TArray<TObjectPtr<UClass>> ClassesToNotify = ClassChain;
+	for (UClass* Class : ClassesToNotify)
+	{
+		if (const FRPGEquipmentOfClassChanged* Delegate = ClassChangedDelegates.Find(Class))
+		{
+			const FRPGEquipmentOfClassChanged DelegateCopy = *Delegate;
+			DelegateCopy.Broadcast(this, Class);
+		}
+	}
+}
+
 void URPGEquipmentManagerComponent::SetAllWeaponsHidden(bool bHidden)
 {
 	for (FRPGAppliedEquipmentEntry& Entry : EquipmentList.Entries)
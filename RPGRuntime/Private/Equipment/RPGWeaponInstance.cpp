@@ -82,6 +82,7 @@ void URPGWeaponInstance::Equip()
     
     bIsEquipped = true;
     K2_OnEquipped();
+    OnCosmeticStateChanged.Broadcast(this);
 }
 
 void URPGWeaponInstance::Unequip()
@@ -108,6 +109,15 @@ void URPGWeaponInstance::Unequip()
     
     bIsEquipped = false;
     K2_OnUnequipped();
+    OnCosmeticStateChanged.Broadcast(this);
+}
+
+void URPGWeaponInstance::SetCosmeticTags(const FGameplayTagContainer& InCosmeticTags)
+{
+    if (CosmeticTags == InCosmeticTags) return;
+
+    CosmeticTags = InCosmeticTags;
+    OnCosmeticStateChanged.Broadcast(this);
 }
 
 void URPGWeaponInstance::ActivateAnimLayer(bool bEquip)
@@ -0,0 +1,168 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Feedback/ContextEffects/RPGContextEffectComponent.h"
+#include "Character/RPGCharacterMovementComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Feedback/ContextEffects/RPGContextEffectsLibrary.h"
+#include "Feedback/ContextEffects/RPGContextEffectsSubsystem.h"
+#include "GameFramework/Character.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "System/RPGCosmeticPolicy.h"
+#include "System/RPGSignificanceSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGContextEffectComponent)
+
+URPGContextEffectComponent::URPGContextEffectComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	SetIsReplicatedByDefault(false);
+}
+
+void URPGContextEffectComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Nothing to load when effects can never play here
+	if (!RPGCosmeticPolicy::ShouldRunCosmetics(this))
+	{
+		return;
+	}
+
+	CurrentContexts.AppendTags(DefaultEffectContexts);
+	CurrentLibraries = DefaultContextEffectsLibraries;
+	LoadLibraries();
+}
+
+void URPGContextEffectComponent::UpdateEffectContexts(FGameplayTagContainer NewEffectContexts)
+{
+	CurrentContexts.Reset(NewEffectContexts.Num());
+	CurrentContexts.AppendTags(NewEffectContexts);
+}
+
+void URPGContextEffectComponent::UpdateLibraries(const TSet<TSoftObjectPtr<URPGContextEffectsLibrary>>& NewLibraries)
+{
+	CurrentLibraries = NewLibraries;
+
+	if (RPGCosmeticPolicy::ShouldRunCosmetics(this))
+	{
+		LoadLibraries();
+	}
+}
+
+void URPGContextEffectComponent::LoadLibraries()
+{
+	ActiveLibraries.Reset();
+
+	TArray<FSoftObjectPath> LibrariesToLoad;
+	for (const TSoftObjectPtr<URPGContextEffectsLibrary>& Library : CurrentLibraries)
+	{
+		if (URPGContextEffectsLibrary* LoadedLibrary = Library.Get())
+		{
+			LoadedLibrary->LoadEffects();
+			ActiveLibraries.Add(LoadedLibrary);
+		}
+		else if (!Library.IsNull())
+		{
+			LibrariesToLoad.Add(Library.ToSoftObjectPath());
+		}
+	}
+
+	if (LibrariesToLoad.Num() > 0)
+	{
+		UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(LibrariesToLoad, FStreamableDelegate::CreateWeakLambda(this, [this, LibrariesToLoad]()
+		{
+			for (const FSoftObjectPath& Path : LibrariesToLoad)
+			{
+				if (URPGContextEffectsLibrary* LoadedLibrary = Cast<URPGContextEffectsLibrary>(Path.ResolveObject()))
+				{
+					LoadedLibrary->LoadEffects();
+					ActiveLibraries.AddUnique(LoadedLibrary);
+				}
+			}
+		}));
+	}
+}
+
+FGameplayTag URPGContextEffectComponent::GetSurfaceContext(bool bHitSuccess, const FHitResult& HitResult) const
+{
+	EPhysicalSurface SurfaceType = SurfaceType_Default;
+
+	if (bHitSuccess)
+	{
+		SurfaceType = UPhysicalMaterial::DetermineSurfaceType(HitResult.PhysMaterial.Get());
+	}
+	else if (const ACharacter* Character = Cast<ACharacter>(GetOwner()))
+	{
+		// Reuse the ground info the movement component already caches for this frame instead of tracing again
+		if (URPGCharacterMovementComponent* MovementComponent = Cast<URPGCharacterMovementComponent>(Character->GetCharacterMovement()))
+		{
+			SurfaceType = MovementComponent->GetGroundInfo().SurfaceType;
+		}
+	}
+
+	if (const FGameplayTag* SurfaceContext = SurfaceTypeToContext.Find(SurfaceType))
+	{
+		return *SurfaceContext;
+	}
+
+	return FGameplayTag();
+}
+
+void URPGContextEffectComponent::AnimMotionEffect_Implementation(const FName Bone, const FGameplayTag MotionEffect, USceneComponent* StaticMeshComponent, const FVector LocationOffset, const FRotator RotationOffset, const UAnimSequenceBase* AnimationSequence, const bool bHitSuccess, const FHitResult HitResult, FGameplayTagContainer Contexts, FVector VFXScale, float AudioVolume, float AudioPitch)
+{
+	RPGCosmeticPolicy::ReportCosmeticPath(this, TEXT("URPGContextEffectComponent::AnimMotionEffect"));
+
+	if (!RPGCosmeticPolicy::ShouldRunCosmetics(this) || !URPGSignificanceSubsystem::ShouldEmitContextEffectsFor(GetOwner()))
+	{
+		return;
+	}
+
+	URPGContextEffectsSubsystem* EffectsSubsystem = URPGContextEffectsSubsystem::Get(this);
+	if (!EffectsSubsystem || ActiveLibraries.Num() == 0)
+	{
+		return;
+	}
+
+	// Cull before doing any lookup work
+	const FTransform SocketTransform = StaticMeshComponent ? StaticMeshComponent->GetSocketTransform(Bone) : GetOwner()->GetActorTransform();
+	const FVector Location = SocketTransform.GetLocation() + LocationOffset;
+	if (!EffectsSubsystem->ShouldPlayEffectAt(Location))
+	{
+		return;
+	}
+	const FRotator Rotation = SocketTransform.Rotator() + RotationOffset;
+
+	Contexts.AppendTags(CurrentContexts);
+	if (bConvertPhysicalSurfaceToContext)
+	{
+		const FGameplayTag SurfaceContext = GetSurfaceContext(bHitSuccess, HitResult);
+		if (SurfaceContext.IsValid())
+		{
+			Contexts.AddTag(SurfaceContext);
+		}
+	}
+
+	for (URPGContextEffectsLibrary* Library : ActiveLibraries)
+	{
+		const FRPGCompiledContextEffects* Effects = Library ? Library->FindEffects(MotionEffect, Contexts, MatchType) : nullptr;
+		if (!Effects)
+		{
+			continue;
+		}
+
+		for (USoundBase* Sound : Effects->Sounds)
+		{
+			EffectsSubsystem->PlaySoundAtLocation(Sound, Location, AudioVolume, AudioPitch);
+		}
+
+		for (UNiagaraSystem* NiagaraSystem : Effects->NiagaraSystems)
+		{
+			EffectsSubsystem->SpawnNiagaraAtLocation(NiagaraSystem, Location, Rotation, VFXScale);
+		}
+	}
+}
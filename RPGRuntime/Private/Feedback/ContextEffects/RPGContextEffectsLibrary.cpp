@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Feedback/ContextEffects/RPGContextEffectsLibrary.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "NiagaraSystem.h"
+#include "Sound/SoundBase.h"
+#include "System/RPGLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGContextEffectsLibrary)
+
+void URPGContextEffectsLibrary::LoadEffects()
+{
+	if (LoadState != ERPGContextEffectsLibraryLoadState::Unloaded)
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (const FRPGContextEffects& Entry : ContextEffects)
+	{
+		for (const FSoftObjectPath& Path : Entry.Effects)
+		{
+			if (Path.IsValid())
+			{
+				PathsToLoad.AddUnique(Path);
+			}
+		}
+	}
+
+	if (PathsToLoad.Num() == 0)
+	{
+		CompileEffects();
+		return;
+	}
+
+	LoadState = ERPGContextEffectsLibraryLoadState::Loading;
+	LoadHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(PathsToLoad, FStreamableDelegate::CreateWeakLambda(this, [this]()
+	{
+		CompileEffects();
+	}));
+}
+
+void URPGContextEffectsLibrary::CompileEffects()
+{
+	CompiledEffects.Reset();
+	CompiledEffectsByTag.Reset();
+	QueryCache.Reset();
+
+	for (const FRPGContextEffects& Entry : ContextEffects)
+	{
+		FRPGCompiledContextEffects Compiled;
+		Compiled.Context = Entry.Context;
+
+		for (const FSoftObjectPath& Path : Entry.Effects)
+		{
+			UObject* Object = Path.ResolveObject();
+			if (USoundBase* Sound = Cast<USoundBase>(Object))
+			{
+				Compiled.Sounds.Add(Sound);
+			}
+			else if (UNiagaraSystem* NiagaraSystem = Cast<UNiagaraSystem>(Object))
+			{
+				Compiled.NiagaraSystems.Add(NiagaraSystem);
+			}
+			else if (Path.IsValid())
+			{
+				UE_LOG(LogRPG, Warning, TEXT("URPGContextEffectsLibrary::CompileEffects: [%s] in %s is not a sound or Niagara system, or failed to load."), *Path.ToString(), *GetNameSafe(this));
+			}
+		}
+
+		const int32 NewIndex = CompiledEffects.Add(MoveTemp(Compiled));
+		CompiledEffectsByTag.FindOrAdd(Entry.EffectTag).Add(NewIndex);
+	}
+
+	LoadState = ERPGContextEffectsLibraryLoadState::Loaded;
+	LoadHandle.Reset();
+}
+
+const FRPGCompiledContextEffects* URPGContextEffectsLibrary::FindEffects(const FGameplayTag& EffectTag, const FGameplayTagContainer& Contexts, ERPGContextMatchType MatchType)
+{
+	if (LoadState != ERPGContextEffectsLibraryLoadState::Loaded)
+	{
+		return nullptr;
+	}
+
+	FQueryKey Key;
+	Key.EffectTag = EffectTag;
+	Key.Contexts = Contexts;
+	Key.MatchType = MatchType;
+
+	if (const int32* CachedIndex = QueryCache.Find(Key))
+	{
+		return CompiledEffects.IsValidIndex(*CachedIndex) ? &CompiledEffects[*CachedIndex] : nullptr;
+	}
+
+	int32 BestIndex = INDEX_NONE;
+	if (const TArray<int32>* Candidates = CompiledEffectsByTag.Find(EffectTag))
+	{
+		int32 BestMatchCount = -1;
+		for (int32 CandidateIndex : *Candidates)
+		{
+			const FGameplayTagContainer& EntryContext = CompiledEffects[CandidateIndex].Context;
+			if (!Contexts.HasAllExact(EntryContext))
+			{
+				continue;
+			}
+
+			if (MatchType == ERPGContextMatchType::ExactMatch)
+			{
+				if (EntryContext.Num() == Contexts.Num())
+				{
+					BestIndex = CandidateIndex;
+					break;
+				}
+			}
+			else if (EntryContext.Num() > BestMatchCount)
+			{
+				// The most specific entry wins
+				BestMatchCount = EntryContext.Num();
+				BestIndex = CandidateIndex;
+			}
+		}
+	}
+
+	QueryCache.Add(MoveTemp(Key), BestIndex);
+	return CompiledEffects.IsValidIndex(BestIndex) ? &CompiledEffects[BestIndex] : nullptr;
+}
@@ -0,0 +1,258 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Feedback/ContextEffects/RPGContextEffectsSubsystem.h"
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "Sound/SoundBase.h"
+#include "System/RPGCosmeticPolicy.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGContextEffectsSubsystem)
+
+namespace RPGConsoleVariables
+{
+	static int32 ContextEffectsMaxPooledAudio = 32;
+	static FAutoConsoleVariableRef CVarContextEffectsMaxPooledAudio(
+		TEXT("rpg.contexteffects.MaxPooledAudio"),
+		ContextEffectsMaxPooledAudio,
+		TEXT("Maximum number of pooled audio components per world. Sounds requested while all of them are playing are dropped."),
+		ECVF_Default);
+
+	static int32 ContextEffectsMaxActiveNiagara = 64;
+	static FAutoConsoleVariableRef CVarContextEffectsMaxActiveNiagara(
+		TEXT("rpg.contexteffects.MaxActiveNiagara"),
+		ContextEffectsMaxActiveNiagara,
+		TEXT("Maximum number of context effect Niagara systems active at the same time per world."),
+		ECVF_Default);
+
+	static float ContextEffectsCullDistance = 5000.0f;
+	static FAutoConsoleVariableRef CVarContextEffectsCullDistance(
+		TEXT("rpg.contexteffects.CullDistance"),
+		ContextEffectsCullDistance,
+		TEXT("Context effects further than this from every local viewer are not played (0 = no culling)."),
+		ECVF_Default);
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpRPGContextEffects(
+	TEXT("RPG.DumpContextEffects"),
+	TEXT("Prints the context effects pool usage and counters for the current world."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const URPGContextEffectsSubsystem* Subsystem = URPGContextEffectsSubsystem::Get(World))
+		{
+			Subsystem->DumpToOutputDevice(Ar);
+		}
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// URPGContextEffectsSubsystem
+
+URPGContextEffectsSubsystem* URPGContextEffectsSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<URPGContextEffectsSubsystem>() : nullptr;
+}
+
+bool URPGContextEffectsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void URPGContextEffectsSubsystem::Deinitialize()
+{
+	for (UAudioComponent* AudioComponent : AudioPool)
+	{
+		if (AudioComponent)
+		{
+			AudioComponent->DestroyComponent();
+		}
+	}
+	AudioPool.Reset();
+
+	for (UNiagaraComponent* NiagaraComponent : ActiveNiagaraComponents)
+	{
+		if (IsValid(NiagaraComponent))
+		{
+			NiagaraComponent->OnSystemFinished.RemoveDynamic(this, &ThisClass::HandleNiagaraSystemFinished);
+			NiagaraComponent->ReleaseToPool();
+		}
+	}
+	ActiveNiagaraComponents.Reset();
+
+	Super::Deinitialize();
+}
+
+bool URPGContextEffectsSubsystem::IsWithinCullDistance(const FVector& Location)
+{
+	const float CullDistance = RPGConsoleVariables::ContextEffectsCullDistance;
+	if (CullDistance <= 0.0f)
+	{
+		return true;
+	}
+
+	if (ViewerCacheFrame != GFrameCounter)
+	{
+		ViewerCacheFrame = GFrameCounter;
+		CachedViewerLocations.Reset();
+
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = It->Get();
+			if (PC && PC->IsLocalController())
+			{
+				FVector ViewLocation;
+				FRotator ViewRotation;
+				PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+				CachedViewerLocations.Add(ViewLocation);
+			}
+		}
+	}
+
+	const float CullDistanceSq = FMath::Square(CullDistance);
+	for (const FVector& ViewerLocation : CachedViewerLocations)
+	{
+		if (FVector::DistSquared(ViewerLocation, Location) <= CullDistanceSq)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool URPGContextEffectsSubsystem::ShouldPlayEffectAt(const FVector& Location)
+{
+	if (IsWithinCullDistance(Location))
+	{
+		return true;
+	}
+
+	++NumCulledByDistance;
+	return false;
+}
+
+UAudioComponent* URPGContextEffectsSubsystem::AcquireAudioComponent()
+{
+	for (UAudioComponent* AudioComponent : AudioPool)
+	{
+		if (AudioComponent && !AudioComponent->IsPlaying())
+		{
+			return AudioComponent;
+		}
+	}
+
+	if (AudioPool.Num() >= RPGConsoleVariables::ContextEffectsMaxPooledAudio)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = GetWorld();
+	AWorldSettings* PoolOwner = World ? World->GetWorldSettings() : nullptr;
+	if (!PoolOwner)
+	{
+		return nullptr;
+	}
+
+	UAudioComponent* NewComponent = NewObject<UAudioComponent>(PoolOwner, NAME_None, RF_Transient);
+	NewComponent->bAutoActivate = false;
+	NewComponent->bAutoDestroy = false;
+	NewComponent->bAllowSpatialization = true;
+	NewComponent->RegisterComponentWithWorld(World);
+
+	AudioPool.Add(NewComponent);
+	return NewComponent;
+}
+
+bool URPGContextEffectsSubsystem::PlaySoundAtLocation(USoundBase* Sound, const FVector& Location, float VolumeMultiplier, float PitchMultiplier)
+{
+	RPGCosmeticPolicy::ReportCosmeticPath(this, TEXT("URPGContextEffectsSubsystem::PlaySoundAtLocation"));
+
+	if (!Sound || !IsWithinCullDistance(Location))
+	{
+		return false;
+	}
+
+	UAudioComponent* AudioComponent = AcquireAudioComponent();
+	if (!AudioComponent)
+	{
+		++NumDroppedByCap;
+		return false;
+	}
+
+	AudioComponent->SetSound(Sound);
+	AudioComponent->SetWorldLocation(Location);
+	AudioComponent->SetVolumeMultiplier(VolumeMultiplier);
+	AudioComponent->SetPitchMultiplier(PitchMultiplier);
+	AudioComponent->Play();
+
+	++NumSoundsPlayed;
+	return true;
+}
+
+bool URPGContextEffectsSubsystem::SpawnNiagaraAtLocation(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation, const FVector& Scale)
+{
+	RPGCosmeticPolicy::ReportCosmeticPath(this, TEXT("URPGContextEffectsSubsystem::SpawnNiagaraAtLocation"));
+
+	if (!System || !IsWithinCullDistance(Location))
+	{
+		return false;
+	}
+
+	// Only components destroyed with their world never report finishing
+	ActiveNiagaraComponents.RemoveAllSwap([](const UNiagaraComponent* Component)
+	{
+		return !IsValid(Component);
+	});
+
+	if (ActiveNiagaraComponents.Num() >= RPGConsoleVariables::ContextEffectsMaxActiveNiagara)
+	{
+		++NumDroppedByCap;
+		return false;
+	}
+
+	// ManualRelease so the component stays ours until it finishes, AutoRelease hands it back to the pool without telling us
+	UNiagaraComponent* NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), System, Location, Rotation, Scale, /*bAutoDestroy=*/ false, /*bAutoActivate=*/ true, ENCPoolMethod::ManualRelease);
+	if (!NiagaraComponent)
+	{
+		return false;
+	}
+
+	NiagaraComponent->OnSystemFinished.AddUniqueDynamic(this, &ThisClass::HandleNiagaraSystemFinished);
+	ActiveNiagaraComponents.Add(NiagaraComponent);
+	++NumNiagaraSpawned;
+	return true;
+}
+
+void URPGContextEffectsSubsystem::HandleNiagaraSystemFinished(UNiagaraComponent* FinishedComponent)
+{
+	if (!FinishedComponent)
+	{
+		return;
+	}
+
+	FinishedComponent->OnSystemFinished.RemoveDynamic(this, &ThisClass::HandleNiagaraSystemFinished);
+	ActiveNiagaraComponents.RemoveSingleSwap(FinishedComponent);
+	FinishedComponent->ReleaseToPool();
+}
+
+void URPGContextEffectsSubsystem::DumpToOutputDevice(FOutputDevice& Ar) const
+{
+	int32 NumAudioPlaying = 0;
+	for (const UAudioComponent* AudioComponent : AudioPool)
+	{
+		if (AudioComponent && AudioComponent->IsPlaying())
+		{
+			++NumAudioPlaying;
+		}
+	}
+
+	Ar.Logf(TEXT("========== RPG Context Effects =========="));
+	Ar.Logf(TEXT("Audio pool: %d/%d components, %d playing"), AudioPool.Num(), RPGConsoleVariables::ContextEffectsMaxPooledAudio, NumAudioPlaying);
+	Ar.Logf(TEXT("Niagara: %d active, cap %d"), ActiveNiagaraComponents.Num(), RPGConsoleVariables::ContextEffectsMaxActiveNiagara);
+	Ar.Logf(TEXT("Sounds played: %d  Niagara spawned: %d  Culled by distance: %d  Dropped by cap: %d"), NumSoundsPlayed, NumNiagaraSpawned, NumCulledByDistance, NumDroppedByCap);
+	Ar.Logf(TEXT("========== ========== =========="));
+}
@@ -0,0 +1,363 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameMode/RPGExperienceLoadProfiler.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "System/RPGLogChannels.h"
+
+namespace RPGConsoleVariables
+{
+	static int32 ExperienceLoadHistorySize = 16;
+	static FAutoConsoleVariableRef CVarExperienceLoadHistorySize(
+		TEXT("rpg.experience.LoadHistorySize"),
+		ExperienceLoadHistorySize,
+		TEXT("Number of experience load timelines kept for RPG.DumpExperienceLoads."),
+		ECVF_Default);
+};
+
+namespace RPGExperienceLoadProfiler
+{
+	static TArray<FRPGExperienceLoadSummary> History;
+
+	static FString GetPluginDisplayName(const FString& PluginURL)
+	{
+		// file:../../Plugins/GameFeatures/Name/Name.uplugin, possibly followed by options
+		FString PluginPath = PluginURL;
+		int32 OptionsIndex = INDEX_NONE;
+		if (PluginPath.FindChar(TEXT('?'), OptionsIndex))
+		{
+			PluginPath.LeftInline(OptionsIndex);
+		}
+		return FPaths::GetBaseFilename(PluginPath);
+	}
+
+	static FString FormatTiming(const FRPGExperienceLoadTiming& Timing)
+	{
+		if (!Timing.HasCompleted())
+		{
+			return TEXT("(incomplete)");
+		}
+
+		return FString::Printf(TEXT("%8.1f ms  @%8.1f ms%s"), Timing.Duration * 1000.0, Timing.StartOffset * 1000.0,
+			Timing.bSucceeded ? TEXT("") : *FString::Printf(TEXT("  FAILED %s"), *Timing.Error));
+	}
+
+	static void WriteSortedTimings(const TCHAR* Title, const TArray<FRPGExperienceLoadTiming>& Timings, FOutputDevice& Ar)
+	{
+		if (Timings.Num() == 0)
+		{
+			return;
+		}
+
+		TArray<const FRPGExperienceLoadTiming*> Sorted;
+		for (const FRPGExperienceLoadTiming& Timing : Timings)
+		{
+			Sorted.Add(&Timing);
+		}
+		Sorted.Sort([](const FRPGExperienceLoadTiming& A, const FRPGExperienceLoadTiming& B) { return A.Duration > B.Duration; });
+
+		Ar.Logf(TEXT("  %s (%d, slowest first):"), Title, Timings.Num());
+		for (const FRPGExperienceLoadTiming* Timing : Sorted)
+		{
+			Ar.Logf(TEXT("    %s  %s"), *FormatTiming(*Timing), *Timing->Name);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpExperienceLoads(
+	TEXT("RPG.DumpExperienceLoads"),
+	TEXT("Usage: RPG.DumpExperienceLoads [N]. Prints the phase, plugin and action timeline of the last N experience loads (default 1)."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 NumLoads = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 1;
+		FRPGExperienceLoadProfiler::DumpHistory(NumLoads, Ar);
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// FRPGExperienceLoadSummary
+
+const TCHAR* LexToString(ERPGExperienceLoadPhase Phase)
+{
+	switch (Phase)
+	{
+	case ERPGExperienceLoadPhase::Definition:	return TEXT("Definition");
+	case ERPGExperienceLoadPhase::Bundles:		return TEXT("Bundles");
+	case ERPGExperienceLoadPhase::GameFeatures:	return TEXT("GameFeatures");
+	case ERPGExperienceLoadPhase::ChaosDelay:	return TEXT("ChaosDelay");
+	case ERPGExperienceLoadPhase::ActionPreload:	return TEXT("ActionPreload");
+	case ERPGExperienceLoadPhase::Actions:		return TEXT("Actions");
+	case ERPGExperienceLoadPhase::Callbacks:	return TEXT("Callbacks");
+	default:									return TEXT("Unknown");
+	}
+}
+
+const FRPGExperienceLoadTiming* FRPGExperienceLoadSummary::FindSlowest(const TArray<FRPGExperienceLoadTiming>& Timings)
+{
+	const FRPGExperienceLoadTiming* Slowest = nullptr;
+	for (const FRPGExperienceLoadTiming& Timing : Timings)
+	{
+		if (!Slowest || (Timing.Duration > Slowest->Duration))
+		{
+			Slowest = &Timing;
+		}
+	}
+	return Slowest;
+}
+
+//////////////////////////////////////////////////////////////////////
+// FRPGExperienceLoadProfiler
+
+FOnRPGExperienceLoadProfiled FRPGExperienceLoadProfiler::OnExperienceLoadProfiled;
+
+void FRPGExperienceLoadProfiler::Begin(const FPrimaryAssetId& ExperienceId, const UWorld* World)
+{
+	if (bActive)
+	{
+		Abort();
+	}
+
+	Current = FRPGExperienceLoadSummary();
+	Current.ExperienceId = ExperienceId;
+	Current.WorldName = GetNameSafe(World);
+	Current.Time = FDateTime::Now();
+
+	if (World)
+	{
+		switch (World->GetNetMode())
+		{
+		case NM_Standalone:			Current.NetMode = TEXT("Standalone"); break;
+		case NM_DedicatedServer:	Current.NetMode = TEXT("DedicatedServer"); break;
+		case NM_ListenServer:		Current.NetMode = TEXT("ListenServer"); break;
+		case NM_Client:				Current.NetMode = TEXT("Client"); break;
+		default:					break;
+		}
+	}
+
+	for (int32 PhaseIndex = 0; PhaseIndex < (int32)ERPGExperienceLoadPhase::MAX; ++PhaseIndex)
+	{
+		Current.Phases[PhaseIndex].Name = LexToString((ERPGExperienceLoadPhase)PhaseIndex);
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	TransitionStartTime = 0.0;
+	bActive = true;
+
+	TRACE_BOOKMARK(TEXT("Experience load started: %s"), *ExperienceId.ToString());
+}
+
+void FRPGExperienceLoadProfiler::SetTransitionInfo(bool bWarm, double InTransitionStartTime)
+{
+	Current.bWarm = bWarm;
+	TransitionStartTime = InTransitionStartTime;
+}
+
+void FRPGExperienceLoadProfiler::BeginPhase(ERPGExperienceLoadPhase Phase)
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	FRPGExperienceLoadTiming& Timing = Current.Phases[(int32)Phase];
+	Timing.StartOffset = GetOffset();
+	Timing.Duration = -1.0;
+
+	TRACE_BEGIN_REGION(*GetRegionName(TEXT("Phase"), Timing.Name));
+}
+
+void FRPGExperienceLoadProfiler::EndPhase(ERPGExperienceLoadPhase Phase)
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	FRPGExperienceLoadTiming& Timing = Current.Phases[(int32)Phase];
+	if (!Timing.HasStarted() || Timing.HasCompleted())
+	{
+		return;
+	}
+
+	Timing.Duration = GetOffset() - Timing.StartOffset;
+
+	TRACE_END_REGION(*GetRegionName(TEXT("Phase"), Timing.Name));
+}
+
+void FRPGExperienceLoadProfiler::BeginPlugin(const FString& PluginURL)
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	FRPGExperienceLoadTiming& Timing = Current.Plugins.AddDefaulted_GetRef();
+	Timing.Name = RPGExperienceLoadProfiler::GetPluginDisplayName(PluginURL);
+	Timing.StartOffset = GetOffset();
+
+	TRACE_BEGIN_REGION(*GetRegionName(TEXT("Plugin"), Timing.Name));
+}
+
+void FRPGExperienceLoadProfiler::EndPlugin(const FString& PluginURL, bool bSucceeded, const FString& Error)
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	const FString PluginName = RPGExperienceLoadProfiler::GetPluginDisplayName(PluginURL);
+	if (FRPGExperienceLoadTiming* Timing = Current.Plugins.FindByPredicate([&PluginName](const FRPGExperienceLoadTiming& Entry) { return !Entry.HasCompleted() && (Entry.Name == PluginName); }))
+	{
+		Timing->Duration = GetOffset() - Timing->StartOffset;
+		Timing->bSucceeded = bSucceeded;
+		Timing->Error = Error;
+
+		TRACE_END_REGION(*GetRegionName(TEXT("Plugin"), Timing->Name));
+	}
+}
+
+void FRPGExperienceLoadProfiler::AddAction(const FString& ActionName, double Duration)
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	FRPGExperienceLoadTiming& Timing = Current.Actions.AddDefaulted_GetRef();
+	Timing.Name = ActionName;
+	Timing.Duration = Duration;
+	Timing.StartOffset = GetOffset() - Duration;
+}
+
+void FRPGExperienceLoadProfiler::Finish()
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	Current.TotalSeconds = GetOffset();
+	Current.TransitionSeconds = (TransitionStartTime > 0.0) ? (FPlatformTime::Seconds() - TransitionStartTime) : -1.0;
+	bActive = false;
+
+	TRACE_BOOKMARK(TEXT("Experience load finished: %s"), *Current.ExperienceId.ToString());
+
+	const FRPGExperienceLoadTiming* SlowestPlugin = FRPGExperienceLoadSummary::FindSlowest(Current.Plugins);
+	const FRPGExperienceLoadTiming* SlowestAction = FRPGExperienceLoadSummary::FindSlowest(Current.Actions);
+	UE_LOG(LogRPGExperience, Log, TEXT("EXPERIENCE: %s loaded %s in %.1f ms (slowest plugin: %s %.1f ms, slowest action: %s %.1f ms). RPG.DumpExperienceLoads for the timeline."),
+		*Current.ExperienceId.ToString(), Current.bWarm ? TEXT("warm") : TEXT("cold"), Current.TotalSeconds * 1000.0,
+		SlowestPlugin ? *SlowestPlugin->Name : TEXT("none"), SlowestPlugin ? SlowestPlugin->Duration * 1000.0 : 0.0,
+		SlowestAction ? *SlowestAction->Name : TEXT("none"), SlowestAction ? SlowestAction->Duration * 1000.0 : 0.0);
+
+	TArray<FRPGExperienceLoadSummary>& History = RPGExperienceLoadProfiler::History;
+	History.Add(Current);
+	const int32 NumToRemove = History.Num() - FMath::Max(1, RPGConsoleVariables::ExperienceLoadHistorySize);
+	if (NumToRemove > 0)
+	{
+		History.RemoveAt(0, NumToRemove);
+	}
+
+	OnExperienceLoadProfiled.Broadcast(History.Last());
+}
+
+void FRPGExperienceLoadProfiler::Abort()
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	// Close the regions still open so the trace stays balanced
+	for (const FRPGExperienceLoadTiming& Timing : Current.Phases)
+	{
+		if (Timing.HasStarted() && !Timing.HasCompleted())
+		{
+			TRACE_END_REGION(*GetRegionName(TEXT("Phase"), Timing.Name));
+		}
+	}
+
+	for (const FRPGExperienceLoadTiming& Timing : Current.Plugins)
+	{
+		if (!Timing.HasCompleted())
+		{
+			TRACE_END_REGION(*GetRegionName(TEXT("Plugin"), Timing.Name));
+		}
+	}
+
+	UE_LOG(LogRPGExperience, Log, TEXT("EXPERIENCE: Load of %s aborted after %.1f ms"), *Current.ExperienceId.ToString(), GetOffset() * 1000.0);
+	bActive = false;
+}
+
+void FRPGExperienceLoadProfiler::WriteSummary(const FRPGExperienceLoadSummary& Summary, FOutputDevice& Ar)
+{
+	using namespace RPGExperienceLoadProfiler;
+
+	Ar.Logf(TEXT("========== Experience %s: %.1f ms %s (%s, %s, %s) =========="),
+		*Summary.ExperienceId.ToString(), Summary.TotalSeconds * 1000.0, Summary.bWarm ? TEXT("warm") : TEXT("cold"), *Summary.WorldName, *Summary.NetMode, *Summary.Time.ToString());
+
+	if (Summary.TransitionSeconds >= 0.0)
+	{
+		Ar.Logf(TEXT("  Transition from the previous experience: %.1f ms"), Summary.TransitionSeconds * 1000.0);
+	}
+
+	Ar.Logf(TEXT("  Phases:"));
+	for (const FRPGExperienceLoadTiming& Timing : Summary.Phases)
+	{
+		if (Timing.HasCompleted())
+		{
+			Ar.Logf(TEXT("    %s  %s"), *FormatTiming(Timing), *Timing.Name);
+		}
+	}
+
+	WriteSortedTimings(TEXT("Game feature plugins"), Summary.Plugins, Ar);
+	WriteSortedTimings(TEXT("Actions"), Summary.Actions, Ar);
+}
+
+void FRPGExperienceLoadProfiler::DumpHistory(int32 NumLoads, FOutputDevice& Ar)
+{
+	const TArray<FRPGExperienceLoadSummary>& History = RPGExperienceLoadProfiler::History;
+	if (History.Num() == 0)
+	{
+		Ar.Logf(TEXT("No experience load recorded yet."));
+		return;
+	}
+
+	const int32 FirstIndex = FMath::Max(0, History.Num() - FMath::Max(1, NumLoads));
+	for (int32 Index = History.Num() - 1; Index >= FirstIndex; --Index)
+	{
+		WriteSummary(History[Index], Ar);
+	}
+
+	// Cold vs warm over the whole history, this is what preloading is judged by
+	double TransitionSeconds[2] = { 0.0, 0.0 };
+	int32 NumTransitions[2] = { 0, 0 };
+	for (const FRPGExperienceLoadSummary& Summary : History)
+	{
+		if (Summary.TransitionSeconds >= 0.0)
+		{
+			TransitionSeconds[Summary.bWarm ? 1 : 0] += Summary.TransitionSeconds;
+			++NumTransitions[Summary.bWarm ? 1 : 0];
+		}
+	}
+
+	Ar.Logf(TEXT("Transitions: cold %d, avg %.1f ms | warm %d, avg %.1f ms"),
+		NumTransitions[0], (NumTransitions[0] > 0) ? (TransitionSeconds[0] / NumTransitions[0]) * 1000.0 : 0.0,
+		NumTransitions[1], (NumTransitions[1] > 0) ? (TransitionSeconds[1] / NumTransitions[1]) * 1000.0 : 0.0);
+}
+
+const TArray<FRPGExperienceLoadSummary>& FRPGExperienceLoadProfiler::GetHistory()
+{
+	return RPGExperienceLoadProfiler::History;
+}
+
+double FRPGExperienceLoadProfiler::GetOffset() const
+{
+	return FPlatformTime::Seconds() - StartTime;
+}
+
+FString FRPGExperienceLoadProfiler::GetRegionName(const TCHAR* Category, const FString& Name) const
+{
+	return FString::Printf(TEXT("Experience %s: %s"), Category, *Name);
+}
@@ -1,6 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameMode/RPGExperienceManager.h"
+#include "GameFeaturesSubsystemSettings.h"
+#include "System/RPGAssetManager.h"
 
 TMap<FString, int32> URPGExperienceManager::ActivatedPluginCounts;
 
@@ -24,3 +26,22 @@ bool URPGExperienceManager::RequestToDeactivatePlugin(const FString& PluginURL)
 
 	return false;
 }
+
+TArray<FName> URPGExperienceManager::GetBundlesToLoad(ENetMode NetMode)
+{
+	TArray<FName> BundlesToLoad;
+	BundlesToLoad.Add(FRPGBundles::Equipped);
+
+	const bool bLoadClient = GIsEditor || (NetMode != NM_DedicatedServer);
+	const bool bLoadServer = GIsEditor || (NetMode != NM_Client);
+	if (bLoadClient)
+	{
+		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
+	}
+	if (bLoadServer)
+	{
+		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+	}
+
+	return BundlesToLoad;
+}
@@ -1,16 +1,19 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameMode/RPGExperienceManagerComponent.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/World.h"
 #include "Net/UnrealNetwork.h"
 #include "GameMode/RPGExperienceDefinition.h"
 #include "GameMode/RPGExperienceActionSet.h"
 #include "GameMode/RPGExperienceManager.h"
+#include "GameMode/RPGExperiencePreloadSubsystem.h"
 #include "GameFeaturesSubsystem.h"
 #include "System/RPGAssetManager.h"
 #include "GameFeatureAction.h"
-#include "GameFeaturesSubsystemSettings.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "TimerManager.h"
+#include "UObject/UnrealType.h"
 #include "System/RPGLogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGExperienceManagerComponent)
@@ -31,6 +34,13 @@ namespace RPGConsoleVariables
 		TEXT("A random amount of time between 0 and this value (in seconds) will be added as a delay of load completion of the experience"),
 		ECVF_Default);
 
+	static bool bPreloadExperienceActions = true;
+	static FAutoConsoleVariableRef CVarPreloadExperienceActions(
+		TEXT("rpg.experience.PreloadActions"),
+		bPreloadExperienceActions,
+		TEXT("Should the soft references of all experience actions be loaded in one batch before any of them is activated?"),
+		ECVF_Default);
+
 	float GetExperienceLoadDelayDuration()
 	{
 		return FMath::Max(0.0f, ExperienceLoadRandomDelayMin + FMath::FRand() * ExperienceLoadRandomDelayRange);
@@ -47,11 +57,25 @@ void URPGExperienceManagerComponent::SetCurrentExperience(FPrimaryAssetId Experi
 {
 	URPGAssetManager& AssetManager = URPGAssetManager::Get();
 	FSoftObjectPath AssetPath = AssetManager.GetPrimaryAssetPath(ExperienceId);
+
+	URPGExperiencePreloadSubsystem* PreloadSubsystem = URPGExperiencePreloadSubsystem::Get(this);
+
+	LoadProfiler.Begin(ExperienceId, GetWorld());
+	if (PreloadSubsystem)
+	{
+		LoadProfiler.SetTransitionInfo(PreloadSubsystem->IsWarm(ExperienceId), PreloadSubsystem->GetTransitionStartTime());
+	}
+	LoadProfiler.BeginPhase(ERPGExperienceLoadPhase::Definition);
 	
 	const URPGExperienceDefinition* Experience = nullptr;
 
+	// Announced and already resident, no need to go through TryLoad
+	if (const URPGExperienceDefinition* PreloadedExperience = PreloadSubsystem ? PreloadSubsystem->FindPreloadedExperience(ExperienceId) : nullptr)
+	{
+		Experience = PreloadedExperience;
+	}
 	// Try loading as a Data Asset instance first
-	if (URPGExperienceDefinition* ExperienceAsset = Cast<URPGExperienceDefinition>(AssetPath.TryLoad()))
+	else if (URPGExperienceDefinition* ExperienceAsset = Cast<URPGExperienceDefinition>(AssetPath.TryLoad()))
 	{
 		Experience = ExperienceAsset;
 	}
@@ -61,9 +85,12 @@ void URPGExperienceManagerComponent::SetCurrentExperience(FPrimaryAssetId Experi
 		Experience = GetDefault<URPGExperienceDefinition>(AssetClass);
 	}
 
+	LoadProfiler.EndPhase(ERPGExperienceLoadPhase::Definition);
+
 	if (Experience == nullptr)
 	{
 		UE_LOG(LogRPGExperience, Error, TEXT("EXPERIENCE: Failed to load Experience definition %s from path %s. Check your Asset Manager settings and ensure the asset exists."), *ExperienceId.ToString(), *AssetPath.ToString());
+		LoadProfiler.Abort();
 		return;
 	}
 	
@@ -135,6 +162,17 @@ void URPGExperienceManagerComponent::StartExperienceLoad()
 
 	LoadState = ERPGExperienceLoadState::Loading;
 
+	// Clients start here, the definition came in replicated
+	if (!LoadProfiler.IsActive())
+	{
+		LoadProfiler.Begin(CurrentExperience->GetPrimaryAssetId(), GetWorld());
+		if (const URPGExperiencePreloadSubsystem* PreloadSubsystem = URPGExperiencePreloadSubsystem::Get(this))
+		{
+			LoadProfiler.SetTransitionInfo(PreloadSubsystem->IsWarm(CurrentExperience->GetPrimaryAssetId()), PreloadSubsystem->GetTransitionStartTime());
+		}
+	}
+	LoadProfiler.BeginPhase(ERPGExperienceLoadPhase::Bundles);
+
 	URPGAssetManager& AssetManager = URPGAssetManager::Get();
 
 	TSet<FPrimaryAssetId> BundleAssetList;
@@ -149,20 +187,7 @@ void URPGExperienceManagerComponent::StartExperienceLoad()
 		}
 	}
 
-	TArray<FName> BundlesToLoad;
-	BundlesToLoad.Add(FRPGBundles::Equipped);
-
-	const ENetMode OwnerNetMode = GetOwner()->GetNetMode();
-	const bool bLoadClient = GIsEditor || (OwnerNetMode != NM_DedicatedServer);
-	const bool bLoadServer = GIsEditor || (OwnerNetMode != NM_Client);
-	if (bLoadClient)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
-	}
-	if (bLoadServer)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
-	}
+	const TArray<FName> BundlesToLoad = URPGExperienceManager::GetBundlesToLoad(GetOwner()->GetNetMode());
 
 	TSharedPtr<FStreamableHandle> BundleLoadHandle = nullptr;
 	if (BundleAssetList.Num() > 0)
@@ -210,6 +235,8 @@ void URPGExperienceManagerComponent::OnExperienceLoadComplete()
 	UE_LOG(LogRPGExperience, Log, TEXT("EXPERIENCE: OnExperienceLoadComplete(CurrentExperience = %s)"),
 		*CurrentExperience->GetPrimaryAssetId().ToString());
 
+	LoadProfiler.EndPhase(ERPGExperienceLoadPhase::Bundles);
+
 	GameFeaturePluginURLs.Reset();
 
 	auto CollectGameFeaturePluginURLs = [This=this](const UPrimaryDataAsset* Context, const TArray<FString>& FeaturePluginList)
@@ -237,14 +264,25 @@ void URPGExperienceManagerComponent::OnExperienceLoadComplete()
 		}
 	}
 
+	// Plugins kept active for a preloaded experience that turned out not to be this one go now
+	if (URPGExperiencePreloadSubsystem* PreloadSubsystem = URPGExperiencePreloadSubsystem::Get(this))
+	{
+		PreloadSubsystem->ReleaseHeldPlugins(GameFeaturePluginURLs);
+	}
+
 	NumGameFeaturePluginsLoading = GameFeaturePluginURLs.Num();
 	if (NumGameFeaturePluginsLoading > 0)
 	{
 		LoadState = ERPGExperienceLoadState::LoadingGameFeatures;
-		for (const FString& PluginURL : GameFeaturePluginURLs)
+		LoadProfiler.BeginPhase(ERPGExperienceLoadPhase::GameFeatures);
+
+		// Copied, a plugin that is already active completes synchronously
+		const TArray<FString> PluginURLs = GameFeaturePluginURLs;
+		for (const FString& PluginURL : PluginURLs)
 		{
 			URPGExperienceManager::NotifyOfPluginActivation(PluginURL);
-			UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoadComplete));
+			LoadProfiler.BeginPlugin(PluginURL);
+			UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoadComplete, PluginURL));
 		}
 	}
 	else
@@ -253,12 +291,15 @@ void URPGExperienceManagerComponent::OnExperienceLoadComplete()
 	}
 }
 
-void URPGExperienceManagerComponent::OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result)
+void URPGExperienceManagerComponent::OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result, FString PluginURL)
 {
 	NumGameFeaturePluginsLoading--;
 
+	LoadProfiler.EndPlugin(PluginURL, !Result.HasError(), Result.HasError() ? Result.GetError() : FString());
+
 	if (NumGameFeaturePluginsLoading == 0)
 	{
+		LoadProfiler.EndPhase(ERPGExperienceLoadPhase::GameFeatures);
 		OnExperienceFullLoadCompleted();
 	}
 }
@@ -274,43 +315,172 @@ void URPGExperienceManagerComponent::OnExperienceFullLoadCompleted()
 		{
 			FTimerHandle DummyHandle;
 			LoadState = ERPGExperienceLoadState::LoadingChaosTestingDelay;
+			LoadProfiler.BeginPhase(ERPGExperienceLoadPhase::ChaosDelay);
 			GetWorld()->GetTimerManager().SetTimer(DummyHandle, this, &ThisClass::OnExperienceFullLoadCompleted, DelaySecs, /*bLooping=*/ false);
 			return;
 		}
 	}
-
-	LoadState = ERPGExperienceLoadState::ExecutingActions;
-
-	FGameFeatureActivatingContext Context;
-	const FWorldContext* ExistingWorldContext = GEngine->GetWorldContextFromWorld(GetWorld());
-	if (ExistingWorldContext)
+	else
 	{
-		Context.SetRequiredWorldContextHandle(ExistingWorldContext->ContextHandle);
+		LoadProfiler.EndPhase(ERPGExperienceLoadPhase::ChaosDelay);
 	}
 
-	auto ActivateListOfActions = [&Context](const TArray<UGameFeatureAction*>& ActionList)
+	LoadState = ERPGExperienceLoadState::PreloadingActions;
+	StartActionPreload();
+}
+
+void URPGExperienceManagerComponent::GatherExperienceActions(TArray<UGameFeatureAction*>& OutActions) const
+{
+	auto AddActions = [&OutActions](const TArray<TObjectPtr<UGameFeatureAction>>& ActionList)
 	{
 		for (UGameFeatureAction* Action : ActionList)
 		{
 			if (Action != nullptr)
 			{
-				Action->OnGameFeatureRegistering();
-				Action->OnGameFeatureLoading();
-				Action->OnGameFeatureActivating(Context);
+				OutActions.Add(Action);
 			}
 		}
 	};
 
-	ActivateListOfActions(CurrentExperience->Actions);
+	AddActions(CurrentExperience->Actions);
 	for (const TObjectPtr<URPGExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
 	{
 		if (ActionSet != nullptr)
 		{
-			ActivateListOfActions(ActionSet->Actions);
+			AddActions(ActionSet->Actions);
 		}
 	}
+}
+
+void URPGExperienceManagerComponent::StartActionPreload()
+{
+	check(LoadState == ERPGExperienceLoadState::PreloadingActions);
+
+	if (RPGConsoleVariables::bPreloadExperienceActions)
+	{
+		TArray<UGameFeatureAction*> Actions;
+		GatherExperienceActions(Actions);
+
+		// The actions report their Client/Server assets in the bundle data of the experience and its action sets,
+		// keep the sweep from loading what the bundles of this net mode leave out (e.g. widgets on a dedicated server)
+		const TArray<FName> BundlesToLoad = URPGExperienceManager::GetBundlesToLoad(GetOwner()->GetNetMode());
+
+		TArray<FPrimaryAssetId> BundleScopes;
+		BundleScopes.Add(CurrentExperience->GetPrimaryAssetId());
+		for (const TObjectPtr<URPGExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
+		{
+			if (ActionSet != nullptr)
+			{
+				BundleScopes.Add(ActionSet->GetPrimaryAssetId());
+			}
+		}
+
+		TSet<FTopLevelAssetPath> BundledAssets;
+		TSet<FTopLevelAssetPath> ExcludedBundleAssets;
+		for (const FPrimaryAssetId& BundleScope : BundleScopes)
+		{
+			TArray<FAssetBundleEntry> BundleEntries;
+			URPGAssetManager::Get().GetAssetBundleEntries(BundleScope, BundleEntries);
+			for (const FAssetBundleEntry& BundleEntry : BundleEntries)
+			{
+				(BundlesToLoad.Contains(BundleEntry.BundleName) ? BundledAssets : ExcludedBundleAssets).Append(BundleEntry.AssetPaths);
+			}
+		}
+
+		// Everything any action references softly, so their own loads find it resident
+		TSet<FSoftObjectPath> AssetsToLoad;
+		for (const UGameFeatureAction* Action : Actions)
+		{
+			for (TPropertyValueIterator<FSoftObjectProperty> It(Action->GetClass(), Action); It; ++It)
+			{
+				const FSoftObjectPath AssetPath = It.Key()->GetPropertyValue(It.Value()).ToSoftObjectPath();
+				if (!AssetPath.IsValid() || (AssetPath.ResolveObject() != nullptr))
+				{
+					continue;
+				}
+
+				const FTopLevelAssetPath TopLevelPath = AssetPath.GetAssetPath();
+				if (ExcludedBundleAssets.Contains(TopLevelPath) && !BundledAssets.Contains(TopLevelPath))
+				{
+					continue;
+				}
+
+				AssetsToLoad.Add(AssetPath);
+			}
+		}
+
+		if (AssetsToLoad.Num() > 0)
+		{
+			UE_LOG(LogRPGExperience, Log, TEXT("EXPERIENCE: Preloading %d assets for %d actions of %s"), AssetsToLoad.Num(), Actions.Num(), *CurrentExperience->GetPrimaryAssetId().ToString());
+
+			LoadProfiler.BeginPhase(ERPGExperienceLoadPhase::ActionPreload);
+			ActionPreloadHandle = URPGAssetManager::Get().GetStreamableManager().RequestAsyncLoad(AssetsToLoad.Array(),
+				FStreamableDelegate::CreateUObject(this, &ThisClass::ActivateExperienceActions), FStreamableManager::AsyncLoadHighPriority);
+
+			if (ActionPreloadHandle.IsValid() && !ActionPreloadHandle->HasLoadCompleted())
+			{
+				return;
+			}
+		}
+	}
+
+	ActivateExperienceActions();
+}
+
+void URPGExperienceManagerComponent::ActivateExperienceActions()
+{
+	// The preload callback and a synchronous completion can both get here
+	if (LoadState != ERPGExperienceLoadState::PreloadingActions)
+	{
+		return;
+	}
+
+	LoadProfiler.EndPhase(ERPGExperienceLoadPhase::ActionPreload);
+
+	LoadState = ERPGExperienceLoadState::ExecutingActions;
+	LoadProfiler.BeginPhase(ERPGExperienceLoadPhase::Actions);
+
+	FGameFeatureActivatingContext Context;
+	const FWorldContext* ExistingWorldContext = GEngine->GetWorldContextFromWorld(GetWorld());
+	if (ExistingWorldContext)
+	{
+		Context.SetRequiredWorldContextHandle(ExistingWorldContext->ContextHandle);
+	}
+
+	TArray<UGameFeatureAction*> Actions;
+	GatherExperienceActions(Actions);
+
+	// One batch per step, in the order the actions are listed
+	TArray<double> ActionDurations;
+	ActionDurations.SetNumZeroed(Actions.Num());
+	auto RunStep = [&Actions, &ActionDurations](TFunctionRef<void(UGameFeatureAction*)> Step)
+	{
+		for (int32 ActionIndex = 0; ActionIndex < Actions.Num(); ++ActionIndex)
+		{
+			const double StepStartTime = FPlatformTime::Seconds();
+			Step(Actions[ActionIndex]);
+			ActionDurations[ActionIndex] += FPlatformTime::Seconds() - StepStartTime;
+		}
+	};
+
+	RunStep([](UGameFeatureAction* Action) { Action->OnGameFeatureRegistering(); });
+	RunStep([](UGameFeatureAction* Action) { Action->OnGameFeatureLoading(); });
+	RunStep([&Context](UGameFeatureAction* Action)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*GetNameSafe(Action->GetClass()));
+		Action->OnGameFeatureActivating(Context);
+	});
+
+	for (int32 ActionIndex = 0; ActionIndex < Actions.Num(); ++ActionIndex)
+	{
+		const UGameFeatureAction* Action = Actions[ActionIndex];
+		LoadProfiler.AddAction(FString::Printf(TEXT("%s (%s)"), *GetNameSafe(Action->GetClass()), *GetNameSafe(Action->GetOuter())), ActionDurations[ActionIndex]);
+	}
+
+	LoadProfiler.EndPhase(ERPGExperienceLoadPhase::Actions);
 
 	LoadState = ERPGExperienceLoadState::Loaded;
+	LoadProfiler.BeginPhase(ERPGExperienceLoadPhase::Callbacks);
 
 	OnExperienceLoaded_HighPriority.Broadcast(CurrentExperience);
 	OnExperienceLoaded_HighPriority.Clear();
@@ -320,6 +490,16 @@ void URPGExperienceManagerComponent::OnExperienceFullLoadCompleted()
 
 	OnExperienceLoaded_LowPriority.Broadcast(CurrentExperience);
 	OnExperienceLoaded_LowPriority.Clear();
+
+	URPGAssetManager::Get().HandleExperienceLoaded(CurrentExperience);
+
+	if (URPGExperiencePreloadSubsystem* PreloadSubsystem = URPGExperiencePreloadSubsystem::Get(this))
+	{
+		PreloadSubsystem->NotifyExperienceLoaded(CurrentExperience->GetPrimaryAssetId());
+	}
+
+	LoadProfiler.EndPhase(ERPGExperienceLoadPhase::Callbacks);
+	LoadProfiler.Finish();
 }
 
 void URPGExperienceManagerComponent::OnActionDeactivationCompleted()
@@ -344,10 +524,37 @@ void URPGExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 {
 	Super::EndPlay(EndPlayReason);
 
+	LoadProfiler.Abort();
+
+	if (ActionPreloadHandle.IsValid())
+	{
+		if (ActionPreloadHandle->IsLoadingInProgress())
+		{
+			ActionPreloadHandle->CancelHandle();
+		}
+		else
+		{
+			ActionPreloadHandle->ReleaseHandle();
+		}
+		ActionPreloadHandle.Reset();
+	}
+
+	URPGExperiencePreloadSubsystem* PreloadSubsystem = URPGExperiencePreloadSubsystem::Get(this);
+	if (PreloadSubsystem)
+	{
+		PreloadSubsystem->NotifyExperienceEnded();
+	}
+
 	for (const FString& PluginURL : GameFeaturePluginURLs)
 	{
 		if (URPGExperienceManager::RequestToDeactivatePlugin(PluginURL))
 		{
+			// Shared with the preloaded next experience, skip the deactivate/reactivate round trip
+			if (PreloadSubsystem && PreloadSubsystem->HoldPluginForTransition(PluginURL))
+			{
+				continue;
+			}
+
 			UGameFeaturesSubsystem::Get().DeactivateGameFeaturePlugin(PluginURL);
 		}
 	}
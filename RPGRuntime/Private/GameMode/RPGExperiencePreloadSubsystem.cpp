@@ -0,0 +1,349 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameMode/RPGExperiencePreloadSubsystem.h"
+#include "GameMode/RPGExperienceActionSet.h"
+#include "GameMode/RPGExperienceDefinition.h"
+#include "GameMode/RPGExperienceManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "GameFeaturesSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "System/RPGAssetManager.h"
+#include "System/RPGLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGExperiencePreloadSubsystem)
+
+namespace RPGExperiencePreload
+{
+	// Experiences are either data assets or Blueprint classes whose CDO is the definition
+	static const URPGExperienceDefinition* ResolveDefinition(const UObject* Asset)
+	{
+		if (const URPGExperienceDefinition* Definition = Cast<URPGExperienceDefinition>(Asset))
+		{
+			return Definition;
+		}
+
+		if (const UClass* AssetClass = Cast<UClass>(Asset))
+		{
+			if (AssetClass->IsChildOf(URPGExperienceDefinition::StaticClass()))
+			{
+				return GetDefault<URPGExperienceDefinition>(AssetClass);
+			}
+		}
+
+		return nullptr;
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarPreloadExperience(
+	TEXT("RPG.PreloadExperience"),
+	TEXT("Usage: RPG.PreloadExperience <Type:Name>|None. Preloads the experience for the next transition, or cancels the preload."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		URPGExperiencePreloadSubsystem* PreloadSubsystem = URPGExperiencePreloadSubsystem::Get(World);
+		if (!PreloadSubsystem)
+		{
+			Ar.Logf(TEXT("No game instance to preload into."));
+			return;
+		}
+
+		const FPrimaryAssetId ExperienceId = (Args.Num() > 0) ? FPrimaryAssetId(Args[0]) : FPrimaryAssetId();
+		if (ExperienceId.IsValid())
+		{
+			PreloadSubsystem->PreloadExperience(ExperienceId);
+		}
+		else
+		{
+			PreloadSubsystem->CancelPreload();
+		}
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// URPGExperiencePreloadSubsystem
+
+URPGExperiencePreloadSubsystem* URPGExperiencePreloadSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr)
+	{
+		if (const UGameInstance* GameInstance = World->GetGameInstance())
+		{
+			return GameInstance->GetSubsystem<URPGExperiencePreloadSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void URPGExperiencePreloadSubsystem::Deinitialize()
+{
+	// The asset manager shares these handles, it releases them itself on shutdown
+	DefinitionHandle.Reset();
+	ActionSetsHandle.Reset();
+	HeldPluginURLs.Empty();
+
+	Super::Deinitialize();
+}
+
+void URPGExperiencePreloadSubsystem::PreloadExperience(FPrimaryAssetId ExperienceId)
+{
+	if (ExperienceId == PreloadedExperienceId)
+	{
+		return;
+	}
+
+	CancelPreload();
+
+	URPGAssetManager& AssetManager = URPGAssetManager::Get();
+	if (!AssetManager.GetPrimaryAssetPath(ExperienceId).IsValid())
+	{
+		UE_LOG(LogRPGExperience, Warning, TEXT("EXPERIENCE: Cannot preload unknown experience %s"), *ExperienceId.ToString());
+		return;
+	}
+
+	UE_LOG(LogRPGExperience, Log, TEXT("EXPERIENCE: Preloading %s for the next transition"), *ExperienceId.ToString());
+
+	PreloadedExperienceId = ExperienceId;
+	PreloadStartTime = FPlatformTime::Seconds();
+	++PreloadSerial;
+
+	if (!AssetManager.GetPrimaryAssetHandle(ExperienceId).IsValid())
+	{
+		OwnedAssetIds.Add(ExperienceId);
+	}
+
+	const UWorld* World = GetGameInstance()->GetWorld();
+	const TArray<FName> BundlesToLoad = URPGExperienceManager::GetBundlesToLoad(World ? World->GetNetMode() : NM_Standalone);
+
+	// Default priority, the running match's own loads go first
+	DefinitionHandle = AssetManager.LoadPrimaryAsset(ExperienceId, BundlesToLoad,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleDefinitionLoaded), FStreamableManager::DefaultAsyncLoadPriority);
+
+	if (!DefinitionHandle.IsValid() || DefinitionHandle->HasLoadCompleted())
+	{
+		HandleDefinitionLoaded();
+	}
+}
+
+void URPGExperiencePreloadSubsystem::CancelPreload()
+{
+	if (PreloadedExperienceId.IsValid())
+	{
+		UE_LOG(LogRPGExperience, Verbose, TEXT("EXPERIENCE: Dropping preload of %s"), *PreloadedExperienceId.ToString());
+	}
+
+	UnloadOwnedContent();
+	ResetPreloadState();
+}
+
+void URPGExperiencePreloadSubsystem::ResetPreloadState()
+{
+	// The asset manager keeps the same handles as the current state of the primary assets, never release them here
+	DefinitionHandle.Reset();
+	ActionSetsHandle.Reset();
+
+	PreloadedExperienceId = FPrimaryAssetId();
+	OwnedAssetIds.Empty();
+	PreloadPluginURLs.Empty();
+	OwnedPluginURLs.Empty();
+	NumPluginsLoading = 0;
+	bAssetsLoaded = false;
+	++PreloadSerial;
+}
+
+bool URPGExperiencePreloadSubsystem::IsPreloadComplete() const
+{
+	return PreloadedExperienceId.IsValid() && bAssetsLoaded && (NumPluginsLoading == 0);
+}
+
+const URPGExperienceDefinition* URPGExperiencePreloadSubsystem::FindPreloadedExperience(const FPrimaryAssetId& ExperienceId) const
+{
+	if (!ExperienceId.IsValid() || (ExperienceId != PreloadedExperienceId))
+	{
+		return nullptr;
+	}
+
+	return RPGExperiencePreload::ResolveDefinition(URPGAssetManager::Get().GetPrimaryAssetObject(ExperienceId));
+}
+
+void URPGExperiencePreloadSubsystem::HandleDefinitionLoaded()
+{
+	// Also called directly when the load completed synchronously
+	if (!PreloadedExperienceId.IsValid() || bAssetsLoaded || ActionSetsHandle.IsValid())
+	{
+		return;
+	}
+
+	URPGAssetManager& AssetManager = URPGAssetManager::Get();
+	const URPGExperienceDefinition* Experience = RPGExperiencePreload::ResolveDefinition(AssetManager.GetPrimaryAssetObject(PreloadedExperienceId));
+	if (!Experience)
+	{
+		UE_LOG(LogRPGExperience, Warning, TEXT("EXPERIENCE: Failed to preload experience definition %s"), *PreloadedExperienceId.ToString());
+		CancelPreload();
+		return;
+	}
+
+	TArray<FPrimaryAssetId> ActionSetIds;
+	for (const TObjectPtr<URPGExperienceActionSet>& ActionSet : Experience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			const FPrimaryAssetId ActionSetId = ActionSet->GetPrimaryAssetId();
+			ActionSetIds.Add(ActionSetId);
+
+			// Action sets shared with the running experience must survive a dropped preload
+			if (!AssetManager.GetPrimaryAssetHandle(ActionSetId).IsValid())
+			{
+				OwnedAssetIds.AddUnique(ActionSetId);
+			}
+		}
+	}
+
+	if (ActionSetIds.Num() > 0)
+	{
+		const UWorld* World = GetGameInstance()->GetWorld();
+		const TArray<FName> BundlesToLoad = URPGExperienceManager::GetBundlesToLoad(World ? World->GetNetMode() : NM_Standalone);
+
+		ActionSetsHandle = AssetManager.LoadPrimaryAssets(ActionSetIds, BundlesToLoad,
+			FStreamableDelegate::CreateUObject(this, &ThisClass::HandleActionSetsLoaded), FStreamableManager::DefaultAsyncLoadPriority);
+	}
+
+	if (!ActionSetsHandle.IsValid() || ActionSetsHandle->HasLoadCompleted())
+	{
+		HandleActionSetsLoaded();
+	}
+}
+
+void URPGExperiencePreloadSubsystem::HandleActionSetsLoaded()
+{
+	if (bAssetsLoaded)
+	{
+		return;
+	}
+
+	const URPGExperienceDefinition* Experience = FindPreloadedExperience(PreloadedExperienceId);
+	if (!Experience)
+	{
+		return;
+	}
+
+	bAssetsLoaded = true;
+
+	UGameFeaturesSubsystem& GameFeatures = UGameFeaturesSubsystem::Get();
+	auto CollectPluginURLs = [this, &GameFeatures](const TArray<FString>& FeaturePluginList)
+	{
+		for (const FString& PluginName : FeaturePluginList)
+		{
+			FString PluginURL;
+			if (GameFeatures.GetPluginURLByName(PluginName, /*out*/ PluginURL))
+			{
+				PreloadPluginURLs.AddUnique(PluginURL);
+			}
+		}
+	};
+
+	CollectPluginURLs(Experience->GameFeaturesToEnable);
+	for (const TObjectPtr<URPGExperienceActionSet>& ActionSet : Experience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			CollectPluginURLs(ActionSet->GameFeaturesToEnable);
+		}
+	}
+
+	// Loaded only, activating them would run their actions in the current match
+	NumPluginsLoading = PreloadPluginURLs.Num();
+	const TArray<FString> PluginURLs = PreloadPluginURLs;
+	for (const FString& PluginURL : PluginURLs)
+	{
+		if (!GameFeatures.IsGameFeaturePluginLoaded(PluginURL))
+		{
+			OwnedPluginURLs.Add(PluginURL);
+		}
+
+		GameFeatures.LoadGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::HandlePluginLoaded, PluginURL, PreloadSerial));
+	}
+
+	if (NumPluginsLoading == 0)
+	{
+		UE_LOG(LogRPGExperience, Log, TEXT("EXPERIENCE: Preload of %s complete in %.1f ms"), *PreloadedExperienceId.ToString(), (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+	}
+}
+
+void URPGExperiencePreloadSubsystem::HandlePluginLoaded(const UE::GameFeatures::FResult& Result, FString PluginURL, int32 Serial)
+{
+	if (Serial != PreloadSerial)
+	{
+		return;
+	}
+
+	if (Result.HasError())
+	{
+		UE_LOG(LogRPGExperience, Warning, TEXT("EXPERIENCE: Failed to preload game feature %s for %s: %s"), *PluginURL, *PreloadedExperienceId.ToString(), *Result.GetError());
+		PreloadPluginURLs.Remove(PluginURL);
+	}
+
+	--NumPluginsLoading;
+	if (NumPluginsLoading == 0)
+	{
+		UE_LOG(LogRPGExperience, Log, TEXT("EXPERIENCE: Preload of %s complete in %.1f ms"), *PreloadedExperienceId.ToString(), (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+	}
+}
+
+bool URPGExperiencePreloadSubsystem::HoldPluginForTransition(const FString& PluginURL)
+{
+	if (!PreloadedExperienceId.IsValid() || !PreloadPluginURLs.Contains(PluginURL))
+	{
+		return false;
+	}
+
+	UE_LOG(LogRPGExperience, Verbose, TEXT("EXPERIENCE: Keeping %s active for %s"), *PluginURL, *PreloadedExperienceId.ToString());
+	HeldPluginURLs.AddUnique(PluginURL);
+	return true;
+}
+
+void URPGExperiencePreloadSubsystem::ReleaseHeldPlugins(const TArray<FString>& PluginURLsInUse)
+{
+	for (const FString& PluginURL : HeldPluginURLs)
+	{
+		if (!PluginURLsInUse.Contains(PluginURL))
+		{
+			// The transition went somewhere else after all
+			UGameFeaturesSubsystem::Get().DeactivateGameFeaturePlugin(PluginURL);
+		}
+	}
+
+	HeldPluginURLs.Empty();
+}
+
+void URPGExperiencePreloadSubsystem::NotifyExperienceEnded()
+{
+	TransitionStartTime = FPlatformTime::Seconds();
+}
+
+void URPGExperiencePreloadSubsystem::NotifyExperienceLoaded(const FPrimaryAssetId& ExperienceId)
+{
+	if (ExperienceId.IsValid() && (ExperienceId == PreloadedExperienceId))
+	{
+		// Consumed: the assets and plugins now belong to the running experience, through the asset manager
+		ResetPreloadState();
+	}
+}
+
+void URPGExperiencePreloadSubsystem::UnloadOwnedContent()
+{
+	if (OwnedAssetIds.Num() > 0)
+	{
+		// Also cancels the loads still in flight and clears their bundle state, so a later cold load reloads them
+		URPGAssetManager::Get().UnloadPrimaryAssets(OwnedAssetIds);
+	}
+
+	UGameFeaturesSubsystem& GameFeatures = UGameFeaturesSubsystem::Get();
+	for (const FString& PluginURL : OwnedPluginURLs)
+	{
+		if (!HeldPluginURLs.Contains(PluginURL))
+		{
+			GameFeatures.UnloadGameFeaturePlugin(PluginURL);
+		}
+	}
+}
@@ -7,9 +7,17 @@
 #include "System/RPGLogChannels.h"
 #include "Player/RPGPlayerState.h"
 #include "Character/RPGPawnExtensionComponent.h"
+#include "AbilitySystemGlobals.h"
 #include "Components/GameFrameworkComponentManager.h"
+#include "Engine/AssetManager.h"
+#include "Engine/DataTable.h"
 #include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "System/RPGAssetManager.h"
+#include "System/RPGTimerWheelSubsystem.h"
+#include "TimerManager.h"
 
 #if WITH_EDITOR
 #include "Misc/DataValidation.h"
@@ -19,6 +27,16 @@
 
 #define LOCTEXT_NAMESPACE "RPGGameFeatures"
 
+namespace RPGConsoleVariables
+{
+	static float DeferredAbilityGrantBudgetMs = 1.0f;
+	static FAutoConsoleVariableRef CVarDeferredAbilityGrantBudgetMs(
+		TEXT("rpg.abilities.DeferredGrantBudgetMs"),
+		DeferredAbilityGrantBudgetMs,
+		TEXT("Milliseconds per frame spent granting abilities to actors that spawned before the AddAbilities preload finished. At least one actor is granted per frame."),
+		ECVF_Default);
+};
+
 //////////////////////////////////////////////////////////////////////
 // URPGGameFeatureAction_AddAbilities
 
@@ -33,6 +51,9 @@ void URPGGameFeatureAction_AddAbilities::OnGameFeatureActivating(FGameFeatureAct
 		ActiveData.ComponentRequests.Empty();
 	}
 
+	// Before Super, which registers the extension handlers and may already grant to existing actors
+	StartPreload(Context);
+
 	Super::OnGameFeatureActivating(Context);
 }
 
@@ -49,6 +70,20 @@ void URPGGameFeatureAction_AddAbilities::OnGameFeatureDeactivating(FGameFeatureD
 		}
 
 		ActiveData->ComponentRequests.Empty();
+		ActiveData->PendingGrants.Empty();
+
+		if (ActiveData->PreloadHandle.IsValid())
+		{
+			if (ActiveData->PreloadHandle->HasLoadCompleted())
+			{
+				ActiveData->PreloadHandle->ReleaseHandle();
+			}
+			else
+			{
+				ActiveData->PreloadHandle->CancelHandle();
+			}
+		}
+
 		ContextData.Remove(Context);
 	}
 }
@@ -107,24 +142,227 @@ void URPGGameFeatureAction_AddAbilities::AddToWorld(const FWorldContext& WorldCo
 	}
 }
 
+void URPGGameFeatureAction_AddAbilities::StartPreload(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	FPerContextData& ActiveData = ContextData.FindOrAdd(ChangeContext);
+	ActiveData.bPreloadComplete = false;
+	ActiveData.PreloadStartTime = FPlatformTime::Seconds();
+
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const FRPGGameFeatureAbilitiesEntry& Entry : AbilitiesList)
+	{
+		for (const FRPGAbilityGrant& Ability : Entry.GrantedAbilities)
+		{
+			if (!Ability.AbilityType.IsNull())
+			{
+				AssetsToLoad.AddUnique(Ability.AbilityType.ToSoftObjectPath());
+			}
+		}
+
+		for (const FRPGAttributeSetGrant& Attributes : Entry.GrantedAttributes)
+		{
+			if (!Attributes.AttributeSetType.IsNull())
+			{
+				AssetsToLoad.AddUnique(Attributes.AttributeSetType.ToSoftObjectPath());
+			}
+
+			if (!Attributes.InitializationData.IsNull())
+			{
+				AssetsToLoad.AddUnique(Attributes.InitializationData.ToSoftObjectPath());
+			}
+		}
+
+		for (const TSoftObjectPtr<const URPGAbilitySet>& SetPtr : Entry.GrantedAbilitySets)
+		{
+			if (!SetPtr.IsNull())
+			{
+				AssetsToLoad.AddUnique(SetPtr.ToSoftObjectPath());
+			}
+		}
+	}
+
+	if (AssetsToLoad.Num() > 0)
+	{
+		ActiveData.PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad,
+			FStreamableDelegate::CreateUObject(this, &ThisClass::HandlePreloadComplete, ChangeContext));
+	}
+
+	// Everything may already be resident, don't wait for a deferred callback in that case
+	FPerContextData* UpdatedData = ContextData.Find(ChangeContext);
+	if (UpdatedData && !UpdatedData->bPreloadComplete && (!UpdatedData->PreloadHandle.IsValid() || UpdatedData->PreloadHandle->HasLoadCompleted()))
+	{
+		HandlePreloadComplete(ChangeContext);
+	}
+}
+
+void URPGGameFeatureAction_AddAbilities::HandlePreloadComplete(FGameFeatureStateChangeContext ChangeContext)
+{
+	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
+	if (!ActiveData || ActiveData->bPreloadComplete)
+	{
+		return;
+	}
+
+	URPGAssetManager& AssetManager = URPGAssetManager::Get();
+	const auto Resolve = [&AssetManager](const auto& SoftPtr)
+	{
+		auto* Asset = SoftPtr.Get();
+		if (!Asset && !SoftPtr.IsNull())
+		{
+			UE_LOG(LogRPG, Warning, TEXT("URPGGameFeatureAction_AddAbilities: Failed to preload [%s]."), *SoftPtr.ToString());
+		}
+		AssetManager.TrackLoadedAsset(Asset, TEXT("AddAbilities"));
+		return Asset;
+	};
+
+	ActiveData->ResolvedEntries.Reset(AbilitiesList.Num());
+	for (const FRPGGameFeatureAbilitiesEntry& Entry : AbilitiesList)
+	{
+		FResolvedAbilitiesEntry& Resolved = ActiveData->ResolvedEntries.AddDefaulted_GetRef();
+
+		for (const FRPGAbilityGrant& Ability : Entry.GrantedAbilities)
+		{
+			if (UClass* AbilityClass = Resolve(Ability.AbilityType))
+			{
+				Resolved.Abilities.Emplace(AbilityClass, Ability.AbilityLevel);
+			}
+		}
+
+		for (const FRPGAttributeSetGrant& Attributes : Entry.GrantedAttributes)
+		{
+			if (UClass* SetClass = Resolve(Attributes.AttributeSetType))
+			{
+				Resolved.AttributeSets.Emplace(SetClass, Resolve(Attributes.InitializationData));
+			}
+		}
+
+		for (const TSoftObjectPtr<const URPGAbilitySet>& SetPtr : Entry.GrantedAbilitySets)
+		{
+			if (const URPGAbilitySet* Set = Resolve(SetPtr))
+			{
+				Resolved.AbilitySets.Add(Set);
+			}
+		}
+	}
+
+	ActiveData->bPreloadComplete = true;
+
+	UE_LOG(LogRPG, Log, TEXT("URPGGameFeatureAction_AddAbilities::HandlePreloadComplete: [%s] preloaded in %.2f ms, %d actors waiting for their grants."),
+		*GetPathNameSafe(this), (FPlatformTime::Seconds() - ActiveData->PreloadStartTime) * 1000.0, ActiveData->PendingGrants.Num());
+
+	FlushPendingGrants(ChangeContext);
+}
+
+void URPGGameFeatureAction_AddAbilities::FlushPendingGrants(FGameFeatureStateChangeContext ChangeContext)
+{
+	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
+	if (!ActiveData)
+	{
+		return;
+	}
+
+	// Budgeted so a whole wave that spawned during the load doesn't get granted in one frame
+	const double EndTime = FPlatformTime::Seconds() + (RPGConsoleVariables::DeferredAbilityGrantBudgetMs / 1000.0);
+	int32 NumGranted = 0;
+	while (ActiveData->PendingGrants.Num() > 0)
+	{
+		if ((NumGranted > 0) && (FPlatformTime::Seconds() > EndTime))
+		{
+			break;
+		}
+
+		const FPendingGrant PendingGrant = ActiveData->PendingGrants[0];
+		ActiveData->PendingGrants.RemoveAt(0);
+
+		if (AActor* Actor = PendingGrant.Actor.Get())
+		{
+			AddActorAbilities(Actor, PendingGrant.EntryIndex, *ActiveData);
+			++NumGranted;
+		}
+	}
+
+	// Only entries whose actor is gone are dropped, the next live actor gives the world to defer on
+	while ((ActiveData->PendingGrants.Num() > 0) && !ActiveData->PendingGrants[0].Actor.IsValid())
+	{
+		ActiveData->PendingGrants.RemoveAt(0);
+	}
+
+	if (ActiveData->PendingGrants.Num() == 0)
+	{
+		return;
+	}
+
+	const AActor* NextActor = ActiveData->PendingGrants[0].Actor.Get();
+	const FTimerDelegate FlushDelegate = FTimerDelegate::CreateUObject(this, &ThisClass::FlushPendingGrants, ChangeContext);
+	if (URPGTimerWheelSubsystem* TimerWheel = URPGTimerWheelSubsystem::Get(NextActor))
+	{
+		TimerWheel->SetTimerForNextTick(FlushDelegate);
+	}
+	else if (UWorld* World = NextActor->GetWorld())
+	{
+		World->GetTimerManager().SetTimerForNextTick(FlushDelegate);
+	}
+	else
+	{
+		// Nothing to defer on, grant the rest now rather than losing them
+		const TArray<FPendingGrant> RemainingGrants = MoveTemp(ActiveData->PendingGrants);
+		ActiveData->PendingGrants.Reset();
+		for (const FPendingGrant& PendingGrant : RemainingGrants)
+		{
+			if (AActor* Actor = PendingGrant.Actor.Get())
+			{
+				AddActorAbilities(Actor, PendingGrant.EntryIndex, *ActiveData);
+			}
+		}
+	}
+}
+
+URPGAbilitySystemComponent* URPGGameFeatureAction_AddAbilities::FindAbilitySystemComponent(AActor* Actor)
+{
+	// Goes through IAbilitySystemInterface first, the component search is only the fallback
+	if (URPGAbilitySystemComponent* RPGASC = Cast<URPGAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor)))
+	{
+		return RPGASC;
+	}
+
+	if (URPGPawnExtensionComponent* PawnExtComp = URPGPawnExtensionComponent::FindPawnExtensionComponent(Actor))
+	{
+		return PawnExtComp->GetRPGAbilitySystemComponent();
+	}
+
+	return nullptr;
+}
+
 void URPGGameFeatureAction_AddAbilities::HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext)
 {
 	URPGGameFeatureAction_AddAbilities::FPerContextData* ActiveData = ContextData.Find(ChangeContext);
 	if (ActiveData && AbilitiesList.IsValidIndex(EntryIndex))
 	{
-		const FRPGGameFeatureAbilitiesEntry& Entry = AbilitiesList[EntryIndex];
 		if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved) || (EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved))
 		{
+			ActiveData->PendingGrants.RemoveAll([Actor](const FPendingGrant& PendingGrant) { return PendingGrant.Actor == Actor; });
 			RemoveActorAbilities(Actor, *ActiveData);
 		}
 		else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) || (EventName == ARPGPlayerState::NAME_RPGAbilityReady))
 		{
-			AddActorAbilities(Actor, Entry, *ActiveData);
+			if (ActiveData->bPreloadComplete && (ActiveData->PendingGrants.Num() == 0))
+			{
+				AddActorAbilities(Actor, EntryIndex, *ActiveData);
+			}
+			else if (Actor->HasAuthority())
+			{
+				// Still loading (or flushing the backlog), grant once it's our turn
+				const bool bAlreadyPending = ActiveData->PendingGrants.ContainsByPredicate([Actor, EntryIndex](const FPendingGrant& PendingGrant) { return (PendingGrant.Actor == Actor) && (PendingGrant.EntryIndex == EntryIndex); });
+				if (!bAlreadyPending)
+				{
+					ActiveData->PendingGrants.Add({ Actor, EntryIndex });
+				}
+			}
 		}
 	}
 }
 
-void URPGGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const FRPGGameFeatureAbilitiesEntry& AbilitiesEntry, FPerContextData& ActiveData)
+void URPGGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData)
 {
 	check(Actor);
 	if (!Actor->HasAuthority())
@@ -138,63 +376,45 @@ void URPGGameFeatureAction_AddAbilities::AddActorAbilities(AActor* Actor, const
 		return;
 	}
 
-	URPGAbilitySystemComponent* RPGASC = Actor->FindComponentByClass<URPGAbilitySystemComponent>();
-	if (!RPGASC)
+	if (!ActiveData.ResolvedEntries.IsValidIndex(EntryIndex))
 	{
-		if (URPGPawnExtensionComponent* PawnExtComp = Actor->FindComponentByClass<URPGPawnExtensionComponent>())
-		{
-			RPGASC = PawnExtComp->GetRPGAbilitySystemComponent();
-		}
+		return;
 	}
 
-	if (RPGASC)
+	if (URPGAbilitySystemComponent* RPGASC = FindAbilitySystemComponent(Actor))
 	{
 		UE_LOG(LogRPG, Log, TEXT("URPGGameFeatureAction_AddAbilities::AddActorAbilities: Granting abilities to %s"), *GetNameSafe(Actor));
+		const FResolvedAbilitiesEntry& AbilitiesEntry = ActiveData.ResolvedEntries[EntryIndex];
+
 		FActorExtensions AddedExtensions;
-		AddedExtensions.Abilities.Reserve(AbilitiesEntry.GrantedAbilities.Num());
-		AddedExtensions.Attributes.Reserve(AbilitiesEntry.GrantedAttributes.Num());
-		AddedExtensions.AbilitySetHandles.Reserve(AbilitiesEntry.GrantedAbilitySets.Num());
+		AddedExtensions.AbilitySystemComponent = RPGASC;
+		AddedExtensions.Abilities.Reserve(AbilitiesEntry.Abilities.Num());
+		AddedExtensions.Attributes.Reserve(AbilitiesEntry.AttributeSets.Num());
+		AddedExtensions.AbilitySetHandles.Reserve(AbilitiesEntry.AbilitySets.Num());
 
-		for (const FRPGAbilityGrant& Ability : AbilitiesEntry.GrantedAbilities)
+		for (const TPair<TSubclassOf<URPGGameplayAbility>, int32>& Ability : AbilitiesEntry.Abilities)
 		{
-			if (!Ability.AbilityType.IsNull())
-			{
-				FGameplayAbilitySpec NewAbilitySpec(Ability.AbilityType.LoadSynchronous(), Ability.AbilityLevel);
-				FGameplayAbilitySpecHandle AbilityHandle = RPGASC->GiveAbility(NewAbilitySpec);
+			FGameplayAbilitySpec NewAbilitySpec(Ability.Key, Ability.Value);
+			FGameplayAbilitySpecHandle AbilityHandle = RPGASC->GiveAbility(NewAbilitySpec);
 
-				AddedExtensions.Abilities.Add(AbilityHandle);
-			}
+			AddedExtensions.Abilities.Add(AbilityHandle);
 		}
 
-		for (const FRPGAttributeSetGrant& Attributes : AbilitiesEntry.GrantedAttributes)
+		for (const TPair<TSubclassOf<UAttributeSet>, UDataTable*>& Attributes : AbilitiesEntry.AttributeSets)
 		{
-			if (!Attributes.AttributeSetType.IsNull())
+			UAttributeSet* NewSet = NewObject<UAttributeSet>(RPGASC->GetOwner(), Attributes.Key);
+			if (Attributes.Value)
 			{
-				TSubclassOf<UAttributeSet> SetType = Attributes.AttributeSetType.LoadSynchronous();
-				if (SetType)
-				{
-					UAttributeSet* NewSet = NewObject<UAttributeSet>(RPGASC->GetOwner(), SetType);
-					if (!Attributes.InitializationData.IsNull())
-					{
-						UDataTable* InitData = Attributes.InitializationData.LoadSynchronous();
-						if (InitData)
-						{
-							NewSet->InitFromMetaDataTable(InitData);
-						}
-					}
-
-					AddedExtensions.Attributes.Add(NewSet);
-					RPGASC->AddAttributeSetSubobject(NewSet);
-				}
+				NewSet->InitFromMetaDataTable(Attributes.Value);
 			}
+
+			AddedExtensions.Attributes.Add(NewSet);
+			RPGASC->AddAttributeSetSubobject(NewSet);
 		}
 
-		for (const TSoftObjectPtr<const URPGAbilitySet>& SetPtr : AbilitiesEntry.GrantedAbilitySets)
+		for (const URPGAbilitySet* Set : AbilitiesEntry.AbilitySets)
 		{
-			if (const URPGAbilitySet* Set = SetPtr.LoadSynchronous())
-			{
-				Set->GiveToAbilitySystem(RPGASC, &AddedExtensions.AbilitySetHandles.AddDefaulted_GetRef(), Actor);
-			}
+			Set->GiveToAbilitySystem(RPGASC, &AddedExtensions.AbilitySetHandles.AddDefaulted_GetRef(), Actor);
 		}
 
 		ActiveData.ActiveExtensions.Add(Actor, AddedExtensions);
@@ -205,16 +425,7 @@ void URPGGameFeatureAction_AddAbilities::RemoveActorAbilities(AActor* Actor, FPe
 {
 	if (URPGGameFeatureAction_AddAbilities::FActorExtensions* ActorExtensions = ActiveData.ActiveExtensions.Find(Actor))
 	{
-		URPGAbilitySystemComponent* RPGASC = Actor->FindComponentByClass<URPGAbilitySystemComponent>();
-		if (!RPGASC)
-		{
-			if (URPGPawnExtensionComponent* PawnExtComp = Actor->FindComponentByClass<URPGPawnExtensionComponent>())
-			{
-				RPGASC = PawnExtComp->GetRPGAbilitySystemComponent();
-			}
-		}
-
-		if (RPGASC)
+		if (URPGAbilitySystemComponent* RPGASC = ActorExtensions->AbilitySystemComponent.Get())
 		{
 			for (UAttributeSet* AttribSetInstance : ActorExtensions->Attributes)
 			{
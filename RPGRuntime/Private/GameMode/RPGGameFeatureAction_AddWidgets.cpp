@@ -7,11 +7,29 @@
 #include "CommonLocalPlayer.h"
 #include "CommonUIExtensions.h"
 #include "CommonActivatableWidget.h"
+#include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
+#include "System/RPGCosmeticPolicy.h"
 #include "System/RPGLogChannels.h"
+#include "UI/RPGUIManagerSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGGameFeatureAction_AddWidgets)
 
+namespace RPGConsoleVariables
+{
+	static bool bPrewarmWidgets = true;
+	static FAutoConsoleVariableRef CVarPrewarmWidgets(
+		TEXT("rpg.ui.PrewarmWidgets"),
+		bPrewarmWidgets,
+		TEXT("Should layouts flagged bPrewarm in Add Widgets actions be constructed while the experience is loading?"),
+		ECVF_Default);
+};
+
+//////////////////////////////////////////////////////////////////////
+// URPGGameFeatureAction_AddWidgets
+
 void URPGGameFeatureAction_AddWidgets::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
 {
 	Super::OnGameFeatureDeactivating(Context);
@@ -20,6 +38,7 @@ void URPGGameFeatureAction_AddWidgets::OnGameFeatureDeactivating(FGameFeatureDea
 	if (ActiveData)
 	{
 		Reset(*ActiveData);
+		ContextData.Remove(Context);
 	}
 }
 
@@ -29,7 +48,8 @@ void URPGGameFeatureAction_AddWidgets::AddToWorld(const FWorldContext& WorldCont
 	UGameInstance* GameInstance = WorldContext.OwningGameInstance;
 	FPerContextData& ActiveData = ContextData.FindOrAdd(ChangeContext);
 
-	if ((GameInstance != nullptr) && (World != nullptr) && World->IsGameWorld())
+	// HUD widgets are cosmetic, a dedicated server has no HUD to extend
+	if ((GameInstance != nullptr) && (World != nullptr) && World->IsGameWorld() && RPGCosmeticPolicy::ShouldRunCosmetics(World))
 	{
 		if (UGameFrameworkComponentManager* ComponentManager = UGameInstance::GetSubsystem<UGameFrameworkComponentManager>(GameInstance))
 		{
@@ -40,13 +60,160 @@ void URPGGameFeatureAction_AddWidgets::AddToWorld(const FWorldContext& WorldCont
 				UGameFrameworkComponentManager::FExtensionHandlerDelegate::CreateUObject(this, &ThisClass::HandleActorExtension, ChangeContext));
 			ActiveData.ComponentRequests.Add(ExtensionRequestHandle);
 		}
+
+		StartPreload(GameInstance, ChangeContext);
 	}
 }
 
 void URPGGameFeatureAction_AddWidgets::Reset(FPerContextData& ActiveData)
 {
 	ActiveData.ComponentRequests.Empty();
+
+	// Drops pending async pushes and root layout waits along with the widgets
+	TArray<FObjectKey> ActorKeys;
+	ActiveData.ActorData.GetKeys(ActorKeys);
+	for (const FObjectKey& ActorKey : ActorKeys)
+	{
+		if (AActor* Actor = Cast<AActor>(ActorKey.ResolveObjectPtr()))
+		{
+			RemoveWidgets(Actor, ActiveData);
+		}
+	}
 	ActiveData.ActorData.Empty();
+
+	for (const TWeakObjectPtr<URPGPrimaryGameLayout>& WeakLayout : ActiveData.PrewarmedLayouts)
+	{
+		if (URPGPrimaryGameLayout* RootLayout = WeakLayout.Get())
+		{
+			for (const FRPGHUDLayoutRequest& Entry : Layout)
+			{
+				RootLayout->ReleasePrewarmedWidget(Entry.LayoutClass.Get());
+			}
+		}
+	}
+	ActiveData.PrewarmedLayouts.Empty();
+	ActiveData.PendingPrewarms.Empty();
+
+	for (const TPair<TWeakObjectPtr<UGameInstance>, FDelegateHandle>& PrewarmHandle : ActiveData.PrewarmLayoutReadyHandles)
+	{
+		if (UGameInstance* GameInstance = PrewarmHandle.Key.Get())
+		{
+			if (URPGUIManagerSubsystem* UIManager = GameInstance->GetSubsystem<URPGUIManagerSubsystem>())
+			{
+				UIManager->UnregisterOnRootLayoutReady(PrewarmHandle.Value);
+			}
+		}
+	}
+	ActiveData.PrewarmLayoutReadyHandles.Empty();
+
+	if (ActiveData.PreloadHandle.IsValid())
+	{
+		if (ActiveData.PreloadHandle->HasLoadCompleted())
+		{
+			ActiveData.PreloadHandle->ReleaseHandle();
+		}
+		else
+		{
+			ActiveData.PreloadHandle->CancelHandle();
+		}
+		ActiveData.PreloadHandle.Reset();
+	}
+}
+
+void URPGGameFeatureAction_AddWidgets::StartPreload(UGameInstance* GameInstance, const FGameFeatureStateChangeContext& ChangeContext)
+{
+	FPerContextData& ActiveData = ContextData.FindOrAdd(ChangeContext);
+	ActiveData.PendingPrewarms.AddUnique(GameInstance);
+
+	if (!ActiveData.PreloadHandle.IsValid())
+	{
+		TArray<FSoftObjectPath> ClassesToLoad;
+		for (const FRPGHUDLayoutRequest& Entry : Layout)
+		{
+			if (!Entry.LayoutClass.IsNull())
+			{
+				ClassesToLoad.AddUnique(Entry.LayoutClass.ToSoftObjectPath());
+			}
+		}
+
+		if (ClassesToLoad.Num() > 0)
+		{
+			UE_LOG(LogRPG, Verbose, TEXT("URPGGameFeatureAction_AddWidgets::StartPreload: Requesting %d layout classes for [%s]"), ClassesToLoad.Num(), *GetPathNameSafe(this));
+
+			ActiveData.PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ClassesToLoad,
+				FStreamableDelegate::CreateUObject(this, &ThisClass::HandlePreloadComplete, FGameFeatureStateChangeContext(ChangeContext)));
+		}
+	}
+
+	// Later worlds of the same context join a load that may already be done
+	FPerContextData* UpdatedData = ContextData.Find(ChangeContext);
+	if (UpdatedData && (!UpdatedData->PreloadHandle.IsValid() || UpdatedData->PreloadHandle->HasLoadCompleted()))
+	{
+		HandlePreloadComplete(ChangeContext);
+	}
+}
+
+void URPGGameFeatureAction_AddWidgets::HandlePreloadComplete(FGameFeatureStateChangeContext ChangeContext)
+{
+	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
+	if (!ActiveData)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<UGameInstance>> GameInstances = MoveTemp(ActiveData->PendingPrewarms);
+	for (const TWeakObjectPtr<UGameInstance>& WeakGameInstance : GameInstances)
+	{
+		if (UGameInstance* GameInstance = WeakGameInstance.Get())
+		{
+			PrewarmWidgets(GameInstance, ChangeContext);
+		}
+	}
+}
+
+void URPGGameFeatureAction_AddWidgets::PrewarmWidgets(UGameInstance* GameInstance, const FGameFeatureStateChangeContext& ChangeContext)
+{
+	if (!RPGConsoleVariables::bPrewarmWidgets || !Layout.ContainsByPredicate([](const FRPGHUDLayoutRequest& Entry) { return Entry.bPrewarm; }))
+	{
+		return;
+	}
+
+	if (URPGUIManagerSubsystem* UIManager = GameInstance->GetSubsystem<URPGUIManagerSubsystem>())
+	{
+		for (auto It = GameInstance->GetLocalPlayerIterator(); It; ++It)
+		{
+			const FDelegateHandle RootLayoutReadyHandle = UIManager->CallOrRegister_OnRootLayoutReady(*It,
+				FOnRPGRootLayoutReady::FDelegate::CreateUObject(this, &ThisClass::HandlePrewarmLayoutReady, ChangeContext));
+
+			// Invalid when the layout already existed and the prewarm ran right away
+			if (RootLayoutReadyHandle.IsValid())
+			{
+				if (FPerContextData* ActiveData = ContextData.Find(ChangeContext))
+				{
+					ActiveData->PrewarmLayoutReadyHandles.Emplace(GameInstance, RootLayoutReadyHandle);
+				}
+			}
+		}
+	}
+}
+
+void URPGGameFeatureAction_AddWidgets::HandlePrewarmLayoutReady(UCommonLocalPlayer* LocalPlayer, URPGPrimaryGameLayout* RootLayout, FGameFeatureStateChangeContext ChangeContext)
+{
+	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
+	if (!ActiveData || !RootLayout)
+	{
+		return;
+	}
+
+	for (const FRPGHUDLayoutRequest& Entry : Layout)
+	{
+		if (Entry.bPrewarm)
+		{
+			RootLayout->PrewarmWidget(Entry.LayoutClass.Get());
+		}
+	}
+
+	ActiveData->PrewarmedLayouts.AddUnique(RootLayout);
 }
 
 void URPGGameFeatureAction_AddWidgets::HandleActorExtension(AActor* Actor, FName EventName, FGameFeatureStateChangeContext ChangeContext)
@@ -61,11 +228,11 @@ void URPGGameFeatureAction_AddWidgets::HandleActorExtension(AActor* Actor, FName
 	}
 	else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) || (EventName == UGameFrameworkComponentManager::NAME_GameActorReady))
 	{
-		AddWidgets(Actor, ActiveData);
+		AddWidgets(Actor, ActiveData, ChangeContext);
 	}
 }
 
-void URPGGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& ActiveData)
+void URPGGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& ActiveData, const FGameFeatureStateChangeContext& ChangeContext)
 {
 	ARPGHUD* HUD = CastChecked<ARPGHUD>(Actor);
 
@@ -73,40 +240,107 @@ void URPGGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData
 	{
 		if (ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(HUD->GetOwningPlayerController()->Player))
 		{
+			URPGUIManagerSubsystem* UIManager = LocalPlayer->GetGameInstance() ? LocalPlayer->GetGameInstance()->GetSubsystem<URPGUIManagerSubsystem>() : nullptr;
+			if (!UIManager)
+			{
+				UE_LOG(LogRPG, Error, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: URPGUIManagerSubsystem not found for Player [%s]"), *GetNameSafe(LocalPlayer));
+				return;
+			}
+
 			FPerActorData& ActorData = ActiveData.ActorData.FindOrAdd(HUD);
+			if (ActorData.RootLayoutReadyHandle.IsValid())
+			{
+				return;
+			}
 
-			for (const FRPGHUDLayoutRequest& Entry : Layout)
+			// The root layout class is streamed in by the UI policy, wait for it rather than loading it here
+			const FDelegateHandle RootLayoutReadyHandle = UIManager->CallOrRegister_OnRootLayoutReady(LocalPlayer,
+				FOnRPGRootLayoutReady::FDelegate::CreateUObject(this, &ThisClass::HandleRootLayoutReady, TWeakObjectPtr<ARPGHUD>(HUD), ChangeContext));
+
+			// The delegate may have run already and removed the actor data
+			if (RootLayoutReadyHandle.IsValid())
 			{
-				if (TSubclassOf<UCommonActivatableWidget> ConcreteWidgetClass = Entry.LayoutClass.LoadSynchronous())
+				if (FPerActorData* PendingActorData = ActiveData.ActorData.Find(HUD))
 				{
-					UE_LOG(LogRPG, Verbose, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: Pushing layout [%s] to layer [%s]"), *GetNameSafe(ConcreteWidgetClass), *Entry.LayerID.ToString());
-					
-					UCommonActivatableWidget* AddedWidget = nullptr;
-					if (URPGPrimaryGameLayout* RootLayout = URPGPrimaryGameLayout::GetPrimaryGameLayout(LocalPlayer))
-					{
-						AddedWidget = RootLayout->PushWidgetToLayerStack(Entry.LayerID, ConcreteWidgetClass);
-					}
-					else
+					PendingActorData->RootLayoutReadyHandle = RootLayoutReadyHandle;
+				}
+			}
+		}
+	}
+	else
+	{
+		UE_LOG(LogRPG, Warning, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: HUD has no owning player controller yet."));
+	}
+}
+
+void URPGGameFeatureAction_AddWidgets::HandleRootLayoutReady(UCommonLocalPlayer* LocalPlayer, URPGPrimaryGameLayout* RootLayout, TWeakObjectPtr<ARPGHUD> WeakHUD, FGameFeatureStateChangeContext ChangeContext)
+{
+	FPerContextData* ActiveData = ContextData.Find(ChangeContext);
+	ARPGHUD* HUD = WeakHUD.Get();
+	FPerActorData* ActorData = (ActiveData && HUD) ? ActiveData->ActorData.Find(HUD) : nullptr;
+	if (!ActorData)
+	{
+		return;
+	}
+
+	ActorData->RootLayoutReadyHandle.Reset();
+
+	if (!RootLayout)
+	{
+		UE_LOG(LogRPG, Error, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: Failed to find Root Layout for Player [%s]"), *GetNameSafe(LocalPlayer));
+		return;
+	}
+
+	for (const FRPGHUDLayoutRequest& Entry : Layout)
+	{
+		if (Entry.LayoutClass.IsNull())
+		{
+			continue;
+		}
+
+		if (TSubclassOf<UCommonActivatableWidget> ConcreteWidgetClass = Entry.LayoutClass.Get())
+		{
+			UE_LOG(LogRPG, Verbose, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: Pushing layout [%s] to layer [%s]"), *GetNameSafe(ConcreteWidgetClass), *Entry.LayerID.ToString());
+
+			if (UCommonActivatableWidget* AddedWidget = RootLayout->PushWidgetToLayerStack(Entry.LayerID, ConcreteWidgetClass))
+			{
+				ActorData->LayoutsAdded.Add(AddedWidget);
+			}
+			else
+			{
+				UE_LOG(LogRPG, Error, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: Failed to push widget [%s]! Layer [%s] not registered."), *GetNameSafe(ConcreteWidgetClass), *Entry.LayerID.ToString());
+			}
+		}
+		else
+		{
+			// Still streaming, the layer gets the widget once the class arrives
+			UE_LOG(LogRPG, Verbose, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: Layout [%s] not resident yet, pushing it async to layer [%s]"), *Entry.LayoutClass.ToString(), *Entry.LayerID.ToString());
+
+			TWeakObjectPtr<ThisClass> WeakThis(this);
+			TSharedPtr<FStreamableHandle> PushHandle = RootLayout->PushWidgetToLayerStackAsync<UCommonActivatableWidget>(Entry.LayerID, false, Entry.LayoutClass,
+				[WeakThis, WeakHUD, ChangeContext](ERPGAsyncWidgetLayerState State, UCommonActivatableWidget* Widget)
+				{
+					if ((State != ERPGAsyncWidgetLayerState::AfterPush) || !Widget)
 					{
-						UE_LOG(LogRPG, Error, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: Failed to find Root Layout for Player [%s]"), *GetNameSafe(LocalPlayer));
+						return;
 					}
 
-					if (AddedWidget)
+					FPerContextData* PushContextData = WeakThis.IsValid() ? WeakThis->ContextData.Find(ChangeContext) : nullptr;
+					FPerActorData* PushActorData = (PushContextData && WeakHUD.IsValid()) ? PushContextData->ActorData.Find(WeakHUD.Get()) : nullptr;
+					if (PushActorData)
 					{
-						ActorData.LayoutsAdded.Add(AddedWidget);
+						PushActorData->LayoutsAdded.Add(Widget);
 					}
 					else
 					{
-						UE_LOG(LogRPG, Error, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: Failed to push widget [%s]! Either Root Layout is missing or Layer [%s] not registered."), *GetNameSafe(ConcreteWidgetClass), *Entry.LayerID.ToString());
+						// The HUD went away while the class was streaming
+						Widget->DeactivateWidget();
 					}
-				}
-			}
+				});
+
+			ActorData->PendingPushes.Add(PushHandle);
 		}
 	}
-	else
-	{
-		UE_LOG(LogRPG, Warning, TEXT("URPGGameFeatureAction_AddWidgets::AddWidgets: HUD has no owning player controller yet."));
-	}
 }
 
 void URPGGameFeatureAction_AddWidgets::RemoveWidgets(AActor* Actor, FPerContextData& ActiveData)
@@ -116,6 +350,25 @@ void URPGGameFeatureAction_AddWidgets::RemoveWidgets(AActor* Actor, FPerContextD
 
 	if (ActorData)
 	{
+		if (ActorData->RootLayoutReadyHandle.IsValid())
+		{
+			if (UGameInstance* GameInstance = HUD->GetGameInstance())
+			{
+				if (URPGUIManagerSubsystem* UIManager = GameInstance->GetSubsystem<URPGUIManagerSubsystem>())
+				{
+					UIManager->UnregisterOnRootLayoutReady(ActorData->RootLayoutReadyHandle);
+				}
+			}
+		}
+
+		for (const TSharedPtr<FStreamableHandle>& PendingPush : ActorData->PendingPushes)
+		{
+			if (PendingPush.IsValid() && PendingPush->IsLoadingInProgress())
+			{
+				PendingPush->CancelHandle();
+			}
+		}
+
 		for (TWeakObjectPtr<UCommonActivatableWidget>& AddedLayout : ActorData->LayoutsAdded)
 		{
 			if (AddedLayout.IsValid())
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameMode/RPGGameMode.h"
+#include "AIController.h"
 #include "AssetRegistry/AssetData.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
@@ -14,14 +15,102 @@
 #include "UI/RPGHUD.h"
 #include "Character/RPGPawnExtensionComponent.h"
 #include "Character/RPGPawnData.h"
+#include "Character/RPGPawnRecycleSubsystem.h"
 #include "GameMode/RPGWorldSettings.h"
 #include "GameMode/RPGExperienceDefinition.h"
 #include "GameMode/RPGExperienceManagerComponent.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "System/RPGTimerWheelSubsystem.h"
 #include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGGameMode)
 
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarSimulateRPGJoinStorm(
+	TEXT("RPG.SimulateJoinStorm"),
+	TEXT("Spawns controllers that all join, spawn and restart in the same frame, then removes them. Server only, once the experience has loaded. Usage: RPG.SimulateJoinStorm [NumControllers=100]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		ARPGGameMode* GameMode = World ? World->GetAuthGameMode<ARPGGameMode>() : nullptr;
+		const URPGExperienceManagerComponent* ExperienceComponent = GameMode ? GameMode->GetExperienceManagerComponent() : nullptr;
+		if (!ExperienceComponent || !ExperienceComponent->IsExperienceLoaded())
+		{
+			Ar.Logf(TEXT("RPG.SimulateJoinStorm needs an RPG game mode with a loaded experience."));
+			return;
+		}
+
+		const int32 NumControllers = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 100);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		TArray<AController*> Controllers;
+		Controllers.Reserve(NumControllers);
+
+		const double JoinStartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumControllers; ++Index)
+		{
+			if (AAIController* Controller = World->SpawnActor<AAIController>(AAIController::StaticClass(), FTransform::Identity, SpawnParams))
+			{
+				Controllers.Add(Controller);
+			}
+		}
+		const double JoinSeconds = FPlatformTime::Seconds() - JoinStartTime;
+
+		auto RestartAll = [GameMode, &Controllers]()
+		{
+			double SlowestSeconds = 0.0;
+			for (AController* Controller : Controllers)
+			{
+				const double RestartStartTime = FPlatformTime::Seconds();
+				GameMode->RestartPlayer(Controller);
+				SlowestSeconds = FMath::Max(SlowestSeconds, FPlatformTime::Seconds() - RestartStartTime);
+			}
+			return SlowestSeconds;
+		};
+
+		auto DestroyPawns = [&Controllers]()
+		{
+			for (AController* Controller : Controllers)
+			{
+				if (APawn* Pawn = Controller->GetPawn())
+				{
+					Controller->UnPossess();
+					Pawn->Destroy();
+				}
+			}
+		};
+
+		const double SpawnStartTime = FPlatformTime::Seconds();
+		const double SlowestSpawnSeconds = RestartAll();
+		const double SpawnSeconds = FPlatformTime::Seconds() - SpawnStartTime;
+
+		int32 NumSpawned = 0;
+		for (const AController* Controller : Controllers)
+		{
+			NumSpawned += (Controller->GetPawn() != nullptr) ? 1 : 0;
+		}
+
+		DestroyPawns();
+
+		const double RestartStartTime = FPlatformTime::Seconds();
+		const double SlowestRestartSeconds = RestartAll();
+		const double RestartSeconds = FPlatformTime::Seconds() - RestartStartTime;
+
+		DestroyPawns();
+		for (AController* Controller : Controllers)
+		{
+			Controller->Destroy();
+		}
+
+		const double NumJoined = FMath::Max(1, Controllers.Num());
+		Ar.Logf(TEXT("RPG.SimulateJoinStorm: %d controllers, %d pawns spawned, default pawn data %s"), Controllers.Num(), NumSpawned, *GetNameSafe(GameMode->GetPawnDataForController(nullptr)));
+		Ar.Logf(TEXT("  Join: %.3f ms total"), JoinSeconds * 1000.0);
+		Ar.Logf(TEXT("  Spawn: %.3f ms total, %.1f us average, %.1f us slowest"), SpawnSeconds * 1000.0, (SpawnSeconds * 1.0e6) / NumJoined, SlowestSpawnSeconds * 1.0e6);
+		Ar.Logf(TEXT("  Restart: %.3f ms total, %.1f us average, %.1f us slowest"), RestartSeconds * 1000.0, (RestartSeconds * 1.0e6) / NumJoined, SlowestRestartSeconds * 1.0e6);
+	}));
+
 ARPGGameMode::ARPGGameMode(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -46,24 +135,8 @@ const URPGPawnData* ARPGGameMode::GetPawnDataForController(const AController* In
 		}
 	}
 
-	// If not, fall back to the default for the current experience
-	check(GameState);
-	URPGExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<URPGExperienceManagerComponent>();
-	check(ExperienceComponent);
-
-	if (ExperienceComponent->IsExperienceLoaded())
-	{
-		const URPGExperienceDefinition* Experience = ExperienceComponent->GetCurrentExperienceChecked();
-		if (Experience->DefaultPawnData != nullptr)
-		{
-			return Experience->DefaultPawnData;
-		}
-
-		// Experience is loaded and there's still no pawn data, fall back to the global default
-		return URPGAssetManager::Get().GetDefaultPawnData();
-	}
-
-	return nullptr;
+	// If not, fall back to the default for the current experience (null until it has loaded)
+	return ExperiencePawnData;
 }
 
 void ARPGGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
@@ -71,7 +144,14 @@ void ARPGGameMode::InitGame(const FString& MapName, const FString& Options, FStr
 	Super::InitGame(MapName, Options, ErrorMessage);
 
 	// Wait for the next frame to give time to initialize startup settings
-	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ThisClass::HandleMatchAssignmentIfNotExpectingOne);
+	if (URPGTimerWheelSubsystem* TimerWheel = URPGTimerWheelSubsystem::Get(this))
+	{
+		TimerWheel->SetTimerForNextTick(this, &ThisClass::HandleMatchAssignmentIfNotExpectingOne);
+	}
+	else
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &ThisClass::HandleMatchAssignmentIfNotExpectingOne);
+	}
 }
 
 void ARPGGameMode::HandleMatchAssignmentIfNotExpectingOne()
@@ -141,9 +221,8 @@ void ARPGGameMode::OnMatchAssignmentGiven(FPrimaryAssetId ExperienceId, const FS
 	{
 		UE_LOG(LogRPGExperience, Log, TEXT("Identified experience %s (Source: %s)"), *ExperienceId.ToString(), *ExperienceIdSource);
 
-		URPGExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<URPGExperienceManagerComponent>();
-		check(ExperienceComponent);
-		ExperienceComponent->SetCurrentExperience(ExperienceId);
+		check(ExperienceManagerComponent);
+		ExperienceManagerComponent->SetCurrentExperience(ExperienceId);
 	}
 	else
 	{
@@ -151,6 +230,20 @@ void ARPGGameMode::OnMatchAssignmentGiven(FPrimaryAssetId ExperienceId, const FS
 	}
 }
 
+void ARPGGameMode::CacheExperienceSpawnData(const URPGExperienceDefinition* CurrentExperience)
+{
+	ExperiencePawnData = CurrentExperience->DefaultPawnData;
+	if (ExperiencePawnData == nullptr)
+	{
+		// Experience is loaded and there's still no pawn data, fall back to the global default
+		ExperiencePawnData = URPGAssetManager::Get().GetDefaultPawnData();
+	}
+
+	ExperiencePawnClass = (ExperiencePawnData && ExperiencePawnData->PawnClass) ? ExperiencePawnData->PawnClass.Get() : Super::GetDefaultPawnClassForController_Implementation(nullptr);
+
+	UE_LOG(LogRPGExperience, Log, TEXT("EXPERIENCE: Default pawn data %s (pawn class %s)"), *GetNameSafe(ExperiencePawnData), *GetNameSafe(ExperiencePawnClass));
+}
+
 void ARPGGameMode::OnExperienceLoaded(const URPGExperienceDefinition* CurrentExperience)
 {
 	// Spawn any players that are already attached
@@ -169,21 +262,21 @@ void ARPGGameMode::OnExperienceLoaded(const URPGExperienceDefinition* CurrentExp
 
 bool ARPGGameMode::IsExperienceLoaded() const
 {
-	check(GameState);
-	URPGExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<URPGExperienceManagerComponent>();
-	check(ExperienceComponent);
-
-	return ExperienceComponent->IsExperienceLoaded();
+	check(ExperienceManagerComponent);
+	return ExperienceManagerComponent->IsExperienceLoaded();
 }
 
 UClass* ARPGGameMode::GetDefaultPawnClassForController_Implementation(AController* InController)
 {
-	if (const URPGPawnData* PawnData = GetPawnDataForController(InController))
+	const URPGPawnData* PawnData = GetPawnDataForController(InController);
+	if ((PawnData != nullptr) && (PawnData == ExperiencePawnData))
 	{
-		if (PawnData->PawnClass)
-		{
-			return PawnData->PawnClass;
-		}
+		return ExperiencePawnClass;
+	}
+
+	if ((PawnData != nullptr) && PawnData->PawnClass)
+	{
+		return PawnData->PawnClass;
 	}
 
 	return Super::GetDefaultPawnClassForController_Implementation(InController);
@@ -191,18 +284,31 @@ UClass* ARPGGameMode::GetDefaultPawnClassForController_Implementation(AControlle
 
 APawn* ARPGGameMode::SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform)
 {
+	// Resolved once per spawn
+	const URPGPawnData* PawnData = GetPawnDataForController(NewPlayer);
+	UClass* PawnClass = GetDefaultPawnClassForController(NewPlayer);
+
+	// Give the player back the pawn it died with if it was parked
+	if (URPGPawnRecycleSubsystem* RecycleSubsystem = URPGPawnRecycleSubsystem::Get(this))
+	{
+		if (APawn* RecycledPawn = RecycleSubsystem->TakeParkedPawn(NewPlayer, PawnClass, PawnData, SpawnTransform))
+		{
+			return RecycledPawn;
+		}
+	}
+
 	FActorSpawnParameters SpawnInfo;
 	SpawnInfo.Instigator = GetInstigator();
 	SpawnInfo.ObjectFlags |= RF_Transient;
 	SpawnInfo.bDeferConstruction = true;
 
-	if (UClass* PawnClass = GetDefaultPawnClassForController(NewPlayer))
+	if (PawnClass != nullptr)
 	{
 		if (APawn* SpawnedPawn = GetWorld()->SpawnActor<APawn>(PawnClass, SpawnTransform, SpawnInfo))
 		{
 			if (URPGPawnExtensionComponent* PawnExtComp = URPGPawnExtensionComponent::FindPawnExtensionComponent(SpawnedPawn))
 			{
-				if (const URPGPawnData* PawnData = GetPawnDataForController(NewPlayer))
+				if (PawnData != nullptr)
 				{
 					PawnExtComp->SetPawnData(PawnData);
 				}
@@ -283,10 +389,12 @@ void ARPGGameMode::InitGameState()
 {
 	Super::InitGameState();
 
-	// Listen for the experience load to complete	
-	URPGExperienceManagerComponent* ExperienceComponent = GameState->FindComponentByClass<URPGExperienceManagerComponent>();
-	check(ExperienceComponent);
-	ExperienceComponent->CallOrRegister_OnExperienceLoaded(FOnRPGExperienceLoaded::FDelegate::CreateUObject(this, &ThisClass::OnExperienceLoaded));
+	ExperienceManagerComponent = GameState->FindComponentByClass<URPGExperienceManagerComponent>();
+	check(ExperienceManagerComponent);
+
+	// Listen for the experience load to complete, spawn data first so every other listener can use it
+	ExperienceManagerComponent->CallOrRegister_OnExperienceLoaded_HighPriority(FOnRPGExperienceLoaded::FDelegate::CreateUObject(this, &ThisClass::CacheExperienceSpawnData));
+	ExperienceManagerComponent->CallOrRegister_OnExperienceLoaded(FOnRPGExperienceLoaded::FDelegate::CreateUObject(this, &ThisClass::OnExperienceLoaded));
 }
 
 void ARPGGameMode::GenericPlayerInitialization(AController* NewPlayer)
@@ -305,7 +413,14 @@ void ARPGGameMode::RequestPlayerRestartNextFrame(AController* Controller, bool b
 
 	if (APlayerController* PC = Cast<APlayerController>(Controller))
 	{
-		GetWorldTimerManager().SetTimerForNextTick(PC, &APlayerController::ServerRestartPlayer_Implementation);
+		if (URPGTimerWheelSubsystem* TimerWheel = URPGTimerWheelSubsystem::Get(this))
+		{
+			TimerWheel->SetTimerForNextTick(PC, &APlayerController::ServerRestartPlayer_Implementation);
+		}
+		else
+		{
+			GetWorldTimerManager().SetTimerForNextTick(PC, &APlayerController::ServerRestartPlayer_Implementation);
+		}
 	}
 }
 
@@ -333,3 +448,28 @@ void ARPGGameMode::FailedToRestartPlayer(AController* NewPlayer)
 		}
 	}
 }
+
+void ARPGGameMode::RestartPlayer(AController* NewPlayer)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Super::RestartPlayer(NewPlayer);
+
+	if (NewPlayer && NewPlayer->GetPawn())
+	{
+		if (URPGPawnRecycleSubsystem* RecycleSubsystem = URPGPawnRecycleSubsystem::Get(this))
+		{
+			RecycleSubsystem->NotifyPlayerRestarted(NewPlayer, FPlatformTime::Seconds() - StartTime);
+		}
+	}
+}
+
+void ARPGGameMode::Logout(AController* Exiting)
+{
+	if (URPGPawnRecycleSubsystem* RecycleSubsystem = URPGPawnRecycleSubsystem::Get(this))
+	{
+		RecycleSubsystem->HandleControllerLogout(Exiting);
+	}
+
+	Super::Logout(Exiting);
+}
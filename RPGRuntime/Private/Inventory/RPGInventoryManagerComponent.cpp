@@ -1,6 +1,7 @@
 #include "Inventory/RPGInventoryManagerComponent.h"
 #include "Inventory/RPGInventoryItemDefinition.h"
 #include "Inventory/RPGInventoryItemInstance.h"
+#include "Components/GameFrameworkComponentManager.h"
 #include "Engine/ActorChannel.h"
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
@@ -105,12 +106,56 @@ TArray<URPGInventoryItemInstance*> FRPGInventoryList::GetAllItems() const
 //////////////////////////////////////////////////////////////////////
 // URPGInventoryManagerComponent
 
+const FName URPGInventoryManagerComponent::NAME_ActorFeatureName("Inventory");
+
 URPGInventoryManagerComponent::URPGInventoryManagerComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer), InventoryList(this)
 {
 	SetIsReplicatedByDefault(true);
 }
 
+void URPGInventoryManagerComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	RegisterInitStateFeature();
+}
+
+void URPGInventoryManagerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ensure(TryToChangeInitState(RPGGameplayTags::InitState_Spawned));
+	CheckDefaultInitialization();
+}
+
+void URPGInventoryManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterInitStateFeature();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool URPGInventoryManagerComponent::CanChangeInitState(UGameFrameworkComponentManager* Manager, FGameplayTag CurrentState, FGameplayTag DesiredState) const
+{
+	if (!CurrentState.IsValid() && DesiredState == RPGGameplayTags::InitState_Spawned)
+	{
+		return (GetOwner() != nullptr);
+	}
+
+	// The inventory has no data to wait for, it is usable as soon as it has begun play
+	return (CurrentState == RPGGameplayTags::InitState_Spawned && DesiredState == RPGGameplayTags::InitState_DataAvailable)
+		|| (CurrentState == RPGGameplayTags::InitState_DataAvailable && DesiredState == RPGGameplayTags::InitState_DataInitialized)
+		|| (CurrentState == RPGGameplayTags::InitState_DataInitialized && DesiredState == RPGGameplayTags::InitState_GameplayReady);
+}
+
+void URPGInventoryManagerComponent::CheckDefaultInitialization()
+{
+	static const TArray<FGameplayTag> StateChain = { RPGGameplayTags::InitState_Spawned, RPGGameplayTags::InitState_DataAvailable, RPGGameplayTags::InitState_DataInitialized, RPGGameplayTags::InitState_GameplayReady };
+
+	ContinueInitStateChain(StateChain);
+}
+
 void URPGInventoryManagerComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
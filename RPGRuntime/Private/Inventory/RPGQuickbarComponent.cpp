@@ -1,6 +1,8 @@
 #include "Inventory/RPGQuickbarComponent.h"
 #include "Inventory/RPGInventoryItemInstance.h"
 #include "Inventory/RPGInventoryItemDefinition.h"
+#include "Inventory/RPGInventoryManagerComponent.h"
+#include "Components/GameFrameworkComponentManager.h"
 #include "Equipment/RPGEquipmentManagerComponent.h"
 #include "Equipment/RPGWeaponInstance.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
@@ -11,6 +13,8 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGQuickbarComponent)
 
+const FName URPGQuickbarComponent::NAME_ActorFeatureName("Quickbar");
+
 URPGQuickbarComponent::URPGQuickbarComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -24,6 +28,13 @@ void URPGQuickbarComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>
 	DOREPLIFETIME(ThisClass, ActiveSlotIndex);
 }
 
+void URPGQuickbarComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	RegisterInitStateFeature();
+}
+
 void URPGQuickbarComponent::BeginPlay()
 {
 	Super::BeginPlay();
@@ -31,6 +42,69 @@ void URPGQuickbarComponent::BeginPlay()
 	{
 		Slots.SetNum(NumSlots);
 	}
+
+	// Listen for the inventory, it may be added after us
+	BindOnActorInitStateChanged(URPGInventoryManagerComponent::NAME_ActorFeatureName, FGameplayTag(), false);
+
+	ensure(TryToChangeInitState(RPGGameplayTags::InitState_Spawned));
+	CheckDefaultInitialization();
+}
+
+void URPGQuickbarComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterInitStateFeature();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool URPGQuickbarComponent::CanChangeInitState(UGameFrameworkComponentManager* Manager, FGameplayTag CurrentState, FGameplayTag DesiredState) const
+{
+	check(Manager);
+
+	AActor* Owner = GetOwner();
+	if (!CurrentState.IsValid() && DesiredState == RPGGameplayTags::InitState_Spawned)
+	{
+		return (Owner != nullptr);
+	}
+	else if (CurrentState == RPGGameplayTags::InitState_Spawned && DesiredState == RPGGameplayTags::InitState_DataAvailable)
+	{
+		// The slots are sized by the server and replicated
+		return (Slots.Num() > 0) || !Owner->HasAuthority();
+	}
+	else if (CurrentState == RPGGameplayTags::InitState_DataAvailable && DesiredState == RPGGameplayTags::InitState_DataInitialized)
+	{
+		return true;
+	}
+	else if (CurrentState == RPGGameplayTags::InitState_DataInitialized && DesiredState == RPGGameplayTags::InitState_GameplayReady)
+	{
+		return Manager->HasFeatureReachedInitState(Owner, URPGInventoryManagerComponent::NAME_ActorFeatureName, RPGGameplayTags::InitState_GameplayReady);
+	}
+
+	return false;
+}
+
+void URPGQuickbarComponent::OnActorInitStateChanged(const FActorInitStateChangedParams& Params)
+{
+	if (Params.FeatureName == URPGInventoryManagerComponent::NAME_ActorFeatureName)
+	{
+		if (Params.FeatureState == RPGGameplayTags::InitState_GameplayReady)
+		{
+			CheckDefaultInitialization();
+		}
+	}
+}
+
+void URPGQuickbarComponent::CheckDefaultInitialization()
+{
+	static const TArray<FGameplayTag> StateChain = { RPGGameplayTags::InitState_Spawned, RPGGameplayTags::InitState_DataAvailable, RPGGameplayTags::InitState_DataInitialized, RPGGameplayTags::InitState_GameplayReady };
+
+	ContinueInitStateChain(StateChain);
+}
+
+bool URPGQuickbarComponent::IsInventoryReady(const AController* Controller)
+{
+	UGameFrameworkComponentManager* Manager = UGameFrameworkComponentManager::GetForActor(Controller);
+	return Manager && Manager->HasFeatureReachedInitState(const_cast<AController*>(Controller), NAME_ActorFeatureName, RPGGameplayTags::InitState_GameplayReady);
 }
 
 void URPGQuickbarComponent::CycleActiveSlotForward()
@@ -209,7 +209,7 @@ void ARPGPlayerState::SetGenericTeamId(const FGenericTeamId& NewTeamID)
 
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, MyTeamID, this);
 		MyTeamID = NewTeamID;
-		// ConditionalBroadcastTeamChanged(this, OldTeamID, NewTeamID);
+		ConditionalBroadcastTeamChanged(this, OldTeamID, NewTeamID);
 	}
 	else
 	{
@@ -222,9 +222,14 @@ FGenericTeamId ARPGPlayerState::GetGenericTeamId() const
 	return MyTeamID;
 }
 
+FOnRPGTeamIndexChangedDelegate* ARPGPlayerState::GetOnTeamIndexChangedDelegate()
+{
+	return &OnTeamChangedDelegate;
+}
+
 void ARPGPlayerState::OnRep_MyTeamID(FGenericTeamId OldTeamID)
 {
-	// ConditionalBroadcastTeamChanged(this, OldTeamID, MyTeamID);
+	ConditionalBroadcastTeamChanged(this, OldTeamID, MyTeamID);
 }
 
 void ARPGPlayerState::OnRep_MySquadID()
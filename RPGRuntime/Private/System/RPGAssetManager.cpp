@@ -8,27 +8,166 @@
 #include "GameMode/RPGExperienceDefinition.h"
 #include "GameMode/RPGExperienceActionSet.h"
 #include "AbilitySystemGlobals.h"
+#include "Algo/AllOf.h"
 #include "Misc/App.h"
 #include "Stats/StatsMisc.h"
 #include "Engine/AssetManager.h"
 #include "Engine/Engine.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformStackWalk.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Tasks/Task.h"
+#include "UObject/UObjectGlobals.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGAssetManager)
 
 const FName FRPGBundles::Equipped("Equipped");
 
+FRPGInitialGameContentLoadProgressDelegate URPGAssetManager::OnInitialGameContentLoadProgress;
+
+namespace RPGConsoleVariables
+{
+	static bool bParallelStartupJobs = true;
+	static FAutoConsoleVariableRef CVarParallelStartupJobs(
+		TEXT("rpg.startup.ParallelJobs"),
+		bParallelStartupJobs,
+		TEXT("Runs independent asset manager startup jobs concurrently. When off, jobs run one after the other in declaration order."),
+		ECVF_Default);
+
+	static bool bLogSyncLoads = false;
+	static FAutoConsoleVariableRef CVarLogSyncLoads(
+		TEXT("rpg.assets.LogSyncLoads"),
+		bLogSyncLoads,
+		TEXT("Logs every synchronous asset load hit after the startup jobs completed, with its callstack. Each package is reported once."),
+		ECVF_Default);
+
+	static bool bSnapshotAssetsOnExperienceLoad = false;
+	static FAutoConsoleVariableRef CVarSnapshotAssetsOnExperienceLoad(
+		TEXT("rpg.assets.SnapshotOnExperienceLoad"),
+		bSnapshotAssetsOnExperienceLoad,
+		TEXT("Captures a loaded asset snapshot after every experience load and logs the diff against the previous experience."),
+		ECVF_Default);
+
+#if !UE_BUILD_SHIPPING
+	static bool bWriteStartupJobCsv = false;
+	static FAutoConsoleVariableRef CVarWriteStartupJobCsv(
+		TEXT("rpg.startup.WriteJobCsv"),
+		bWriteStartupJobCsv,
+		TEXT("Writes the per job startup timings to Saved/Profiling/RPGStartupJobs."),
+		ECVF_Default);
+#endif // !UE_BUILD_SHIPPING
+};
+
+namespace RPGStartupJobs
+{
+	enum class EJobState : uint8
+	{
+		Pending,
+		Running,
+		Loading,
+		Done
+	};
+
+	struct FJobRuntime
+	{
+		TArray<int32> PrerequisiteIndices;
+		TSharedPtr<FStreamableHandle> Handle;
+		UE::Tasks::FTask Task;
+		EJobState State = EJobState::Pending;
+
+		// Absolute FPlatformTime seconds
+		double ReadyTime = 0.0;
+		double StartTime = 0.0;
+		double ExecuteEndTime = 0.0;
+		double EndTime = 0.0;
+	};
+
+	static const TCHAR* LexThread(ERPGStartupJobThread Thread)
+	{
+		return (Thread == ERPGStartupJobThread::AnyThread) ? TEXT("AnyThread") : TEXT("GameThread");
+	}
+
+	static void WriteReport(const TArray<FRPGAssetManagerStartupJob>& Jobs, const TArray<FJobRuntime>& Runtimes, double StartTime, double EndTime)
+	{
+		const auto ToMs = [StartTime](double Time) { return (Time - StartTime) * 1000.0; };
+
+		FString Csv = TEXT("Job,Thread,Weight,Prerequisites,ReadyMs,StartMs,ExecuteMs,LoadMs,EndMs\n");
+		double SerialTime = 0.0;
+
+		UE_LOG(LogRPG, Display, TEXT("========== RPG Startup Jobs =========="));
+		for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+		{
+			const FRPGAssetManagerStartupJob& Job = Jobs[JobIndex];
+			const FJobRuntime& Runtime = Runtimes[JobIndex];
+			const double ExecuteMs = (Runtime.ExecuteEndTime - Runtime.StartTime) * 1000.0;
+			const double LoadMs = (Runtime.EndTime - Runtime.ExecuteEndTime) * 1000.0;
+			SerialTime += Runtime.EndTime - Runtime.StartTime;
+
+			UE_LOG(LogRPG, Display, TEXT("  %-24s %-10s start %8.2fms  wait %7.2fms  execute %8.2fms  load %8.2fms  end %8.2fms"),
+				*Job.JobName, LexThread(Job.Thread), ToMs(Runtime.StartTime), (Runtime.StartTime - Runtime.ReadyTime) * 1000.0, ExecuteMs, LoadMs, ToMs(Runtime.EndTime));
+
+			Csv += FString::Printf(TEXT("%s,%s,%.2f,%s,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+				*Job.JobName, LexThread(Job.Thread), Job.JobWeight, *FString::Join(Job.Prerequisites, TEXT(";")),
+				ToMs(Runtime.ReadyTime), ToMs(Runtime.StartTime), ExecuteMs, LoadMs, ToMs(Runtime.EndTime));
+		}
+		UE_LOG(LogRPG, Display, TEXT("  Wall time %.2fms, serial time %.2fms, since process start %.2fs"),
+			(EndTime - StartTime) * 1000.0, SerialTime * 1000.0, EndTime - GStartTime);
+		UE_LOG(LogRPG, Display, TEXT("========== ========== =========="));
+
+#if !UE_BUILD_SHIPPING
+		if (RPGConsoleVariables::bWriteStartupJobCsv)
+		{
+			const FString CsvPath = FPaths::ProfilingDir() / TEXT("RPGStartupJobs") / FString::Printf(TEXT("StartupJobs-%s.csv"), *FDateTime::Now().ToString());
+			if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+			{
+				UE_LOG(LogRPG, Display, TEXT("Startup job timings written to %s"), *CsvPath);
+			}
+		}
+#endif // !UE_BUILD_SHIPPING
+	}
+};
+
 //////////////////////////////////////////////////////////////////////
 
-static FAutoConsoleCommand CVarDumpRPGAssets(
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpRPGAssets(
 	TEXT("RPG.DumpLoadedAssets"),
-	TEXT("Shows all assets that were loaded via the RPG asset manager and are currently in memory."),
-	FConsoleCommandDelegate::CreateStatic(URPGAssetManager::DumpLoadedAssets)
-);
+	TEXT("Usage: RPG.DumpLoadedAssets [Sort=Inclusive|Exclusive|Name] [CSV] [Refs=N]. Shows all assets that were loaded via the RPG asset manager and are currently in memory."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		URPGAssetManager::Get().DumpLoadedAssetsToOutputDevice(Args, Ar);
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarSnapshotRPGAssets(
+	TEXT("RPG.SnapshotLoadedAssets"),
+	TEXT("Usage: RPG.SnapshotLoadedAssets <Name>. Stores the loaded assets under Name for RPG.DiffLoadedAssets."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		URPGAssetManager::Get().SnapshotLoadedAssets((Args.Num() > 0) ? Args[0] : FDateTime::Now().ToString(), Ar);
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDiffRPGAssets(
+	TEXT("RPG.DiffLoadedAssets"),
+	TEXT("Usage: RPG.DiffLoadedAssets <Before> [After]. Diffs two loaded asset snapshots, or a snapshot against the current state."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (Args.Num() < 1)
+		{
+			Ar.Logf(TEXT("Usage: RPG.DiffLoadedAssets <Before> [After]"));
+			return;
+		}
+
+		URPGAssetManager::Get().DiffLoadedAssets(Args[0], (Args.Num() > 1) ? Args[1] : FString(), Ar);
+	}));
 
 //////////////////////////////////////////////////////////////////////
 
-#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FRPGAssetManagerStartupJob(#JobFunc, FRPGAssetManagerStartupJob::FRPGAssetManagerStartupJobDelegate::CreateLambda([this](const FRPGAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}), JobWeight))
+#define STARTUP_JOB_NAMED(JobName, JobFunc, JobWeight) StartupJobs.Add_GetRef(FRPGAssetManagerStartupJob(JobName, FRPGAssetManagerStartupJob::FRPGAssetManagerStartupJobDelegate::CreateLambda([this](const FRPGAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}), JobWeight))
+#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) STARTUP_JOB_NAMED(#JobFunc, JobFunc, JobWeight)
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
 
 //////////////////////////////////////////////////////////////////////
@@ -54,13 +193,106 @@ URPGAssetManager& URPGAssetManager::Get()
 
 void URPGAssetManager::DumpLoadedAssets()
 {
-	UE_LOG(LogRPG, Log, TEXT("========== Start Dumping Loaded RPG Assets =========="));
+	Get().DumpLoadedAssetsToOutputDevice(TArray<FString>(), *GLog);
+}
+
+void URPGAssetManager::DumpLoadedAssetsToOutputDevice(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	// LoadedAssets is private in ULyraAssetManager, the RPG asset manager tracks what it pins itself
+	ERPGLoadedAssetSort SortMode = ERPGLoadedAssetSort::Inclusive;
+	bool bWriteCsv = false;
+	int32 NumReferencerSearches = 0;
+
+	for (const FString& Arg : Args)
+	{
+		FString SortName;
+		if (FParse::Value(*Arg, TEXT("Sort="), SortName))
+		{
+			if (SortName.Equals(TEXT("Exclusive"), ESearchCase::IgnoreCase))
+			{
+				SortMode = ERPGLoadedAssetSort::Exclusive;
+			}
+			else if (SortName.Equals(TEXT("Name"), ESearchCase::IgnoreCase))
+			{
+				SortMode = ERPGLoadedAssetSort::Name;
+			}
+		}
+		else if (Arg.Equals(TEXT("CSV"), ESearchCase::IgnoreCase))
+		{
+			bWriteCsv = true;
+		}
+		else
+		{
+			FParse::Value(*Arg, TEXT("Refs="), NumReferencerSearches);
+		}
+	}
+
+	FRPGLoadedAssetSnapshot Snapshot = LoadedAssetTracker.Capture(*this, TEXT("Current"), NumReferencerSearches);
+	FRPGLoadedAssetTracker::SortRecords(Snapshot.Records, SortMode);
+
+	if (bWriteCsv)
+	{
+		const FString CsvPath = FPaths::ProfilingDir() / TEXT("RPGLoadedAssets") / FString::Printf(TEXT("LoadedAssets-%s.csv"), *Snapshot.Time.ToString());
+		if (FFileHelper::SaveStringToFile(FRPGLoadedAssetTracker::WriteCsv(Snapshot), *CsvPath))
+		{
+			Ar.Logf(TEXT("Wrote %d loaded assets to %s"), Snapshot.Records.Num(), *CsvPath);
+		}
+		return;
+	}
+
+	FRPGLoadedAssetTracker::WriteText(Snapshot, Ar);
+}
+
+void URPGAssetManager::SnapshotLoadedAssets(const FString& SnapshotName, FOutputDevice& Ar)
+{
+	FRPGLoadedAssetSnapshot Snapshot = LoadedAssetTracker.Capture(*this, SnapshotName);
+	Ar.Logf(TEXT("Stored loaded asset snapshot [%s]: %d assets, %.2f MB inclusive"),
+		*SnapshotName, Snapshot.Records.Num(), (double)Snapshot.GetTotalInclusiveBytes() / (1024.0 * 1024.0));
+
+	LoadedAssetTracker.StoreSnapshot(MoveTemp(Snapshot));
+}
+
+void URPGAssetManager::DiffLoadedAssets(const FString& BeforeName, const FString& AfterName, FOutputDevice& Ar)
+{
+	const FRPGLoadedAssetSnapshot* Before = LoadedAssetTracker.FindSnapshot(BeforeName);
+	const FRPGLoadedAssetSnapshot* After = AfterName.IsEmpty() ? nullptr : LoadedAssetTracker.FindSnapshot(AfterName);
+	if (!Before || (!AfterName.IsEmpty() && !After))
+	{
+		Ar.Logf(TEXT("Unknown loaded asset snapshot. Stored snapshots:"));
+		for (const FRPGLoadedAssetSnapshot& Snapshot : LoadedAssetTracker.GetSnapshots())
+		{
+			Ar.Logf(TEXT("  %s (%s)"), *Snapshot.Name, *Snapshot.Time.ToString());
+		}
+		return;
+	}
 
-	// LoadedAssets is private in ULyraAssetManager and cannot be accessed here.
-	// We could implement a tracked list in RPGAssetManager if needed, or call Super if it existed.
-	UE_LOG(LogRPG, Log, TEXT("  (Asset tracking dump not available in specialized RPGAssetManager)"));
+	if (After)
+	{
+		FRPGLoadedAssetTracker::WriteDiff(*Before, *After, Ar);
+	}
+	else
+	{
+		FRPGLoadedAssetTracker::WriteDiff(*Before, LoadedAssetTracker.Capture(*this, TEXT("Current")), Ar);
+	}
+}
 
-	UE_LOG(LogRPG, Log, TEXT("========== Finish Dumping Loaded RPG Assets =========="));
+void URPGAssetManager::HandleExperienceLoaded(const URPGExperienceDefinition* Experience)
+{
+	if (!RPGConsoleVariables::bSnapshotAssetsOnExperienceLoad)
+	{
+		return;
+	}
+
+	const FString SnapshotName = FString::Printf(TEXT("Experience%d_%s"), NumExperienceSnapshots++, *GetNameSafe(Experience));
+	FRPGLoadedAssetSnapshot Snapshot = LoadedAssetTracker.Capture(*this, SnapshotName);
+
+	if (const FRPGLoadedAssetSnapshot* Previous = LoadedAssetTracker.FindSnapshot(LastExperienceSnapshotName))
+	{
+		FRPGLoadedAssetTracker::WriteDiff(*Previous, Snapshot, *GLog);
+	}
+
+	LastExperienceSnapshotName = SnapshotName;
+	LoadedAssetTracker.StoreSnapshot(MoveTemp(Snapshot));
 }
 
 void URPGAssetManager::StartInitialLoading()
@@ -78,13 +310,20 @@ void URPGAssetManager::StartInitialLoading()
 	*/
 
 	// Initialize Native Tags
-	STARTUP_JOB(FRPGGameplayTags::InitializeNativeTags());
+	STARTUP_JOB_NAMED(TEXT("NativeTags"), FRPGGameplayTags::InitializeNativeTags(), 1.f);
+
+	// Start streaming the data assets early so they load while the CPU bound jobs run.
+	// They can reference native tags, which must be registered first.
+	STARTUP_JOB_NAMED(TEXT("RequestGameData"), LoadHandle = RequestGameDataLoad(), 20.f).DependsOn(TEXT("NativeTags"));
+	STARTUP_JOB_NAMED(TEXT("RequestDefaultPawnData"), LoadHandle = RequestDefaultPawnDataLoad(), 4.f).DependsOn(TEXT("NativeTags"));
 
 	{
 		// Load base game data asset
-		STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+		STARTUP_JOB_NAMED(TEXT("GameData"), GetGameData(), 5.f).DependsOn(TEXT("RequestGameData"));
 	}
 
+	STARTUP_JOB_NAMED(TEXT("DefaultPawnData"), GetDefaultPawnData(), 1.f).DependsOn(TEXT("RequestDefaultPawnData"));
+
 	DoAllStartupJobs();
 }
 
@@ -108,9 +347,16 @@ UPrimaryDataAsset* URPGAssetManager::LoadGameDataOfClass(TSubclassOf<UPrimaryDat
 {
 	UPrimaryDataAsset* Asset = nullptr;
 
+	// Already streamed in by RequestGameDataLoad, no need to block
 	if (!DataClassPath.IsNull())
+	{
+		Asset = DataClassPath.Get();
+	}
+
+	if (!DataClassPath.IsNull() && !Asset)
 	{
 		UE_LOG(LogRPG, Log, TEXT("Loading RPG GameData: %s ..."), *DataClassPath.ToString());
+		ReportSynchronousLoad(DataClassPath.ToSoftObjectPath().GetLongPackageName(), TEXT("LoadGameDataOfClass"));
 
 		if (GIsEditor)
 		{
@@ -131,27 +377,349 @@ UPrimaryDataAsset* URPGAssetManager::LoadGameDataOfClass(TSubclassOf<UPrimaryDat
 	if (Asset)
 	{
 		GameDataMap.Add(DataClass, Asset);
+		TrackLoadedAsset(Asset, TEXT("GameDataMap"));
+
+		if (const URPGGameData* GameData = Cast<URPGGameData>(Asset))
+		{
+			BroadcastGameDataReady(*GameData);
+		}
 	}
 
 	return Asset;
 }
 
+const URPGGameData* URPGAssetManager::GetGameDataIfLoaded() const
+{
+	if (TObjectPtr<UPrimaryDataAsset> const * pResult = GameDataMap.Find(URPGGameData::StaticClass()))
+	{
+		return CastChecked<URPGGameData>(*pResult);
+	}
+
+	return nullptr;
+}
+
+void URPGAssetManager::CallOrRegister_OnGameDataReady(FOnRPGGameDataReady::FDelegate&& Delegate)
+{
+	if (const URPGGameData* GameData = GetGameDataIfLoaded())
+	{
+		Delegate.Execute(*GameData);
+	}
+	else
+	{
+		OnGameDataReady.Add(MoveTemp(Delegate));
+		RequestGameDataLoad();
+	}
+}
+
+void URPGAssetManager::HandleGameDataLoaded()
+{
+	if (IsGameDataReady())
+	{
+		// A blocking GetGameData got there first and already broadcast
+		return;
+	}
+
+	URPGGameData* GameData = RPGGameDataPath.Get();
+	if (!GameData)
+	{
+		UE_LOG(LogRPG, Error, TEXT("URPGAssetManager::HandleGameDataLoaded: Failed to stream in RPGGameData [%s]."), *RPGGameDataPath.ToString());
+		return;
+	}
+
+	GameDataMap.Add(URPGGameData::StaticClass(), GameData);
+	TrackLoadedAsset(GameData, TEXT("GameDataMap"));
+	BroadcastGameDataReady(*GameData);
+}
+
+void URPGAssetManager::BroadcastGameDataReady(const URPGGameData& GameData)
+{
+	GameDataLoadHandle.Reset();
+
+	OnGameDataReady.Broadcast(GameData);
+	OnGameDataReady.Clear();
+}
+
+void URPGAssetManager::ReportSynchronousLoad(const FString& AssetName, const TCHAR* Context)
+{
+	if (!RPGConsoleVariables::bLogSyncLoads || !bStartupJobsComplete || !IsInGameThread())
+	{
+		return;
+	}
+
+	// Editor browsing loads assets all the time, only gameplay matters
+	if (GIsEditor && !GIsPlayInEditorWorld)
+	{
+		return;
+	}
+
+	bool bAlreadyReported = false;
+	ReportedSyncLoads.Add(AssetName, &bAlreadyReported);
+	if (bAlreadyReported)
+	{
+		return;
+	}
+
+	ANSICHAR StackTrace[16384];
+	StackTrace[0] = 0;
+	FPlatformStackWalk::StackWalkAndDump(StackTrace, UE_ARRAY_COUNT(StackTrace), 2);
+
+	UE_LOG(LogRPG, Warning, TEXT("Synchronous load of [%s] after startup (%s) stalls the game thread:\n%s"), *AssetName, Context, ANSI_TO_TCHAR(StackTrace));
+}
+
+void URPGAssetManager::HandleSyncLoadPackage(const FString& PackageName)
+{
+	ReportSynchronousLoad(PackageName, TEXT("LoadPackage"));
+}
+
+TSharedPtr<FStreamableHandle> URPGAssetManager::RequestGameDataLoad()
+{
+	if (RPGGameDataPath.IsNull() || IsGameDataReady())
+	{
+		return nullptr;
+	}
+
+	if (!GameDataLoadHandle.IsValid() || GameDataLoadHandle->WasCanceled())
+	{
+		const FStreamableDelegate OnLoaded = FStreamableDelegate::CreateUObject(this, &ThisClass::HandleGameDataLoaded);
+
+		// Same split as LoadGameDataOfClass, the editor loads the path directly
+		if (GIsEditor)
+		{
+			GameDataLoadHandle = GetStreamableManager().RequestAsyncLoad(RPGGameDataPath.ToSoftObjectPath(), OnLoaded);
+		}
+		else
+		{
+			GameDataLoadHandle = LoadPrimaryAssetsWithType(URPGGameData::StaticClass()->GetFName(), TArray<FName>(), OnLoaded);
+		}
+	}
+
+	return GameDataLoadHandle;
+}
+
+TSharedPtr<FStreamableHandle> URPGAssetManager::RequestDefaultPawnDataLoad()
+{
+	if (RPGDefaultPawnData.IsNull() || RPGDefaultPawnData.Get())
+	{
+		return nullptr;
+	}
+
+	return GetStreamableManager().RequestAsyncLoad(RPGDefaultPawnData.ToSoftObjectPath(), FStreamableDelegate());
+}
+
 void URPGAssetManager::DoAllStartupJobs()
 {
+	using namespace RPGStartupJobs;
+
 	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
 
-	for (const FRPGAssetManagerStartupJob& StartupJob : StartupJobs)
+	const int32 NumJobs = StartupJobs.Num();
+	TArray<FJobRuntime> Runtimes;
+	Runtimes.SetNum(NumJobs);
+
+	TMap<FString, int32> JobIndexByName;
+	float TotalJobWeight = 0.0f;
+	for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+	{
+		JobIndexByName.Add(StartupJobs[JobIndex].JobName, JobIndex);
+		TotalJobWeight += StartupJobs[JobIndex].JobWeight;
+	}
+
+	for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+	{
+		for (const FString& PrerequisiteName : StartupJobs[JobIndex].Prerequisites)
+		{
+			if (const int32* PrerequisiteIndex = JobIndexByName.Find(PrerequisiteName))
+			{
+				Runtimes[JobIndex].PrerequisiteIndices.Add(*PrerequisiteIndex);
+			}
+			else
+			{
+				UE_LOG(LogRPG, Warning, TEXT("Startup job [%s] depends on unknown job [%s], ignoring it."), *StartupJobs[JobIndex].JobName, *PrerequisiteName);
+			}
+		}
+
+		// Serial mode keeps the declaration order, handy to compare boot times
+		if (!RPGConsoleVariables::bParallelStartupJobs && (JobIndex > 0))
+		{
+			Runtimes[JobIndex].PrerequisiteIndices.AddUnique(JobIndex - 1);
+		}
+	}
+
+	int32 NumDone = 0;
+	float LastReportedPercent = -1.0f;
+
+	const auto FinishExecution = [&Runtimes, &NumDone](int32 JobIndex)
+	{
+		FJobRuntime& Runtime = Runtimes[JobIndex];
+		if (Runtime.Handle.IsValid() && !Runtime.Handle->HasLoadCompleted() && !Runtime.Handle->WasCanceled())
+		{
+			Runtime.State = EJobState::Loading;
+		}
+		else
+		{
+			Runtime.State = EJobState::Done;
+			Runtime.EndTime = FPlatformTime::Seconds();
+			++NumDone;
+		}
+	};
+
+	while (NumDone < NumJobs)
 	{
-		StartupJob.DoJob();
+		int32 NumTasksInFlight = 0;
+		int32 FirstLoadingJob = INDEX_NONE;
+
+		// Pick up finished task graph jobs and completed loads
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			FJobRuntime& Runtime = Runtimes[JobIndex];
+			if (Runtime.State == EJobState::Running)
+			{
+				if (Runtime.Task.IsCompleted())
+				{
+					FinishExecution(JobIndex);
+				}
+				else
+				{
+					++NumTasksInFlight;
+				}
+			}
+
+			if (Runtime.State == EJobState::Loading)
+			{
+				if (!Runtime.Handle.IsValid() || Runtime.Handle->HasLoadCompleted() || Runtime.Handle->WasCanceled())
+				{
+					Runtime.State = EJobState::Done;
+					Runtime.EndTime = FPlatformTime::Seconds();
+					++NumDone;
+				}
+				else if (FirstLoadingJob == INDEX_NONE)
+				{
+					FirstLoadingJob = JobIndex;
+				}
+			}
+		}
+
+		// Dispatch every ready worker job first so they overlap with the game thread job below
+		int32 ReadyGameThreadJob = INDEX_NONE;
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			FJobRuntime& Runtime = Runtimes[JobIndex];
+			if (Runtime.State != EJobState::Pending)
+			{
+				continue;
+			}
+
+			const bool bPrerequisitesDone = Algo::AllOf(Runtime.PrerequisiteIndices, [&Runtimes](int32 PrerequisiteIndex) { return Runtimes[PrerequisiteIndex].State == EJobState::Done; });
+			if (!bPrerequisitesDone)
+			{
+				continue;
+			}
+
+			if (Runtime.ReadyTime == 0.0)
+			{
+				Runtime.ReadyTime = FPlatformTime::Seconds();
+			}
+
+			const FRPGAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+			if (StartupJob.Thread == ERPGStartupJobThread::AnyThread)
+			{
+				Runtime.State = EJobState::Running;
+				Runtime.StartTime = FPlatformTime::Seconds();
+				Runtime.Task = UE::Tasks::Launch(TEXT("RPGStartupJob"), [&StartupJob, &Runtime]()
+				{
+					Runtime.Handle = StartupJob.DoJob();
+					Runtime.ExecuteEndTime = FPlatformTime::Seconds();
+				});
+				++NumTasksInFlight;
+			}
+			else if (ReadyGameThreadJob == INDEX_NONE)
+			{
+				ReadyGameThreadJob = JobIndex;
+			}
+		}
+
+		if (ReadyGameThreadJob != INDEX_NONE)
+		{
+			FJobRuntime& Runtime = Runtimes[ReadyGameThreadJob];
+			Runtime.State = EJobState::Running;
+			Runtime.StartTime = FPlatformTime::Seconds();
+			Runtime.Handle = StartupJobs[ReadyGameThreadJob].DoJob();
+			Runtime.ExecuteEndTime = FPlatformTime::Seconds();
+			FinishExecution(ReadyGameThreadJob);
+
+			// Let pending loads make progress between CPU jobs
+			if (FirstLoadingJob != INDEX_NONE)
+			{
+				ProcessAsyncLoading(true, false, 0.002);
+			}
+		}
+		else if (NumTasksInFlight > 0)
+		{
+			if (FirstLoadingJob != INDEX_NONE)
+			{
+				ProcessAsyncLoading(true, false, 0.005);
+			}
+			else
+			{
+				FPlatformProcess::SleepNoStats(0.0f);
+			}
+		}
+		else if (FirstLoadingJob != INDEX_NONE)
+		{
+			// Only loads are left, block on the oldest one
+			Runtimes[FirstLoadingJob].Handle->WaitUntilComplete(0.0f, false);
+		}
+		else if (NumDone < NumJobs)
+		{
+			// Nothing in flight and nothing ready means the prerequisites form a cycle, break it at the first pending job
+			const int32 StuckJob = Runtimes.IndexOfByPredicate([](const FJobRuntime& Runtime) { return Runtime.State == EJobState::Pending; });
+			UE_LOG(LogRPG, Error, TEXT("Startup job [%s] has cyclic prerequisites, running it anyway."), *StartupJobs[StuckJob].JobName);
+			Runtimes[StuckJob].PrerequisiteIndices.Reset();
+		}
+
+		// Weighted progress, loads in flight count for their streamed fraction
+		float CompletedWeight = 0.0f;
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			const FJobRuntime& Runtime = Runtimes[JobIndex];
+			if (Runtime.State == EJobState::Done)
+			{
+				CompletedWeight += StartupJobs[JobIndex].JobWeight;
+			}
+			else if ((Runtime.State == EJobState::Loading) && Runtime.Handle.IsValid())
+			{
+				CompletedWeight += StartupJobs[JobIndex].JobWeight * Runtime.Handle->GetProgress();
+			}
+		}
+
+		const float Percent = (TotalJobWeight > 0.0f) ? FMath::Clamp(CompletedWeight / TotalJobWeight, 0.0f, 1.0f) : 1.0f;
+		if (Percent != LastReportedPercent)
+		{
+			LastReportedPercent = Percent;
+			UpdateInitialGameContentLoadPercent(Percent);
+		}
 	}
 
+	const double AllStartupJobsEndTime = FPlatformTime::Seconds();
+	UE_LOG(LogRPG, Display, TEXT("All RPG startup jobs took %.2f seconds to complete"), AllStartupJobsEndTime - AllStartupJobsStartTime);
+
+	WriteReport(StartupJobs, Runtimes, AllStartupJobsStartTime, AllStartupJobsEndTime);
+
 	StartupJobs.Empty();
 
-	UE_LOG(LogRPG, Display, TEXT("All RPG startup jobs took %.2f seconds to complete"), FPlatformTime::Seconds() - AllStartupJobsStartTime);
+	// From here on every blocking load is a gameplay hitch
+	bStartupJobsComplete = true;
+	if (!SyncLoadPackageHandle.IsValid())
+	{
+		SyncLoadPackageHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddUObject(this, &ThisClass::HandleSyncLoadPackage);
+	}
 }
 
 void URPGAssetManager::UpdateInitialGameContentLoadPercent(float GameContentPercent)
 {
+	UE_LOG(LogRPG, Verbose, TEXT("Initial game content load: %.0f%%"), GameContentPercent * 100.0f);
+
+	OnInitialGameContentLoadProgress.Broadcast(GameContentPercent);
 }
 
 #if WITH_EDITOR
@@ -1,12 +1,11 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "System/RPGAsyncAction_WaitForInventoryReady.h"
+#include "Components/GameFrameworkComponentManager.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/Controller.h"
-#include "Inventory/RPGInventoryManagerComponent.h"
 #include "Inventory/RPGQuickbarComponent.h"
-#include "TimerManager.h"
-#include "Engine/World.h"
+#include "System/RPGGameplayTags.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGAsyncAction_WaitForInventoryReady)
 
@@ -19,50 +18,100 @@ URPGAsyncAction_WaitForInventoryReady* URPGAsyncAction_WaitForInventoryReady::Wa
 {
 	URPGAsyncAction_WaitForInventoryReady* Action = NewObject<URPGAsyncAction_WaitForInventoryReady>();
 	Action->BoundPawn = Pawn;
+
+	// Nothing ticks this action while it waits, keep it alive until it is done
+	if (Pawn)
+	{
+		Action->RegisterWithGameInstance(Pawn);
+	}
 	return Action;
 }
 
 void URPGAsyncAction_WaitForInventoryReady::Activate()
 {
-	if (!BoundPawn.IsValid())
+	APawn* Pawn = BoundPawn.Get();
+	if (!Pawn)
 	{
 		SetReadyToDestroy();
 		return;
 	}
 
-	Step();
+	Pawn->ReceiveControllerChangedDelegate.AddDynamic(this, &ThisClass::HandleControllerChanged);
+
+	WaitForController(Pawn->GetController());
 }
 
-void URPGAsyncAction_WaitForInventoryReady::Step()
+void URPGAsyncAction_WaitForInventoryReady::WaitForController(AController* Controller)
 {
-	APawn* Pawn = BoundPawn.Get();
-	if (!Pawn)
+	UGameFrameworkComponentManager* Manager = UGameFrameworkComponentManager::GetForActor(BoundPawn.Get());
+
+	if (AController* OldController = WatchedController.Get())
 	{
-		SetReadyToDestroy();
-		return;
+		if (Manager)
+		{
+			Manager->UnregisterActorInitStateDelegate(OldController, InventoryReadyHandle);
+		}
 	}
+	InventoryReadyHandle.Reset();
+	WatchedController = Controller;
 
-	AController* Controller = Pawn->GetController();
-	if (Controller)
+	// No controller yet, HandleControllerChanged picks it up
+	if (!Controller || !Manager)
 	{
-		URPGInventoryManagerComponent* InventoryComponent = Controller->FindComponentByClass<URPGInventoryManagerComponent>();
-		URPGQuickbarComponent* QuickbarComponent = Controller->FindComponentByClass<URPGQuickbarComponent>();
+		return;
+	}
 
-		if (InventoryComponent && QuickbarComponent)
-		{
-			OnReady.Broadcast();
-			SetReadyToDestroy();
-			return;
-		}
+	if (URPGQuickbarComponent::IsInventoryReady(Controller))
+	{
+		Finish();
+		return;
 	}
 
-	// Not ready yet, poll again in 0.1s
-	if (UWorld* World = Pawn->GetWorld())
+	// The quickbar only becomes ready once the inventory is, so it is the only feature to wait for
+	InventoryReadyHandle = Manager->RegisterAndCallForActorInitState(Controller, URPGQuickbarComponent::NAME_ActorFeatureName, RPGGameplayTags::InitState_GameplayReady,
+		FActorInitStateChangedDelegate::CreateUObject(this, &ThisClass::HandleInventoryReady), /*bCallImmediately=*/ false);
+}
+
+void URPGAsyncAction_WaitForInventoryReady::HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	WaitForController(NewController);
+}
+
+void URPGAsyncAction_WaitForInventoryReady::HandleInventoryReady(const FActorInitStateChangedParams& Params)
+{
+	Finish();
+}
+
+void URPGAsyncAction_WaitForInventoryReady::Finish()
+{
+	StopListening();
+
+	OnReady.Broadcast();
+	SetReadyToDestroy();
+}
+
+void URPGAsyncAction_WaitForInventoryReady::StopListening()
+{
+	if (APawn* Pawn = BoundPawn.Get())
 	{
-		World->GetTimerManager().SetTimer(TimerHandle, this, &URPGAsyncAction_WaitForInventoryReady::Step, 0.1f, false);
+		Pawn->ReceiveControllerChangedDelegate.RemoveAll(this);
 	}
-	else
+
+	if (AController* Controller = WatchedController.Get())
 	{
-		SetReadyToDestroy();
+		if (UGameFrameworkComponentManager* Manager = UGameFrameworkComponentManager::GetForActor(Controller))
+		{
+			Manager->UnregisterActorInitStateDelegate(Controller, InventoryReadyHandle);
+		}
 	}
+
+	InventoryReadyHandle.Reset();
+	WatchedController.Reset();
+}
+
+void URPGAsyncAction_WaitForInventoryReady::SetReadyToDestroy()
+{
+	StopListening();
+
+	Super::SetReadyToDestroy();
 }
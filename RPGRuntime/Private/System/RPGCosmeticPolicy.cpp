@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "System/RPGCosmeticPolicy.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "System/RPGLogChannels.h"
+
+namespace RPGConsoleVariables
+{
+	static bool bCosmeticsStrictServerMode = false;
+	static FAutoConsoleVariableRef CVarCosmeticsStrictServerMode(
+		TEXT("rpg.cosmetics.StrictServerMode"),
+		bCosmeticsStrictServerMode,
+		TEXT("When enabled on a dedicated server, every cosmetic path that still executes is logged (once per path) and counted."),
+		ECVF_Default);
+};
+
+static FAutoConsoleCommandWithOutputDevice CVarDumpRPGCosmeticPaths(
+	TEXT("RPG.DumpCosmeticPaths"),
+	TEXT("Shows every cosmetic path that executed on this dedicated server while strict mode was enabled."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(RPGCosmeticPolicy::DumpCosmeticPaths));
+
+namespace RPGCosmeticPolicy
+{
+	// Path name -> number of executions, only written on the game thread
+	static TMap<FName, int32> ReportedCosmeticPaths;
+
+	static bool IsDedicatedServerWorld(const UObject* WorldContextObject)
+	{
+		const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+		if (World)
+		{
+			return (World->GetNetMode() == NM_DedicatedServer);
+		}
+
+		return IsRunningDedicatedServer();
+	}
+
+	bool ShouldRunCosmetics(const UObject* WorldContextObject)
+	{
+		return !IsDedicatedServerWorld(WorldContextObject);
+	}
+
+	void ReportCosmeticPath(const UObject* WorldContextObject, const TCHAR* PathName)
+	{
+		if (!RPGConsoleVariables::bCosmeticsStrictServerMode || !IsDedicatedServerWorld(WorldContextObject))
+		{
+			return;
+		}
+
+		check(IsInGameThread());
+
+		int32& Count = ReportedCosmeticPaths.FindOrAdd(FName(PathName));
+		if (Count++ == 0)
+		{
+			UE_LOG(LogRPG, Warning, TEXT("RPGCosmeticPolicy: Cosmetic path [%s] executed on a dedicated server (context: %s)."), PathName, *GetNameSafe(WorldContextObject));
+		}
+	}
+
+	void DumpCosmeticPaths(FOutputDevice& Ar)
+	{
+		Ar.Logf(TEXT("========== Cosmetic paths executed on server =========="));
+		Ar.Logf(TEXT("Strict mode: %d"), RPGConsoleVariables::bCosmeticsStrictServerMode ? 1 : 0);
+
+		for (const TPair<FName, int32>& Pair : ReportedCosmeticPaths)
+		{
+			Ar.Logf(TEXT("  %s: %d"), *Pair.Key.ToString(), Pair.Value);
+		}
+
+		Ar.Logf(TEXT("========== ========== =========="));
+	}
+}
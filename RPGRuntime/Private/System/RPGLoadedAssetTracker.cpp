@@ -0,0 +1,314 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "System/RPGLoadedAssetTracker.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace RPGLoadedAssetTracker
+{
+	// Older snapshots are dropped past this count
+	static constexpr int32 MaxStoredSnapshots = 16;
+
+	static double ToKB(int64 Bytes)
+	{
+		return (double)Bytes / 1024.0;
+	}
+
+	static double ToMB(int64 Bytes)
+	{
+		return (double)Bytes / (1024.0 * 1024.0);
+	}
+
+	static void AppendUnique(FString& List, const FString& Entry)
+	{
+		if (Entry.IsEmpty())
+		{
+			return;
+		}
+
+		TArray<FString> Entries;
+		List.ParseIntoArray(Entries, TEXT(";"));
+		if (!Entries.Contains(Entry))
+		{
+			List = List.IsEmpty() ? Entry : (List + TEXT(";") + Entry);
+		}
+	}
+
+	static FString FindExternalReferencers(const FSoftObjectPath& Path)
+	{
+		UObject* Object = Path.ResolveObject();
+		if (!Object)
+		{
+			return FString();
+		}
+
+		FReferencerInformationList References;
+		if (!IsReferenced(Object, RF_NoFlags, EInternalObjectFlags::None, true, &References))
+		{
+			return TEXT("None");
+		}
+
+		FString Result;
+		for (const FReferencerInformation& Reference : References.ExternalReferences)
+		{
+			AppendUnique(Result, GetPathNameSafe(Reference.Referencer));
+		}
+
+		return Result;
+	}
+};
+
+//////////////////////////////////////////////////////////////////////
+// FRPGLoadedAssetSnapshot
+
+int64 FRPGLoadedAssetSnapshot::GetTotalExclusiveBytes() const
+{
+	int64 Total = 0;
+	for (const FRPGLoadedAssetRecord& Record : Records)
+	{
+		Total += Record.ExclusiveBytes;
+	}
+	return Total;
+}
+
+int64 FRPGLoadedAssetSnapshot::GetTotalInclusiveBytes() const
+{
+	int64 Total = 0;
+	for (const FRPGLoadedAssetRecord& Record : Records)
+	{
+		Total += Record.InclusiveBytes;
+	}
+	return Total;
+}
+
+//////////////////////////////////////////////////////////////////////
+// FRPGLoadedAssetTracker
+
+void FRPGLoadedAssetTracker::TrackAsset(const UObject* Asset, const TCHAR* PinnedBy)
+{
+	if (!Asset)
+	{
+		return;
+	}
+
+	const FSoftObjectPath AssetPath(Asset);
+
+	FScopeLock Lock(&TrackedAssetsCritical);
+	FTrackedAsset& TrackedAsset = TrackedAssets.FindOrAdd(AssetPath);
+	TrackedAsset.Asset = Asset;
+	RPGLoadedAssetTracker::AppendUnique(TrackedAsset.PinnedBy, PinnedBy);
+}
+
+FRPGLoadedAssetSnapshot FRPGLoadedAssetTracker::Capture(const UAssetManager& AssetManager, const FString& SnapshotName, int32 NumReferencerSearches) const
+{
+	FRPGLoadedAssetSnapshot Snapshot;
+	Snapshot.Name = SnapshotName;
+	Snapshot.Time = FDateTime::Now();
+
+	TMap<FSoftObjectPath, int32> RecordIndexByPath;
+
+	const auto AddRecord = [&Snapshot, &RecordIndexByPath](const UObject* Asset, const FString& PinnedBy) -> FRPGLoadedAssetRecord&
+	{
+		const FSoftObjectPath AssetPath(Asset);
+		if (const int32* ExistingIndex = RecordIndexByPath.Find(AssetPath))
+		{
+			FRPGLoadedAssetRecord& Existing = Snapshot.Records[*ExistingIndex];
+			RPGLoadedAssetTracker::AppendUnique(Existing.PinnedBy, PinnedBy);
+			return Existing;
+		}
+
+		UObject* MutableAsset = const_cast<UObject*>(Asset);
+
+		FRPGLoadedAssetRecord& Record = Snapshot.Records.AddDefaulted_GetRef();
+		Record.Path = AssetPath;
+		Record.ClassName = Asset->GetClass()->GetFName();
+		Record.PinnedBy = PinnedBy;
+		Record.ExclusiveBytes = (int64)MutableAsset->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		Record.InclusiveBytes = (int64)MutableAsset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		RecordIndexByPath.Add(AssetPath, Snapshot.Records.Num() - 1);
+		return Record;
+	};
+
+	// Assets pinned through GetAsset, GetSubclass and the game data map
+	{
+		FScopeLock Lock(&TrackedAssetsCritical);
+		for (const TPair<FSoftObjectPath, FTrackedAsset>& Pair : TrackedAssets)
+		{
+			if (const UObject* Asset = Pair.Value.Asset.Get())
+			{
+				AddRecord(Asset, Pair.Value.PinnedBy);
+			}
+		}
+	}
+
+	// Loaded primary assets, with the bundles their asset manager handle currently holds
+	TArray<FPrimaryAssetTypeInfo> TypeInfos;
+	AssetManager.GetPrimaryAssetTypeInfoList(TypeInfos);
+	for (const FPrimaryAssetTypeInfo& TypeInfo : TypeInfos)
+	{
+		TArray<FPrimaryAssetId> PrimaryAssetIds;
+		AssetManager.GetPrimaryAssetIdList(FPrimaryAssetType(TypeInfo.PrimaryAssetType), PrimaryAssetIds);
+
+		for (const FPrimaryAssetId& PrimaryAssetId : PrimaryAssetIds)
+		{
+			const UObject* Asset = AssetManager.GetPrimaryAssetObject(PrimaryAssetId);
+			if (!Asset)
+			{
+				continue;
+			}
+
+			TArray<FName> Bundles;
+			const bool bHasHandle = AssetManager.GetPrimaryAssetHandle(PrimaryAssetId, false, &Bundles).IsValid();
+
+			FRPGLoadedAssetRecord& Record = AddRecord(Asset, bHasHandle ? TEXT("PrimaryAssetHandle") : TEXT("Unpinned"));
+			Record.PrimaryAssetId = PrimaryAssetId;
+			for (const FName& Bundle : Bundles)
+			{
+				RPGLoadedAssetTracker::AppendUnique(Record.Bundles, Bundle.ToString());
+			}
+		}
+	}
+
+	SortRecords(Snapshot.Records, ERPGLoadedAssetSort::Inclusive);
+
+	// Full reference searches are expensive, only run them for the biggest assets
+	const int32 NumSearches = FMath::Min(NumReferencerSearches, Snapshot.Records.Num());
+	for (int32 RecordIndex = 0; RecordIndex < NumSearches; ++RecordIndex)
+	{
+		Snapshot.Records[RecordIndex].Referencers = RPGLoadedAssetTracker::FindExternalReferencers(Snapshot.Records[RecordIndex].Path);
+	}
+
+	return Snapshot;
+}
+
+void FRPGLoadedAssetTracker::StoreSnapshot(FRPGLoadedAssetSnapshot&& Snapshot)
+{
+	Snapshots.RemoveAll([&Snapshot](const FRPGLoadedAssetSnapshot& Existing) { return Existing.Name == Snapshot.Name; });
+	Snapshots.Add(MoveTemp(Snapshot));
+
+	if (Snapshots.Num() > RPGLoadedAssetTracker::MaxStoredSnapshots)
+	{
+		Snapshots.RemoveAt(0, Snapshots.Num() - RPGLoadedAssetTracker::MaxStoredSnapshots);
+	}
+}
+
+const FRPGLoadedAssetSnapshot* FRPGLoadedAssetTracker::FindSnapshot(const FString& SnapshotName) const
+{
+	return Snapshots.FindByPredicate([&SnapshotName](const FRPGLoadedAssetSnapshot& Snapshot) { return Snapshot.Name == SnapshotName; });
+}
+
+void FRPGLoadedAssetTracker::SortRecords(TArray<FRPGLoadedAssetRecord>& Records, ERPGLoadedAssetSort SortMode)
+{
+	Records.Sort([SortMode](const FRPGLoadedAssetRecord& A, const FRPGLoadedAssetRecord& B)
+	{
+		if ((SortMode == ERPGLoadedAssetSort::Inclusive) && (A.InclusiveBytes != B.InclusiveBytes))
+		{
+			return A.InclusiveBytes > B.InclusiveBytes;
+		}
+
+		if ((SortMode != ERPGLoadedAssetSort::Name) && (A.ExclusiveBytes != B.ExclusiveBytes))
+		{
+			return A.ExclusiveBytes > B.ExclusiveBytes;
+		}
+
+		return A.Path.ToString() < B.Path.ToString();
+	});
+}
+
+void FRPGLoadedAssetTracker::WriteText(const FRPGLoadedAssetSnapshot& Snapshot, FOutputDevice& Ar)
+{
+	using namespace RPGLoadedAssetTracker;
+
+	Ar.Logf(TEXT("========== RPG Loaded Assets: %s (%s) =========="), *Snapshot.Name, *Snapshot.Time.ToString());
+	Ar.Logf(TEXT("%d assets  Inclusive: %.2f MB  Exclusive: %.2f MB"), Snapshot.Records.Num(), ToMB(Snapshot.GetTotalInclusiveBytes()), ToMB(Snapshot.GetTotalExclusiveBytes()));
+	Ar.Logf(TEXT("  %12s %12s  %-28s %s"), TEXT("Inclusive"), TEXT("Exclusive"), TEXT("Class"), TEXT("Asset [PinnedBy] {Bundles} <- Referencers"));
+
+	for (const FRPGLoadedAssetRecord& Record : Snapshot.Records)
+	{
+		Ar.Logf(TEXT("  %9.1f KB %9.1f KB  %-28s %s [%s]%s%s"),
+			ToKB(Record.InclusiveBytes), ToKB(Record.ExclusiveBytes), *Record.ClassName.ToString(), *Record.Path.ToString(), *Record.PinnedBy,
+			Record.Bundles.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(" {%s}"), *Record.Bundles),
+			Record.Referencers.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(" <- %s"), *Record.Referencers));
+	}
+
+	Ar.Logf(TEXT("========== ========== =========="));
+}
+
+FString FRPGLoadedAssetTracker::WriteCsv(const FRPGLoadedAssetSnapshot& Snapshot)
+{
+	FString Csv = TEXT("Asset,Class,PrimaryAssetId,InclusiveBytes,ExclusiveBytes,PinnedBy,Bundles,Referencers\n");
+	for (const FRPGLoadedAssetRecord& Record : Snapshot.Records)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%s,%lld,%lld,%s,%s,%s\n"),
+			*Record.Path.ToString(), *Record.ClassName.ToString(), Record.PrimaryAssetId.IsValid() ? *Record.PrimaryAssetId.ToString() : TEXT(""),
+			Record.InclusiveBytes, Record.ExclusiveBytes, *Record.PinnedBy, *Record.Bundles, *Record.Referencers);
+	}
+	return Csv;
+}
+
+void FRPGLoadedAssetTracker::WriteDiff(const FRPGLoadedAssetSnapshot& Before, const FRPGLoadedAssetSnapshot& After, FOutputDevice& Ar)
+{
+	using namespace RPGLoadedAssetTracker;
+
+	TMap<FSoftObjectPath, const FRPGLoadedAssetRecord*> BeforeByPath;
+	for (const FRPGLoadedAssetRecord& Record : Before.Records)
+	{
+		BeforeByPath.Add(Record.Path, &Record);
+	}
+
+	TArray<FRPGLoadedAssetRecord> Added;
+	TArray<TPair<const FRPGLoadedAssetRecord*, const FRPGLoadedAssetRecord*>> Changed;
+	for (const FRPGLoadedAssetRecord& Record : After.Records)
+	{
+		const FRPGLoadedAssetRecord* BeforeRecord = nullptr;
+		if (BeforeByPath.RemoveAndCopyValue(Record.Path, BeforeRecord))
+		{
+			if ((BeforeRecord->InclusiveBytes != Record.InclusiveBytes) || (BeforeRecord->Bundles != Record.Bundles))
+			{
+				Changed.Emplace(BeforeRecord, &Record);
+			}
+		}
+		else
+		{
+			Added.Add(Record);
+		}
+	}
+
+	TArray<FRPGLoadedAssetRecord> Removed;
+	for (const TPair<FSoftObjectPath, const FRPGLoadedAssetRecord*>& Pair : BeforeByPath)
+	{
+		Removed.Add(*Pair.Value);
+	}
+
+	SortRecords(Added, ERPGLoadedAssetSort::Inclusive);
+	SortRecords(Removed, ERPGLoadedAssetSort::Inclusive);
+
+	const int64 DeltaBytes = After.GetTotalInclusiveBytes() - Before.GetTotalInclusiveBytes();
+	Ar.Logf(TEXT("========== RPG Loaded Assets Diff: %s -> %s =========="), *Before.Name, *After.Name);
+	Ar.Logf(TEXT("Assets: %d -> %d  Inclusive: %.2f MB -> %.2f MB (%+.2f MB)"),
+		Before.Records.Num(), After.Records.Num(), ToMB(Before.GetTotalInclusiveBytes()), ToMB(After.GetTotalInclusiveBytes()), ToMB(DeltaBytes));
+
+	Ar.Logf(TEXT("Added (%d):"), Added.Num());
+	for (const FRPGLoadedAssetRecord& Record : Added)
+	{
+		Ar.Logf(TEXT("  + %9.1f KB  %s [%s]%s"), ToKB(Record.InclusiveBytes), *Record.Path.ToString(), *Record.PinnedBy,
+			Record.Bundles.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(" {%s}"), *Record.Bundles));
+	}
+
+	Ar.Logf(TEXT("Removed (%d):"), Removed.Num());
+	for (const FRPGLoadedAssetRecord& Record : Removed)
+	{
+		Ar.Logf(TEXT("  - %9.1f KB  %s"), ToKB(Record.InclusiveBytes), *Record.Path.ToString());
+	}
+
+	Ar.Logf(TEXT("Changed (%d):"), Changed.Num());
+	for (const TPair<const FRPGLoadedAssetRecord*, const FRPGLoadedAssetRecord*>& Pair : Changed)
+	{
+		Ar.Logf(TEXT("  ~ %+9.1f KB  %s {%s} -> {%s}"), ToKB(Pair.Value->InclusiveBytes - Pair.Key->InclusiveBytes), *Pair.Value->Path.ToString(), *Pair.Key->Bundles, *Pair.Value->Bundles);
+	}
+
+	Ar.Logf(TEXT("========== ========== =========="));
+}
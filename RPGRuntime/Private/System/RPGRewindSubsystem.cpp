@@ -0,0 +1,499 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "System/RPGRewindSubsystem.h"
+#include "Character/RPGCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "System/RPGLogChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGRewindSubsystem)
+
+DECLARE_STATS_GROUP(TEXT("RPG Rewind"), STATGROUP_RPGRewind, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RPGRewind Record"), STAT_RPGRewind_Record, STATGROUP_RPGRewind);
+DECLARE_CYCLE_STAT(TEXT("RPGRewind Validate"), STAT_RPGRewind_Validate, STATGROUP_RPGRewind);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tracked Characters"), STAT_RPGRewind_NumTracked, STATGROUP_RPGRewind);
+DECLARE_MEMORY_STAT(TEXT("History Memory"), STAT_RPGRewind_Memory, STATGROUP_RPGRewind);
+
+namespace RPGConsoleVariables
+{
+	static bool bRewindEnabled = true;
+	static FAutoConsoleVariableRef CVarRewindEnabled(
+		TEXT("rpg.rewind.Enabled"),
+		bRewindEnabled,
+		TEXT("Enables recording character history for server side hit validation."),
+		ECVF_Default);
+
+	static float RewindMaxTime = 0.5f;
+	static FAutoConsoleVariableRef CVarRewindMaxTime(
+		TEXT("rpg.rewind.MaxRewindTime"),
+		RewindMaxTime,
+		TEXT("Maximum number of seconds a target can be rewound. Older client timestamps are clamped."),
+		ECVF_Default);
+
+	static float RewindTolerance = 10.0f;
+	static FAutoConsoleVariableRef CVarRewindTolerance(
+		TEXT("rpg.rewind.Tolerance"),
+		RewindTolerance,
+		TEXT("Extra distance (cm) accepted when validating a sweep against a rewound target."),
+		ECVF_Default);
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpRPGRewind(
+	TEXT("RPG.DumpRewind"),
+	TEXT("Prints the tracked characters and the memory used by the rewind history."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const URPGRewindSubsystem* Subsystem = URPGRewindSubsystem::Get(World))
+		{
+			Subsystem->DumpToOutputDevice(Ar);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarBenchmarkRPGRewind(
+	TEXT("RPG.BenchmarkRewind"),
+	TEXT("Fills synthetic histories and times recording and validation. Usage: RPG.BenchmarkRewind [NumCharacters=200] [NumQueries=10000]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 NumCharacters = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 200);
+		const int32 NumQueries = FMath::Max(1, Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 10000);
+
+		const URPGRewindSubsystem* Subsystem = URPGRewindSubsystem::Get(World);
+		const int32 Capacity = Subsystem ? Subsystem->GetHistoryCapacity() : 61;
+		const float FrameInterval = 1.0f / 60.0f;
+
+		FRandomStream Random(1234);
+
+		TArray<FRPGRewindHistory> Histories;
+		Histories.SetNum(NumCharacters);
+		for (FRPGRewindHistory& History : Histories)
+		{
+			History.Init(Capacity);
+		}
+
+		// Two full passes so the second one measures the steady state (buffers wrapped, no allocations)
+		double RecordSeconds = 0.0;
+		int32 NumPushes = 0;
+		for (int32 Pass = 0; Pass < 2; ++Pass)
+		{
+			const double PassStart = FPlatformTime::Seconds();
+			for (int32 FrameIndex = 0; FrameIndex < Capacity; ++FrameIndex)
+			{
+				for (int32 CharacterIndex = 0; CharacterIndex < NumCharacters; ++CharacterIndex)
+				{
+					FRPGRewindFrame Frame;
+					Frame.Timestamp = (Pass * Capacity + FrameIndex) * FrameInterval;
+					Frame.CapsuleCenter = FVector3f(CharacterIndex * 200.0f + FrameIndex, Random.FRandRange(-50.0f, 50.0f), 90.0f);
+					Frame.CapsuleHalfHeight = 90.0f;
+					Frame.CapsuleRadius = 35.0f;
+					Frame.NumKeyBones = FRPGRewindFrame::MaxKeyBones;
+					for (int32 BoneIndex = 0; BoneIndex < FRPGRewindFrame::MaxKeyBones; ++BoneIndex)
+					{
+						Frame.KeyBoneLocations[BoneIndex] = Frame.CapsuleCenter + FVector3f(0.0f, 0.0f, BoneIndex * 30.0f - 45.0f);
+					}
+					Histories[CharacterIndex].Push(Frame);
+				}
+			}
+
+			if (Pass == 1)
+			{
+				RecordSeconds = FPlatformTime::Seconds() - PassStart;
+				NumPushes = Capacity * NumCharacters;
+			}
+		}
+
+		const float NewestTime = (2 * Capacity - 1) * FrameInterval;
+		int32 NumHits = 0;
+		const double QueryStart = FPlatformTime::Seconds();
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			const FRPGRewindHistory& History = Histories[Random.RandHelper(NumCharacters)];
+			const float Timestamp = NewestTime - Random.FRandRange(0.05f, 0.15f);
+			const FVector Start(Random.FRandRange(-100.0f, NumCharacters * 200.0f), -150.0f, 100.0f);
+			const FVector End = Start + FVector(0.0f, 300.0f, 0.0f);
+
+			FRPGRewindValidationResult Result;
+			if (URPGRewindSubsystem::ValidateSweepAgainstHistory(History, Timestamp, Start, End, 10.0f, 15.0f, 10.0f, Result) && Result.bHit)
+			{
+				++NumHits;
+			}
+		}
+		const double QuerySeconds = FPlatformTime::Seconds() - QueryStart;
+
+		SIZE_T TotalBytes = Histories.GetAllocatedSize();
+		for (const FRPGRewindHistory& History : Histories)
+		{
+			TotalBytes += History.GetAllocatedSize();
+		}
+
+		Ar.Logf(TEXT("RPG.BenchmarkRewind: %d characters x %d frames (%.2f s of history at 60 Hz)"), NumCharacters, Capacity, Capacity * FrameInterval);
+		Ar.Logf(TEXT("  Memory: %.1f KB total, %d bytes per frame, %.1f KB per character"),
+			TotalBytes / 1024.0, (int32)sizeof(FRPGRewindFrame), (TotalBytes / 1024.0) / NumCharacters);
+		Ar.Logf(TEXT("  Record: %.3f ms for %d pushes (%.1f ns per push)"), RecordSeconds * 1000.0, NumPushes, (RecordSeconds * 1.0e9) / FMath::Max(NumPushes, 1));
+		Ar.Logf(TEXT("  Validate: %.3f ms for %d queries (%.1f ns per query, %d hits)"), QuerySeconds * 1000.0, NumQueries, (QuerySeconds * 1.0e9) / NumQueries, NumHits);
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// FRPGRewindFrame
+
+FRPGRewindFrame FRPGRewindFrame::Lerp(const FRPGRewindFrame& A, const FRPGRewindFrame& B, float Alpha)
+{
+	FRPGRewindFrame Result;
+	Result.Timestamp = FMath::Lerp(A.Timestamp, B.Timestamp, Alpha);
+	Result.CapsuleCenter = FMath::Lerp(A.CapsuleCenter, B.CapsuleCenter, Alpha);
+	Result.CapsuleHalfHeight = FMath::Lerp(A.CapsuleHalfHeight, B.CapsuleHalfHeight, Alpha);
+	Result.CapsuleRadius = FMath::Lerp(A.CapsuleRadius, B.CapsuleRadius, Alpha);
+	Result.NumKeyBones = FMath::Min(A.NumKeyBones, B.NumKeyBones);
+	for (int32 BoneIndex = 0; BoneIndex < Result.NumKeyBones; ++BoneIndex)
+	{
+		Result.KeyBoneLocations[BoneIndex] = FMath::Lerp(A.KeyBoneLocations[BoneIndex], B.KeyBoneLocations[BoneIndex], Alpha);
+	}
+	return Result;
+}
+
+//////////////////////////////////////////////////////////////////////
+// FRPGRewindHistory
+
+void FRPGRewindHistory::Init(int32 InCapacity)
+{
+	Frames.SetNum(FMath::Max(InCapacity, 2));
+	Reset();
+}
+
+void FRPGRewindHistory::Reset()
+{
+	Head = 0;
+	NumFrames = 0;
+}
+
+void FRPGRewindHistory::Push(const FRPGRewindFrame& Frame)
+{
+	const int32 Capacity = Frames.Num();
+	if (Capacity == 0)
+	{
+		return;
+	}
+
+	if ((NumFrames > 0) && (Frame.Timestamp <= GetNewestTimestamp()))
+	{
+		return;
+	}
+
+	if (NumFrames < Capacity)
+	{
+		Frames[(Head + NumFrames) % Capacity] = Frame;
+		++NumFrames;
+	}
+	else
+	{
+		// Full, overwrite the oldest frame
+		Frames[Head] = Frame;
+		Head = (Head + 1) % Capacity;
+	}
+}
+
+bool FRPGRewindHistory::Sample(float Timestamp, FRPGRewindFrame& OutFrame) const
+{
+	if (NumFrames == 0)
+	{
+		return false;
+	}
+
+	if (Timestamp <= GetOldestTimestamp())
+	{
+		OutFrame = GetFrame(0);
+		return true;
+	}
+
+	if (Timestamp >= GetNewestTimestamp())
+	{
+		OutFrame = GetFrame(NumFrames - 1);
+		return true;
+	}
+
+	// Find the first frame newer than the timestamp
+	int32 Low = 1;
+	int32 High = NumFrames - 1;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (GetFrame(Mid).Timestamp > Timestamp)
+		{
+			High = Mid;
+		}
+		else
+		{
+			Low = Mid + 1;
+		}
+	}
+
+	const FRPGRewindFrame& Before = GetFrame(Low - 1);
+	const FRPGRewindFrame& After = GetFrame(Low);
+	const float Span = After.Timestamp - Before.Timestamp;
+	const float Alpha = (Span > UE_SMALL_NUMBER) ? (Timestamp - Before.Timestamp) / Span : 1.0f;
+
+	OutFrame = FRPGRewindFrame::Lerp(Before, After, Alpha);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// URPGRewindSubsystem
+
+URPGRewindSubsystem::URPGRewindSubsystem()
+{
+	KeyBones = { TEXT("head"), TEXT("hand_l"), TEXT("hand_r") };
+}
+
+URPGRewindSubsystem* URPGRewindSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<URPGRewindSubsystem>() : nullptr;
+}
+
+bool URPGRewindSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void URPGRewindSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (KeyBones.Num() > FRPGRewindFrame::MaxKeyBones)
+	{
+		UE_LOG(LogRPG, Warning, TEXT("URPGRewindSubsystem::Initialize: %d key bones configured, only the first %d are recorded."), KeyBones.Num(), FRPGRewindFrame::MaxKeyBones);
+		KeyBones.SetNum(FRPGRewindFrame::MaxKeyBones);
+	}
+}
+
+void URPGRewindSubsystem::Deinitialize()
+{
+	TrackedCharacters.Reset();
+	TrackedIndexByActor.Reset();
+	Histories.Reset();
+	FreeHistories.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId URPGRewindSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGRewindSubsystem, STATGROUP_Tickables);
+}
+
+bool URPGRewindSubsystem::IsTickable() const
+{
+	return RPGConsoleVariables::bRewindEnabled && (TrackedCharacters.Num() > 0);
+}
+
+int32 URPGRewindSubsystem::GetHistoryCapacity() const
+{
+	return FMath::CeilToInt(FMath::Max(HistoryDuration, 0.1f) * FMath::Max(MaxRecordRate, 1.0f)) + 1;
+}
+
+int32 URPGRewindSubsystem::AcquireHistory()
+{
+	if (FreeHistories.Num() > 0)
+	{
+		const int32 HistoryIndex = FreeHistories.Pop();
+		Histories[HistoryIndex].Reset();
+		return HistoryIndex;
+	}
+
+	const int32 HistoryIndex = Histories.AddDefaulted();
+	Histories[HistoryIndex].Init(GetHistoryCapacity());
+	return HistoryIndex;
+}
+
+void URPGRewindSubsystem::RegisterCharacter(ARPGCharacter* Character)
+{
+	if (!Character || !Character->HasAuthority() || (GetWorld()->GetNetMode() == NM_Standalone))
+	{
+		return;
+	}
+
+	if (TrackedIndexByActor.Contains(Character))
+	{
+		return;
+	}
+
+	FTrackedCharacter& Tracked = TrackedCharacters.AddDefaulted_GetRef();
+	Tracked.Character = Character;
+	Tracked.HistoryIndex = AcquireHistory();
+
+	TrackedIndexByActor.Add(Character, TrackedCharacters.Num() - 1);
+
+	SET_DWORD_STAT(STAT_RPGRewind_NumTracked, TrackedCharacters.Num());
+}
+
+void URPGRewindSubsystem::UnregisterCharacter(ARPGCharacter* Character)
+{
+	int32 TrackedIndex = INDEX_NONE;
+	if (!TrackedIndexByActor.RemoveAndCopyValue(Character, TrackedIndex))
+	{
+		return;
+	}
+
+	FreeHistories.Add(TrackedCharacters[TrackedIndex].HistoryIndex);
+
+	TrackedCharacters.RemoveAtSwap(TrackedIndex);
+	if (TrackedCharacters.IsValidIndex(TrackedIndex))
+	{
+		if (ARPGCharacter* MovedCharacter = TrackedCharacters[TrackedIndex].Character.Get())
+		{
+			TrackedIndexByActor.Add(MovedCharacter, TrackedIndex);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_RPGRewind_NumTracked, TrackedCharacters.Num());
+}
+
+void URPGRewindSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGRewind_Record);
+
+	const float WorldTime = GetWorld()->GetTimeSeconds();
+	for (FTrackedCharacter& Tracked : TrackedCharacters)
+	{
+		RecordCharacter(Tracked, WorldTime);
+	}
+
+	SET_MEMORY_STAT(STAT_RPGRewind_Memory, Histories.Num() * GetHistoryCapacity() * sizeof(FRPGRewindFrame));
+}
+
+void URPGRewindSubsystem::RecordCharacter(FTrackedCharacter& Tracked, float WorldTime)
+{
+	const ARPGCharacter* Character = Tracked.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	// Frames are always stamped with server world time, the clock ValidateSweep clamps against.
+	// Movement timestamps of autonomous proxies are in the client's clock and can't be mixed in.
+	// The schedule carries the remainder forward and accepts a little jitter, a server ticking at exactly
+	// MaxRecordRate records every frame instead of skipping the ones that land a hair early.
+	const float MinRecordInterval = 1.0f / FMath::Max(MaxRecordRate, 1.0f);
+	const float RecordTimeTolerance = 0.1f * MinRecordInterval;
+	if (WorldTime < (Tracked.NextRecordTime - RecordTimeTolerance))
+	{
+		return;
+	}
+
+	const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+	if (!Capsule)
+	{
+		return;
+	}
+
+	FRPGRewindFrame Frame;
+	Frame.Timestamp = WorldTime;
+	Frame.CapsuleCenter = FVector3f(Capsule->GetComponentLocation());
+	Frame.CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	Frame.CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+
+	if (const USkeletalMeshComponent* Mesh = Character->GetMesh())
+	{
+		for (const FName& BoneName : KeyBones)
+		{
+			const int32 BoneIndex = Mesh->GetBoneIndex(BoneName);
+			if (BoneIndex != INDEX_NONE)
+			{
+				Frame.KeyBoneLocations[Frame.NumKeyBones++] = FVector3f(Mesh->GetBoneLocation(BoneName));
+			}
+		}
+	}
+
+	Histories[Tracked.HistoryIndex].Push(Frame);
+
+	// Restart the schedule after a hitch (or the first frame) rather than recording a burst to catch up
+	Tracked.NextRecordTime += MinRecordInterval;
+	if (Tracked.NextRecordTime < WorldTime)
+	{
+		Tracked.NextRecordTime = WorldTime + MinRecordInterval;
+	}
+}
+
+bool URPGRewindSubsystem::ValidateSweep(const AActor* Target, float ClientTimestamp, const FVector& Start, const FVector& End, float SweepRadius, FRPGRewindValidationResult& OutResult) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGRewind_Validate);
+
+	++NumQueries;
+
+	const int32* TrackedIndex = TrackedIndexByActor.Find(Target);
+	if (!TrackedIndex)
+	{
+		++NumRejectedQueries;
+		return false;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float Timestamp = FMath::Clamp(ClientTimestamp, Now - RPGConsoleVariables::RewindMaxTime, Now);
+
+	const FRPGRewindHistory& History = Histories[TrackedCharacters[*TrackedIndex].HistoryIndex];
+	if (!ValidateSweepAgainstHistory(History, Timestamp, Start, End, SweepRadius, KeyBoneRadius, RPGConsoleVariables::RewindTolerance, OutResult))
+	{
+		++NumRejectedQueries;
+		return false;
+	}
+
+	return true;
+}
+
+bool URPGRewindSubsystem::ValidateSweepAgainstHistory(const FRPGRewindHistory& History, float Timestamp, const FVector& Start, const FVector& End, float SweepRadius, float BoneRadius, float Tolerance, FRPGRewindValidationResult& OutResult)
+{
+	FRPGRewindFrame Frame;
+	if (!History.Sample(Timestamp, Frame))
+	{
+		return false;
+	}
+
+	OutResult = FRPGRewindValidationResult();
+	OutResult.RewoundTimestamp = Frame.Timestamp;
+
+	// Capsule, as the distance between the sweep and the capsule's inner segment
+	const FVector Center(Frame.CapsuleCenter);
+	const FVector AxisExtent(0.0, 0.0, FMath::Max(Frame.CapsuleHalfHeight - Frame.CapsuleRadius, 0.0f));
+
+	FVector ClosestOnSweep;
+	FVector ClosestOnAxis;
+	FMath::SegmentDistToSegmentSafe(Start, End, Center - AxisExtent, Center + AxisExtent, ClosestOnSweep, ClosestOnAxis);
+
+	float BestDistance = FVector::Dist(ClosestOnSweep, ClosestOnAxis) - Frame.CapsuleRadius - SweepRadius;
+	OutResult.ClosestPoint = ClosestOnAxis;
+
+	// Key bones catch limbs sticking out of the capsule
+	for (int32 BoneIndex = 0; BoneIndex < Frame.NumKeyBones; ++BoneIndex)
+	{
+		const FVector BoneLocation(Frame.KeyBoneLocations[BoneIndex]);
+		const float BoneDistance = FMath::PointDistToSegment(BoneLocation, Start, End) - BoneRadius - SweepRadius;
+		if (BoneDistance < BestDistance)
+		{
+			BestDistance = BoneDistance;
+			OutResult.ClosestPoint = BoneLocation;
+		}
+	}
+
+	OutResult.Distance = FMath::Max(BestDistance, 0.0f);
+	OutResult.bHit = (BestDistance <= Tolerance);
+	return true;
+}
+
+void URPGRewindSubsystem::DumpToOutputDevice(FOutputDevice& Ar) const
+{
+	const int32 Capacity = GetHistoryCapacity();
+	const SIZE_T HistoryBytes = (SIZE_T)Histories.Num() * Capacity * sizeof(FRPGRewindFrame);
+
+	Ar.Logf(TEXT("RPGRewindSubsystem: %d tracked, %d pooled histories (%d free), %d frames each, %.1f KB"),
+		TrackedCharacters.Num(), Histories.Num(), FreeHistories.Num(), Capacity, HistoryBytes / 1024.0);
+	Ar.Logf(TEXT("  Queries: %d (%d rejected), max rewind %.2f s, tolerance %.1f"),
+		NumQueries, NumRejectedQueries, RPGConsoleVariables::RewindMaxTime, RPGConsoleVariables::RewindTolerance);
+
+	for (const FTrackedCharacter& Tracked : TrackedCharacters)
+	{
+		const FRPGRewindHistory& History = Histories[Tracked.HistoryIndex];
+		Ar.Logf(TEXT("  %s: %d frames [%.3f, %.3f]"), *GetNameSafe(Tracked.Character.Get()), History.Num(), History.GetOldestTimestamp(), History.GetNewestTimestamp());
+	}
+}
@@ -0,0 +1,511 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "System/RPGSignificanceSubsystem.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Character/RPGCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Perception/AIPerceptionComponent.h"
+#include "System/RPGGameplayTags.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGSignificanceSubsystem)
+
+DECLARE_STATS_GROUP(TEXT("RPG Significance"), STATGROUP_RPGSignificance, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RPGSignificance Update"), STAT_RPGSignificance_Update, STATGROUP_RPGSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tracked Characters"), STAT_RPGSignificance_NumTracked, STATGROUP_RPGSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Full Rate Characters"), STAT_RPGSignificance_NumFullRate, STATGROUP_RPGSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Budget Demotions"), STAT_RPGSignificance_BudgetDemotions, STATGROUP_RPGSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bucket Changes"), STAT_RPGSignificance_BucketChanges, STATGROUP_RPGSignificance);
+
+namespace RPGConsoleVariables
+{
+	static bool bSignificanceEnabled = true;
+	static FAutoConsoleVariableRef CVarSignificanceEnabled(
+		TEXT("rpg.significance.Enabled"),
+		bSignificanceEnabled,
+		TEXT("Enables throttling character update rates by significance."),
+		ECVF_Default);
+
+	static float SignificanceUpdateInterval = 0.25f;
+	static FAutoConsoleVariableRef CVarSignificanceUpdateInterval(
+		TEXT("rpg.significance.UpdateInterval"),
+		SignificanceUpdateInterval,
+		TEXT("Seconds between significance updates."),
+		ECVF_Default);
+
+	static int32 SignificanceMaxFullRate = 32;
+	static FAutoConsoleVariableRef CVarSignificanceMaxFullRate(
+		TEXT("rpg.significance.MaxFullRateCharacters"),
+		SignificanceMaxFullRate,
+		TEXT("Maximum number of non player characters allowed in the full rate bucket (0 = unlimited)."),
+		ECVF_Default);
+
+	static float SignificanceHysteresis = 0.1f;
+	static FAutoConsoleVariableRef CVarSignificanceHysteresis(
+		TEXT("rpg.significance.Hysteresis"),
+		SignificanceHysteresis,
+		TEXT("Score margin a character must drop below a bucket threshold before being demoted."),
+		ECVF_Default);
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpRPGSignificance(
+	TEXT("RPG.DumpSignificance"),
+	TEXT("Prints the significance bucket counters and every tracked character."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const URPGSignificanceSubsystem* Subsystem = URPGSignificanceSubsystem::Get(World))
+		{
+			Subsystem->DumpToOutputDevice(Ar);
+		}
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// URPGSignificanceSubsystem
+
+URPGSignificanceSubsystem::URPGSignificanceSubsystem()
+{
+	// Defaults, can be overridden from the Game ini
+	FRPGSignificanceBucketSettings& Full = Buckets.AddDefaulted_GetRef();
+	Full.MinScore = 1.2f;
+
+	FRPGSignificanceBucketSettings& Medium = Buckets.AddDefaulted_GetRef();
+	Medium.MinScore = 0.7f;
+	Medium.ActorTickInterval = 0.1f;
+	Medium.AIUpdateInterval = 0.1f;
+
+	FRPGSignificanceBucketSettings& Low = Buckets.AddDefaulted_GetRef();
+	Low.MinScore = 0.3f;
+	Low.ActorTickInterval = 0.2f;
+	Low.MovementTickInterval = 0.05f;
+	Low.AnimTickInterval = 0.066f;
+	Low.AIUpdateInterval = 0.25f;
+	Low.bEmitContextEffects = false;
+
+	FRPGSignificanceBucketSettings& Dormant = Buckets.AddDefaulted_GetRef();
+	Dormant.MinScore = 0.0f;
+	Dormant.ActorTickInterval = 0.5f;
+	Dormant.MovementTickInterval = 0.1f;
+	Dormant.AnimTickInterval = 0.2f;
+	Dormant.AIUpdateInterval = 0.5f;
+	Dormant.bEmitContextEffects = false;
+}
+
+URPGSignificanceSubsystem* URPGSignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<URPGSignificanceSubsystem>() : nullptr;
+}
+
+bool URPGSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void URPGSignificanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Native tags are not available when the CDO is constructed
+	if (CombatRelevanceTags.IsEmpty())
+	{
+		CombatRelevanceTags.AddTag(RPGGameplayTags::Status_Action_Combo);
+	}
+
+	if (Buckets.Num() == 0)
+	{
+		Buckets.AddDefaulted();
+	}
+	BucketCounts.SetNumZeroed(Buckets.Num());
+}
+
+void URPGSignificanceSubsystem::Deinitialize()
+{
+	Entries.Reset();
+	EntryIndexByActor.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId URPGSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void URPGSignificanceSubsystem::RegisterCharacter(ARPGCharacter* Character)
+{
+	if (!Character || EntryIndexByActor.Contains(Character))
+	{
+		return;
+	}
+
+	const int32 NewIndex = Entries.AddDefaulted();
+	FSignificanceEntry& NewEntry = Entries[NewIndex];
+	NewEntry.Character = Character;
+
+	FAuthoredTickIntervals& Authored = NewEntry.AuthoredIntervals;
+	Authored.Actor = Character->GetActorTickInterval();
+	if (const UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement())
+	{
+		Authored.Movement = MovementComponent->GetComponentTickInterval();
+	}
+	if (const USkeletalMeshComponent* Mesh = Character->GetMesh())
+	{
+		Authored.Anim = Mesh->GetComponentTickInterval();
+	}
+
+	EntryIndexByActor.Add(Character, NewIndex);
+}
+
+void URPGSignificanceSubsystem::UnregisterCharacter(ARPGCharacter* Character)
+{
+	int32 Index = INDEX_NONE;
+	if (!EntryIndexByActor.RemoveAndCopyValue(Character, Index))
+	{
+		return;
+	}
+
+	// Leave the character at full rate, it may be reused
+	if (Entries[Index].AppliedBucket > 0)
+	{
+		ApplyBucket(Character, Entries[Index], 0);
+	}
+
+	Entries.RemoveAtSwap(Index);
+	if (Entries.IsValidIndex(Index))
+	{
+		if (ARPGCharacter* MovedCharacter = Entries[Index].Character.Get())
+		{
+			EntryIndexByActor.Add(MovedCharacter, Index);
+		}
+	}
+}
+
+int32 URPGSignificanceSubsystem::GetSignificanceBucket(const AActor* Actor) const
+{
+	if (const int32* Index = EntryIndexByActor.Find(Actor))
+	{
+		return Entries[*Index].Bucket;
+	}
+	return 0;
+}
+
+bool URPGSignificanceSubsystem::ShouldEmitContextEffects(const AActor* Actor) const
+{
+	const int32 BucketIndex = GetSignificanceBucket(Actor);
+	return !Buckets.IsValidIndex(BucketIndex) || Buckets[BucketIndex].bEmitContextEffects;
+}
+
+bool URPGSignificanceSubsystem::ShouldEmitContextEffectsFor(const AActor* Actor)
+{
+	const URPGSignificanceSubsystem* Subsystem = Get(Actor);
+	return !Subsystem || Subsystem->ShouldEmitContextEffects(Actor);
+}
+
+void URPGSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastUpdate += DeltaTime;
+	if (TimeSinceLastUpdate < RPGConsoleVariables::SignificanceUpdateInterval)
+	{
+		return;
+	}
+	TimeSinceLastUpdate = 0.0f;
+
+	UpdateSignificance();
+}
+
+void URPGSignificanceSubsystem::GatherViewers(TArray<FViewerInfo>& OutViewers) const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC)
+		{
+			continue;
+		}
+
+		FViewerInfo Viewer;
+		float FOV = 90.0f;
+
+		if (PC->IsLocalController())
+		{
+			// Local players see through their camera
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(Viewer.Location, ViewRotation);
+			Viewer.Direction = ViewRotation.Vector();
+			Viewer.bIsLocalView = true;
+
+			if (PC->PlayerCameraManager)
+			{
+				FOV = PC->PlayerCameraManager->GetFOVAngle();
+			}
+		}
+		else if (const APawn* Pawn = PC->GetPawn())
+		{
+			// Remote players (dedicated/listen server) are approximated by their pawn and control rotation
+			Viewer.Location = Pawn->GetActorLocation();
+			Viewer.Direction = PC->GetControlRotation().Vector();
+		}
+		else
+		{
+			continue;
+		}
+
+		Viewer.CosHalfFOV = FMath::Cos(FMath::DegreesToRadians(FOV * 0.5f));
+		OutViewers.Add(Viewer);
+	}
+}
+
+float URPGSignificanceSubsystem::CalculateScore(const FSignificanceEntry& Entry, const TArray<FViewerInfo>& Viewers) const
+{
+	const ARPGCharacter* Character = Entry.Character.Get();
+	check(Character);
+
+	const FVector Location = Character->GetActorLocation();
+	const USkeletalMeshComponent* Mesh = Character->GetMesh();
+
+	float DistanceScore = 0.0f;
+	bool bOnScreen = false;
+
+	for (const FViewerInfo& Viewer : Viewers)
+	{
+		const FVector ToCharacter = Location - Viewer.Location;
+		const float Distance = ToCharacter.Size();
+
+		DistanceScore = FMath::Max(DistanceScore, 1.0f - FMath::Clamp(Distance / MaxSignificanceDistance, 0.0f, 1.0f));
+
+		if (!bOnScreen)
+		{
+			if (Viewer.bIsLocalView && Mesh)
+			{
+				bOnScreen = Mesh->WasRecentlyRendered(0.25f);
+			}
+			else if (Distance > KINDA_SMALL_NUMBER)
+			{
+				bOnScreen = (FVector::DotProduct(ToCharacter / Distance, Viewer.Direction) >= Viewer.CosHalfFOV);
+			}
+		}
+	}
+
+	float Score = DistanceScore;
+	if (bOnScreen)
+	{
+		Score += OnScreenBonus;
+	}
+	if (!CombatRelevanceTags.IsEmpty() && Character->HasAnyMatchingGameplayTags(CombatRelevanceTags))
+	{
+		Score += CombatBonus;
+	}
+
+	return Score;
+}
+
+int32 URPGSignificanceSubsystem::SelectBucket(float Score, int32 PreviousBucket) const
+{
+	int32 NewBucket = Buckets.Num() - 1;
+	for (int32 BucketIndex = 0; BucketIndex < Buckets.Num(); ++BucketIndex)
+	{
+		if (Score >= Buckets[BucketIndex].MinScore)
+		{
+			NewBucket = BucketIndex;
+			break;
+		}
+	}
+
+	// Hysteresis: only demote once the score is clearly below the current bucket
+	if (Buckets.IsValidIndex(PreviousBucket) && (NewBucket > PreviousBucket))
+	{
+		if (Score >= (Buckets[PreviousBucket].MinScore - RPGConsoleVariables::SignificanceHysteresis))
+		{
+			return PreviousBucket;
+		}
+	}
+
+	return NewBucket;
+}
+
+void URPGSignificanceSubsystem::UpdateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGSignificance_Update);
+
+	NumBudgetDemotions = 0;
+	NumBucketChanges = 0;
+	BucketCounts.Init(0, Buckets.Num());
+
+	if (!RPGConsoleVariables::bSignificanceEnabled)
+	{
+		// Restore full rate once when the feature is switched off
+		for (FSignificanceEntry& Entry : Entries)
+		{
+			Entry.Bucket = 0;
+			if (ARPGCharacter* Character = Entry.Character.Get(); Character && (Entry.AppliedBucket != 0))
+			{
+				ApplyBucket(Character, Entry, 0);
+				Entry.AppliedBucket = 0;
+			}
+		}
+		BucketCounts[0] = Entries.Num();
+		return;
+	}
+
+	TArray<FViewerInfo> Viewers;
+	GatherViewers(Viewers);
+
+	// Score and pick a bucket for everyone
+	TArray<int32, TInlineAllocator<64>> FullRateCandidates;
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		FSignificanceEntry& Entry = Entries[Index];
+		const ARPGCharacter* Character = Entry.Character.Get();
+		if (!Character)
+		{
+			continue;
+		}
+
+		Entry.bIsPlayerControlled = Character->IsPlayerControlled();
+		if (Entry.bIsPlayerControlled || Viewers.Num() == 0)
+		{
+			Entry.Score = TNumericLimits<float>::Max();
+			Entry.Bucket = 0;
+			continue;
+		}
+
+		Entry.Score = CalculateScore(Entry, Viewers);
+		Entry.Bucket = SelectBucket(Entry.Score, Entry.AppliedBucket);
+
+		if (Entry.Bucket == 0)
+		{
+			FullRateCandidates.Add(Index);
+		}
+	}
+
+	// Budget: keep only the best N non player characters at full rate. Characters already at full rate
+	// get the hysteresis margin so two close scores don't swap places every update
+	const int32 MaxFullRate = RPGConsoleVariables::SignificanceMaxFullRate;
+	if ((MaxFullRate > 0) && (FullRateCandidates.Num() > MaxFullRate) && Buckets.Num() > 1)
+	{
+		const float Hysteresis = RPGConsoleVariables::SignificanceHysteresis;
+		FullRateCandidates.Sort([this, Hysteresis](int32 A, int32 B)
+		{
+			const float ScoreA = Entries[A].Score + ((Entries[A].AppliedBucket == 0) ? Hysteresis : 0.0f);
+			const float ScoreB = Entries[B].Score + ((Entries[B].AppliedBucket == 0) ? Hysteresis : 0.0f);
+			return ScoreA > ScoreB;
+		});
+
+		for (int32 CandidateIndex = MaxFullRate; CandidateIndex < FullRateCandidates.Num(); ++CandidateIndex)
+		{
+			Entries[FullRateCandidates[CandidateIndex]].Bucket = 1;
+			++NumBudgetDemotions;
+		}
+	}
+
+	// Apply the changes
+	for (FSignificanceEntry& Entry : Entries)
+	{
+		ARPGCharacter* Character = Entry.Character.Get();
+		if (!Character)
+		{
+			continue;
+		}
+
+		++BucketCounts[Entry.Bucket];
+
+		if (Entry.Bucket != Entry.AppliedBucket)
+		{
+			ApplyBucket(Character, Entry, Entry.Bucket);
+			Entry.AppliedBucket = Entry.Bucket;
+			++NumBucketChanges;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_RPGSignificance_NumTracked, Entries.Num());
+	SET_DWORD_STAT(STAT_RPGSignificance_NumFullRate, BucketCounts[0]);
+	SET_DWORD_STAT(STAT_RPGSignificance_BudgetDemotions, NumBudgetDemotions);
+	SET_DWORD_STAT(STAT_RPGSignificance_BucketChanges, NumBucketChanges);
+}
+
+void URPGSignificanceSubsystem::ApplyBucket(ARPGCharacter* Character, FSignificanceEntry& Entry, int32 BucketIndex) const
+{
+	check(Character);
+	if (!Buckets.IsValidIndex(BucketIndex))
+	{
+		return;
+	}
+
+	const FRPGSignificanceBucketSettings& Settings = Buckets[BucketIndex];
+	FAuthoredTickIntervals& Authored = Entry.AuthoredIntervals;
+
+	// Bucket 0 puts back what the designer authored, lower buckets only ever slow the tick down
+	const bool bRestoreAuthored = (BucketIndex == 0);
+	auto SelectInterval = [bRestoreAuthored](float AuthoredInterval, float BucketInterval)
+	{
+		return bRestoreAuthored ? AuthoredInterval : FMath::Max(AuthoredInterval, BucketInterval);
+	};
+
+	Character->SetActorTickInterval(SelectInterval(Authored.Actor, Settings.ActorTickInterval));
+
+	// Player movement is driven by the owning client, never throttle it
+	if (!Character->IsPlayerControlled())
+	{
+		if (UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement())
+		{
+			MovementComponent->SetComponentTickInterval(SelectInterval(Authored.Movement, Settings.MovementTickInterval));
+		}
+	}
+
+	if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+	{
+		Mesh->SetComponentTickInterval(SelectInterval(Authored.Anim, Settings.AnimTickInterval));
+	}
+
+	if (AAIController* AIController = Cast<AAIController>(Character->GetController()))
+	{
+		UBrainComponent* Brain = AIController->GetBrainComponent();
+		UAIPerceptionComponent* Perception = AIController->GetPerceptionComponent();
+
+		if (Authored.AIController.Get() != AIController)
+		{
+			Authored.AIController = AIController;
+			Authored.AIControllerActor = AIController->GetActorTickInterval();
+			Authored.Brain = Brain ? Brain->GetComponentTickInterval() : 0.0f;
+			Authored.Perception = Perception ? Perception->GetComponentTickInterval() : 0.0f;
+		}
+
+		AIController->SetActorTickInterval(SelectInterval(Authored.AIControllerActor, Settings.AIUpdateInterval));
+
+		if (Brain)
+		{
+			Brain->SetComponentTickInterval(SelectInterval(Authored.Brain, Settings.AIUpdateInterval));
+		}
+
+		if (Perception)
+		{
+			Perception->SetComponentTickInterval(SelectInterval(Authored.Perception, Settings.AIUpdateInterval));
+		}
+	}
+}
+
+void URPGSignificanceSubsystem::DumpToOutputDevice(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("========== RPG Significance =========="));
+	Ar.Logf(TEXT("Enabled: %d  Tracked: %d  MaxFullRate: %d  BudgetDemotions: %d  BucketChanges: %d"),
+		RPGConsoleVariables::bSignificanceEnabled ? 1 : 0, Entries.Num(), RPGConsoleVariables::SignificanceMaxFullRate, NumBudgetDemotions, NumBucketChanges);
+
+	for (int32 BucketIndex = 0; BucketIndex < BucketCounts.Num(); ++BucketIndex)
+	{
+		Ar.Logf(TEXT("  Bucket %d: %d characters"), BucketIndex, BucketCounts[BucketIndex]);
+	}
+
+	for (const FSignificanceEntry& Entry : Entries)
+	{
+		Ar.Logf(TEXT("  %s  Score: %.2f  Bucket: %d%s"), *GetNameSafe(Entry.Character.Get()), (Entry.bIsPlayerControlled ? -1.0f : Entry.Score), Entry.Bucket, Entry.bIsPlayerControlled ? TEXT(" (player)") : TEXT(""));
+	}
+
+	Ar.Logf(TEXT("========== ========== =========="));
+}
@@ -0,0 +1,537 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "System/RPGSpatialHashSubsystem.h"
+#include "Character/RPGCharacter.h"
+#include "Character/RPGHealthComponent.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerState.h"
+#include "GenericTeamAgentInterface.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Teams/RPGTeamAgentInterface.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGSpatialHashSubsystem)
+
+DECLARE_STATS_GROUP(TEXT("RPG Spatial Hash"), STATGROUP_RPGSpatialHash, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RPGSpatialHash Update"), STAT_RPGSpatialHash_Update, STATGROUP_RPGSpatialHash);
+DECLARE_CYCLE_STAT(TEXT("RPGSpatialHash Query"), STAT_RPGSpatialHash_Query, STATGROUP_RPGSpatialHash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tracked Characters"), STAT_RPGSpatialHash_NumTracked, STATGROUP_RPGSpatialHash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cell Changes"), STAT_RPGSpatialHash_CellChanges, STATGROUP_RPGSpatialHash);
+
+namespace RPGConsoleVariables
+{
+	static float SpatialHashCellSize = 500.0f;
+	static FAutoConsoleVariableRef CVarSpatialHashCellSize(
+		TEXT("rpg.spatial.CellSize"),
+		SpatialHashCellSize,
+		TEXT("Size (cm) of a spatial hash cell. Changing it rebuilds the grid."),
+		ECVF_Default);
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpRPGSpatialHash(
+	TEXT("RPG.DumpSpatialHash"),
+	TEXT("Prints the spatial hash counters."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const URPGSpatialHashSubsystem* Subsystem = URPGSpatialHashSubsystem::Get(World))
+		{
+			Subsystem->DumpToOutputDevice(Ar);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarBenchmarkRPGSpatialHash(
+	TEXT("RPG.BenchmarkSpatialHash"),
+	TEXT("Times radius queries on a spatial hash against physics sphere overlaps over the same agents. Usage: RPG.BenchmarkSpatialHash [NumAgents=1000] [NumQueries=10000] [Radius=800]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumAgents = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 1000);
+		const int32 NumQueries = FMath::Max(1, Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 10000);
+		const float Radius = FMath::Max(1.0f, Args.IsValidIndex(2) ? FCString::Atof(*Args[2]) : 800.0f);
+
+		// Same density for any agent count, about one agent per 10m x 10m
+		const float HalfExtent = FMath::Sqrt((float)NumAgents) * 500.0f;
+		const FVector Origin(0.0, 0.0, 100000.0);
+
+		FRandomStream Random(1234);
+
+		TArray<FVector> Locations;
+		Locations.Reserve(NumAgents);
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			Locations.Add(Origin + FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0));
+		}
+
+		TArray<FVector> QueryCenters;
+		QueryCenters.Reserve(NumQueries);
+		for (int32 Index = 0; Index < NumQueries; ++Index)
+		{
+			QueryCenters.Add(Origin + FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0));
+		}
+
+		// Spatial hash
+		FRPGSpatialHashGrid Grid;
+		Grid.Init(RPGConsoleVariables::SpatialHashCellSize);
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			Grid.Insert(Index, Grid.GetCell(Locations[Index]));
+		}
+
+		const float RadiusSquared = FMath::Square(Radius);
+		int64 HashResults = 0;
+		const double HashStart = FPlatformTime::Seconds();
+		for (const FVector& Center : QueryCenters)
+		{
+			Grid.ForEachCandidate(Center, Radius, [&](int32 Id)
+			{
+				if (FVector::DistSquared2D(Locations[Id], Center) <= RadiusSquared)
+				{
+					++HashResults;
+				}
+			});
+		}
+		const double HashSeconds = FPlatformTime::Seconds() - HashStart;
+
+		// Physics, one query-only sphere per agent far above the level
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		TArray<AActor*> ProxyActors;
+		ProxyActors.Reserve(NumAgents);
+		for (const FVector& Location : Locations)
+		{
+			AActor* ProxyActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location), SpawnParams);
+			if (!ProxyActor)
+			{
+				continue;
+			}
+
+			USphereComponent* Sphere = NewObject<USphereComponent>(ProxyActor);
+			Sphere->InitSphereRadius(35.0f);
+			Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+			Sphere->SetCollisionObjectType(ECC_Pawn);
+			Sphere->SetCollisionResponseToAllChannels(ECR_Overlap);
+			ProxyActor->SetRootComponent(Sphere);
+			Sphere->RegisterComponent();
+			Sphere->SetWorldLocation(Location);
+			ProxyActors.Add(ProxyActor);
+		}
+
+		const FCollisionObjectQueryParams ObjectParams(ECC_Pawn);
+		const FCollisionShape QueryShape = FCollisionShape::MakeSphere(Radius);
+		TArray<FOverlapResult> Overlaps;
+		int64 OverlapResults = 0;
+		const double OverlapStart = FPlatformTime::Seconds();
+		for (const FVector& Center : QueryCenters)
+		{
+			Overlaps.Reset();
+			World->OverlapMultiByObjectType(Overlaps, Center, FQuat::Identity, ObjectParams, QueryShape);
+			OverlapResults += Overlaps.Num();
+		}
+		const double OverlapSeconds = FPlatformTime::Seconds() - OverlapStart;
+
+		for (AActor* ProxyActor : ProxyActors)
+		{
+			ProxyActor->Destroy();
+		}
+
+		Ar.Logf(TEXT("RPG.BenchmarkSpatialHash: %d agents, %d radius queries of %.0f cm, cell size %.0f cm"), NumAgents, NumQueries, Radius, Grid.GetCellSize());
+		Ar.Logf(TEXT("  Spatial hash: %.3f ms total, %.2f us per query, %lld results (%d cells)"), HashSeconds * 1000.0, (HashSeconds * 1.0e6) / NumQueries, HashResults, Grid.GetNumCells());
+		Ar.Logf(TEXT("  Physics overlap: %.3f ms total, %.2f us per query, %lld results"), OverlapSeconds * 1000.0, (OverlapSeconds * 1.0e6) / NumQueries, OverlapResults);
+		Ar.Logf(TEXT("  Speedup: %.1fx"), (HashSeconds > 0.0) ? (OverlapSeconds / HashSeconds) : 0.0);
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// FRPGSpatialHashGrid
+
+void FRPGSpatialHashGrid::Init(float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	InvCellSize = 1.0f / CellSize;
+	Cells.Reset();
+}
+
+void FRPGSpatialHashGrid::Reset()
+{
+	Cells.Reset();
+}
+
+FIntPoint FRPGSpatialHashGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+}
+
+void FRPGSpatialHashGrid::Insert(int32 Id, const FIntPoint& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(Id);
+}
+
+void FRPGSpatialHashGrid::Remove(int32 Id, const FIntPoint& Cell)
+{
+	if (TArray<int32>* Ids = Cells.Find(Cell))
+	{
+		Ids->RemoveSingleSwap(Id);
+		if (Ids->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void FRPGSpatialHashGrid::Move(int32 Id, const FIntPoint& FromCell, const FIntPoint& ToCell)
+{
+	if (FromCell != ToCell)
+	{
+		Remove(Id, FromCell);
+		Insert(Id, ToCell);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// URPGSpatialHashSubsystem
+
+URPGSpatialHashSubsystem* URPGSpatialHashSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<URPGSpatialHashSubsystem>() : nullptr;
+}
+
+bool URPGSpatialHashSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void URPGSpatialHashSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Grid.Init(RPGConsoleVariables::SpatialHashCellSize);
+}
+
+void URPGSpatialHashSubsystem::Deinitialize()
+{
+	TArray<UObject*> TeamSources;
+	for (const FAgent& Agent : Agents)
+	{
+		TeamSources.AddUnique(Agent.TeamSource.Get());
+	}
+
+	Grid.Reset();
+	Agents.Empty();
+	AgentIdByActor.Reset();
+
+	for (UObject* TeamSource : TeamSources)
+	{
+		UnbindTeamSource(TeamSource);
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId URPGSpatialHashSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGSpatialHashSubsystem, STATGROUP_Tickables);
+}
+
+UObject* URPGSpatialHashSubsystem::FindTeamSource(const ARPGCharacter* Character)
+{
+	if (!Character)
+	{
+		return nullptr;
+	}
+
+	if (Cast<IGenericTeamAgentInterface>(Character))
+	{
+		return const_cast<ARPGCharacter*>(Character);
+	}
+
+	// The player state before the controller, the player controller only forwards its team and the player state broadcasts changes
+	if (Cast<IGenericTeamAgentInterface>(Character->GetPlayerState()))
+	{
+		return Character->GetPlayerState();
+	}
+
+	if (Cast<IGenericTeamAgentInterface>(Character->GetController()))
+	{
+		return Character->GetController();
+	}
+
+	return nullptr;
+}
+
+int32 URPGSpatialHashSubsystem::ResolveTeamId(const ARPGCharacter* Character)
+{
+	if (const IGenericTeamAgentInterface* TeamAgent = Cast<IGenericTeamAgentInterface>(FindTeamSource(Character)))
+	{
+		return GenericTeamIdToInteger(TeamAgent->GetGenericTeamId());
+	}
+
+	return INDEX_NONE;
+}
+
+void URPGSpatialHashSubsystem::UpdateAgentTeam(FAgent& Agent)
+{
+	UObject* NewTeamSource = FindTeamSource(Agent.Character.Get());
+	UObject* OldTeamSource = Agent.TeamSource.Get();
+
+	Agent.TeamSource = NewTeamSource;
+	Agent.TeamId = ResolveTeamId(Agent.Character.Get());
+
+	if (NewTeamSource == OldTeamSource)
+	{
+		return;
+	}
+
+	UnbindTeamSource(OldTeamSource);
+
+	if (IRPGTeamAgentInterface* TeamAgent = Cast<IRPGTeamAgentInterface>(NewTeamSource))
+	{
+		if (FOnRPGTeamIndexChangedDelegate* TeamChangedDelegate = TeamAgent->GetOnTeamIndexChangedDelegate())
+		{
+			TeamChangedDelegate->AddUniqueDynamic(this, &ThisClass::HandleTeamChanged);
+		}
+	}
+}
+
+void URPGSpatialHashSubsystem::UnbindTeamSource(UObject* TeamSource)
+{
+	IRPGTeamAgentInterface* TeamAgent = Cast<IRPGTeamAgentInterface>(TeamSource);
+	FOnRPGTeamIndexChangedDelegate* TeamChangedDelegate = TeamAgent ? TeamAgent->GetOnTeamIndexChangedDelegate() : nullptr;
+	if (!TeamChangedDelegate)
+	{
+		return;
+	}
+
+	// A player state can briefly back two agents (e.g. a parked pawn and its replacement)
+	for (const FAgent& Agent : Agents)
+	{
+		if (Agent.TeamSource.Get() == TeamSource)
+		{
+			return;
+		}
+	}
+
+	TeamChangedDelegate->RemoveDynamic(this, &ThisClass::HandleTeamChanged);
+}
+
+void URPGSpatialHashSubsystem::HandleTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID)
+{
+	for (FAgent& Agent : Agents)
+	{
+		if (Agent.TeamSource.Get() == ObjectChangingTeam)
+		{
+			Agent.TeamId = NewTeamID;
+		}
+	}
+}
+
+void URPGSpatialHashSubsystem::RegisterCharacter(ARPGCharacter* Character)
+{
+	if (!Character || AgentIdByActor.Contains(Character))
+	{
+		return;
+	}
+
+	FAgent Agent;
+	Agent.Character = Character;
+	Agent.HealthComponent = URPGHealthComponent::FindHealthComponent(Character);
+	Agent.Location = Character->GetActorLocation();
+	Agent.Cell = Grid.GetCell(Agent.Location);
+
+	const int32 AgentId = Agents.Add(Agent);
+	Grid.Insert(AgentId, Agent.Cell);
+	AgentIdByActor.Add(Character, AgentId);
+
+	UpdateAgentTeam(Agents[AgentId]);
+
+	SET_DWORD_STAT(STAT_RPGSpatialHash_NumTracked, Agents.Num());
+}
+
+void URPGSpatialHashSubsystem::UnregisterCharacter(ARPGCharacter* Character)
+{
+	int32 AgentId = INDEX_NONE;
+	if (!AgentIdByActor.RemoveAndCopyValue(Character, AgentId))
+	{
+		return;
+	}
+
+	UObject* TeamSource = Agents[AgentId].TeamSource.Get();
+
+	Grid.Remove(AgentId, Agents[AgentId].Cell);
+	Agents.RemoveAt(AgentId);
+
+	UnbindTeamSource(TeamSource);
+
+	SET_DWORD_STAT(STAT_RPGSpatialHash_NumTracked, Agents.Num());
+}
+
+void URPGSpatialHashSubsystem::RefreshCharacterTeam(ARPGCharacter* Character)
+{
+	if (const int32* AgentId = AgentIdByActor.Find(Character))
+	{
+		UpdateAgentTeam(Agents[*AgentId]);
+	}
+}
+
+void URPGSpatialHashSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGSpatialHash_Update);
+
+	if (!FMath::IsNearlyEqual(Grid.GetCellSize(), FMath::Max(RPGConsoleVariables::SpatialHashCellSize, 1.0f)))
+	{
+		Grid.Init(RPGConsoleVariables::SpatialHashCellSize);
+		for (auto It = Agents.CreateIterator(); It; ++It)
+		{
+			It->Cell = Grid.GetCell(It->Location);
+			Grid.Insert(It.GetIndex(), It->Cell);
+		}
+	}
+
+	int32 CellChangesThisFrame = 0;
+	for (auto It = Agents.CreateIterator(); It; ++It)
+	{
+		FAgent& Agent = *It;
+		const ARPGCharacter* Character = Agent.Character.Get();
+		if (!Character)
+		{
+			continue;
+		}
+
+		Agent.Location = Character->GetActorLocation();
+
+		// Only touch the grid when the character crossed into another cell
+		const FIntPoint NewCell = Grid.GetCell(Agent.Location);
+		if (NewCell != Agent.Cell)
+		{
+			Grid.Move(It.GetIndex(), Agent.Cell, NewCell);
+			Agent.Cell = NewCell;
+			++CellChangesThisFrame;
+		}
+	}
+
+	NumCellChanges += CellChangesThisFrame;
+	SET_DWORD_STAT(STAT_RPGSpatialHash_CellChanges, CellChangesThisFrame);
+}
+
+bool URPGSpatialHashSubsystem::PassesFilter(const FAgent& Agent, const FRPGSpatialQueryFilter& Filter) const
+{
+	const ARPGCharacter* Character = Agent.Character.Get();
+	if (!Character || (Character == Filter.IgnoredActor))
+	{
+		return false;
+	}
+
+	if (Filter.bAliveOnly)
+	{
+		const URPGHealthComponent* HealthComponent = Agent.HealthComponent.Get();
+		if (HealthComponent && HealthComponent->IsDeadOrDying())
+		{
+			return false;
+		}
+	}
+
+	switch (Filter.TeamFilter)
+	{
+	case ERPGSpatialTeamFilter::SameTeam:
+		return (Filter.TeamId != INDEX_NONE) && (Agent.TeamId == Filter.TeamId);
+	case ERPGSpatialTeamFilter::OtherTeams:
+		return (Agent.TeamId != Filter.TeamId);
+	default:
+		return true;
+	}
+}
+
+void URPGSpatialHashSubsystem::QueryRadius(const FVector& Center, float Radius, const FRPGSpatialQueryFilter& Filter, TArray<ARPGCharacter*>& OutCharacters) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGSpatialHash_Query);
+	++NumQueries;
+
+	const float RadiusSquared = FMath::Square(Radius);
+	Grid.ForEachCandidate(Center, Radius, [&](int32 AgentId)
+	{
+		const FAgent& Agent = Agents[AgentId];
+		if ((FVector::DistSquared2D(Agent.Location, Center) <= RadiusSquared) && PassesFilter(Agent, Filter))
+		{
+			OutCharacters.Add(Agent.Character.Get());
+		}
+	});
+}
+
+void URPGSpatialHashSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, const FRPGSpatialQueryFilter& Filter, TArray<ARPGCharacter*>& OutCharacters) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGSpatialHash_Query);
+	++NumQueries;
+
+	const FVector Forward = Direction.GetSafeNormal2D();
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+	const float RadiusSquared = FMath::Square(Radius);
+
+	Grid.ForEachCandidate(Origin, Radius, [&](int32 AgentId)
+	{
+		const FAgent& Agent = Agents[AgentId];
+		const FVector ToAgent = (Agent.Location - Origin) * FVector(1.0, 1.0, 0.0);
+		const float DistanceSquared = ToAgent.SizeSquared();
+		if (DistanceSquared > RadiusSquared)
+		{
+			return;
+		}
+
+		// An agent standing on the origin is always inside the cone
+		const bool bInCone = (DistanceSquared < UE_KINDA_SMALL_NUMBER) || ((ToAgent | Forward) >= CosHalfAngle * FMath::Sqrt(DistanceSquared));
+		if (bInCone && PassesFilter(Agent, Filter))
+		{
+			OutCharacters.Add(Agent.Character.Get());
+		}
+	});
+}
+
+void URPGSpatialHashSubsystem::QueryNearest(const FVector& Center, float MaxRadius, int32 Count, const FRPGSpatialQueryFilter& Filter, TArray<ARPGCharacter*>& OutCharacters) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGSpatialHash_Query);
+	++NumQueries;
+
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	struct FCandidate
+	{
+		float DistanceSquared;
+		int32 AgentId;
+	};
+
+	TArray<FCandidate, TInlineAllocator<32>> Candidates;
+	const float RadiusSquared = FMath::Square(MaxRadius);
+
+	Grid.ForEachCandidate(Center, MaxRadius, [&](int32 AgentId)
+	{
+		const FAgent& Agent = Agents[AgentId];
+		const float DistanceSquared = FVector::DistSquared2D(Agent.Location, Center);
+		if ((DistanceSquared <= RadiusSquared) && PassesFilter(Agent, Filter))
+		{
+			Candidates.Add({ DistanceSquared, AgentId });
+		}
+	});
+
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistanceSquared < B.DistanceSquared; });
+
+	const int32 NumResults = FMath::Min(Count, Candidates.Num());
+	for (int32 Index = 0; Index < NumResults; ++Index)
+	{
+		OutCharacters.Add(Agents[Candidates[Index].AgentId].Character.Get());
+	}
+}
+
+void URPGSpatialHashSubsystem::DumpToOutputDevice(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("RPGSpatialHashSubsystem: %d characters in %d cells of %.0f cm, %d cell changes, %d queries"),
+		Agents.Num(), Grid.GetNumCells(), Grid.GetCellSize(), NumCellChanges, NumQueries);
+}
@@ -1,6 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Teams/RPGTeamAgentInterface.h"
+#include "System/RPGLogChannels.h"
+#include "UObject/ScriptInterface.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGTeamAgentInterface)
 
@@ -18,3 +20,17 @@ FGenericTeamId IntegerToGenericTeamId(int32 ID)
 {
 	return (ID == INDEX_NONE) ? FGenericTeamId::NoTeam : FGenericTeamId((uint8)ID);
 }
+
+void IRPGTeamAgentInterface::ConditionalBroadcastTeamChanged(TScriptInterface<IRPGTeamAgentInterface> This, FGenericTeamId OldTeamID, FGenericTeamId NewTeamID)
+{
+	if (OldTeamID != NewTeamID)
+	{
+		const int32 OldTeamIndex = GenericTeamIdToInteger(OldTeamID);
+		const int32 NewTeamIndex = GenericTeamIdToInteger(NewTeamID);
+
+		UObject* ThisObj = This.GetObject();
+		UE_LOG(LogRPG, Verbose, TEXT("IRPGTeamAgentInterface: %s assigned team %d"), *GetPathNameSafe(ThisObj), NewTeamIndex);
+
+		This.GetInterface()->GetTeamChangedDelegateChecked().Broadcast(ThisObj, OldTeamIndex, NewTeamIndex);
+	}
+}
@@ -2,10 +2,14 @@
 
 #include "UI/RPGHealthBar.h"
 #include "Character/RPGHealthComponent.h"
+#include "UI/RPGUITweenSubsystem.h"
 
 #include "Components/Image.h"
 #include "CommonNumericTextBlock.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include "Animation/WidgetAnimation.h"
 
@@ -21,7 +25,6 @@ const FName URPGHealthBar::Param_DamageOrHealing(TEXT("DamageOrHealing"));
 URPGHealthBar::URPGHealthBar(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	bHasScriptImplementedTick = true; // Cho phép Tick thủ công
 }
 
 void URPGHealthBar::NativeConstruct()
@@ -31,14 +34,21 @@ void URPGHealthBar::NativeConstruct()
 	SetDynamicMaterials();
 	ResetAnimatedState();
 
-	if (APlayerController* PC = GetOwningPlayer())
+	if (bFollowPossessedPawn)
+	{
+		if (APlayerController* PC = GetOwningPlayer())
+		{
+			PC->OnPossessedPawnChanged.AddDynamic(this, &ThisClass::HandlePossessedPawnChanged);
+			HandlePossessedPawnChanged(nullptr, PC->GetPawn());
+		}
+	}
+	else
 	{
-		PC->OnPossessedPawnChanged.AddDynamic(this, &ThisClass::HandlePossessedPawnChanged);
-		HandlePossessedPawnChanged(nullptr, PC->GetPawn());
+		// Rebind the component given by SetHealthComponent, the widget may have been reconstructed
+		BindHealthComponent(CurrentHealthComponent);
 	}
 
 	InitializeBarVisuals();
-	bIsAnimating = false; // Mặc định không chạy nội suy
 }
 
 void URPGHealthBar::NativeDestruct()
@@ -48,49 +58,36 @@ void URPGHealthBar::NativeDestruct()
 		PC->OnPossessedPawnChanged.RemoveAll(this);
 	}
 
+	if (URPGUITweenSubsystem* TweenSubsystem = URPGUITweenSubsystem::Get(this))
+	{
+		TweenSubsystem->StopTween(this);
+	}
+
 	if (CurrentHealthComponent)
 	{
 		CurrentHealthComponent->OnHealthChangedDelegate.RemoveAll(this);
-		CurrentHealthComponent = nullptr;
+		if (bFollowPossessedPawn)
+		{
+			CurrentHealthComponent = nullptr;
+		}
 	}
 
 	Super::NativeDestruct();
 }
 
-void URPGHealthBar::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void URPGHealthBar::SetHealthComponent(URPGHealthComponent* InHealthComponent)
 {
-	Super::NativeTick(MyGeometry, InDeltaTime);
-
-	if (!bIsAnimating)
+	if (bFollowPossessedPawn)
 	{
-		return;
-	}
+		bFollowPossessedPawn = false;
 
-	if (CurrentAnimationWaitTimer > 0.0f)
-	{
-		CurrentAnimationWaitTimer -= InDeltaTime;
-		// Even during delay, we call UpdateVisuals to ensure the main bar snaps 
-		// if it hasn't already (though UpdateHealthBar calls it once).
-		UpdateVisuals(CurrentVisualHealthNorm);
-		return;
+		if (APlayerController* PC = GetOwningPlayer())
+		{
+			PC->OnPossessedPawnChanged.RemoveAll(this);
+		}
 	}
 
-	CurrentVisualHealthNorm = FMath::FInterpTo(
-		CurrentVisualHealthNorm,
-		TargetHealthNorm,
-		InDeltaTime,
-		VisualInterpSpeed
-	);
-
-	UpdateVisuals(CurrentVisualHealthNorm);
-
-	if (FMath::IsNearlyEqual(CurrentVisualHealthNorm, TargetHealthNorm, 0.001f))
-	{
-		CurrentVisualHealthNorm = TargetHealthNorm;
-		UpdateVisuals(CurrentVisualHealthNorm);
-
-		bIsAnimating = false;
-	}
+	BindHealthComponent(InHealthComponent);
 }
 
 /* =========================
@@ -101,24 +98,19 @@ void URPGHealthBar::UpdateHealthBar(float OldValueNorm, float NewValueNorm, bool
 {
 	TargetHealthNorm = NewValueNorm;
 
-	if (bSnap)
+	URPGUITweenSubsystem* TweenSubsystem = URPGUITweenSubsystem::Get(this);
+	if (bSnap || !TweenSubsystem)
 	{
+		if (TweenSubsystem)
+		{
+			TweenSubsystem->StopTween(this);
+		}
+
 		CurrentVisualHealthNorm = NewValueNorm;
 		UpdateVisuals(NewValueNorm);
-		bIsAnimating = false;
 		return;
 	}
 
-	bIsAnimating = true;
-	CurrentAnimationWaitTimer = AnimationDelay;
-
-	// "Ghost Bar" Logic: 
-	// - Health_Current (Visual): Should temporarily stay at the old value during delay
-	// - Health_Updated (Target): Represents the new real health immediately
-	
-	// Initial update to snap the main bar (Health_Updated)
-	UpdateVisuals(CurrentVisualHealthNorm);
-
 	// Detect Damage vs Healing
 	if (NewValueNorm < OldValueNorm)
 	{
@@ -129,8 +121,15 @@ void URPGHealthBar::UpdateHealthBar(float OldValueNorm, float NewValueNorm, bool
 		CurrentDamageOrHealingState = 1.0f; // Healing
 	}
 
+	// "Ghost Bar" Logic: 
+	// - Health_Current (Visual): Should temporarily stay at the old value during delay
+	// - Health_Updated (Target): Represents the new real health immediately
 	UpdateVisuals(CurrentVisualHealthNorm);
 
+	// The ghost bar slides to the target after the delay, then the bar is idle again
+	TweenSubsystem->PlayTween(this, CurrentVisualHealthNorm, NewValueNorm, VisualInterpSpeed, AnimationDelay,
+		FRPGUITweenUpdate::CreateUObject(this, &ThisClass::HandleVisualHealthChanged));
+
 	// Death
 	if (NewValueNorm <= 0.0f)
 	{
@@ -144,13 +143,22 @@ void URPGHealthBar::UpdateVisuals(float VisualValueNorm)
 	// - Health_Updated: The actual/target value (TargetHealthNorm)
 	// - DamageOrHealing: -1.0 for Damage (Red), 1.0 for Healing (Green/Blue)
 	
-	for (UMaterialInstanceDynamic* MID : { BarFillMID.Get(), BarBorderMID.Get(), BarGlowMID.Get() })
+	if (ParameterCollectionInstance)
 	{
-		if (MID)
+		ParameterCollectionInstance->SetScalarParameterValue(Param_HealthCurrent, VisualValueNorm);
+		ParameterCollectionInstance->SetScalarParameterValue(Param_HealthUpdated, TargetHealthNorm);
+		ParameterCollectionInstance->SetScalarParameterValue(Param_DamageOrHealing, CurrentDamageOrHealingState);
+	}
+	else
+	{
+		for (UMaterialInstanceDynamic* MID : { BarFillMID.Get(), BarBorderMID.Get(), BarGlowMID.Get() })
 		{
-			MID->SetScalarParameterValue(Param_HealthCurrent, VisualValueNorm);
-			MID->SetScalarParameterValue(Param_HealthUpdated, TargetHealthNorm);
-			MID->SetScalarParameterValue(Param_DamageOrHealing, CurrentDamageOrHealingState);
+			if (MID)
+			{
+				MID->SetScalarParameterValue(Param_HealthCurrent, VisualValueNorm);
+				MID->SetScalarParameterValue(Param_HealthUpdated, TargetHealthNorm);
+				MID->SetScalarParameterValue(Param_DamageOrHealing, CurrentDamageOrHealingState);
+			}
 		}
 	}
 
@@ -169,7 +177,11 @@ void URPGHealthBar::UpdateVisuals(float VisualValueNorm)
 			bShowGlow = (VisualValueNorm < TargetHealthNorm - 0.001f);
 		}
 
-		BarGlow->SetVisibility(bShowGlow ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Collapsed);
+		const ESlateVisibility GlowVisibility = bShowGlow ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Collapsed;
+		if (BarGlow->GetVisibility() != GlowVisibility)
+		{
+			BarGlow->SetVisibility(GlowVisibility);
+		}
 	}
 
 	if (HealthNumber)
@@ -185,10 +197,13 @@ void URPGHealthBar::InitializeBarVisuals()
 		? CurrentHealthComponent->GetHealthNormalized()
 		: 1.0f;
 
-	CurrentVisualHealthNorm = HealthNorm;
-	TargetHealthNorm = HealthNorm;
+	UpdateHealthBar(HealthNorm, HealthNorm, true);
+}
 
-	UpdateVisuals(HealthNorm);
+void URPGHealthBar::HandleVisualHealthChanged(float VisualValueNorm)
+{
+	CurrentVisualHealthNorm = VisualValueNorm;
+	UpdateVisuals(VisualValueNorm);
 }
 
 /* =========================
@@ -214,6 +229,20 @@ UMaterialInstanceDynamic* URPGHealthBar::CreateAndAssignMID(
 
 void URPGHealthBar::SetDynamicMaterials()
 {
+	// Bars reading a shared collection don't need their own material instances
+	if (ParameterCollection)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			ParameterCollectionInstance = World->GetParameterCollectionInstance(ParameterCollection);
+		}
+
+		if (ParameterCollectionInstance)
+		{
+			return;
+		}
+	}
+
 	BarFillMID = CreateAndAssignMID(BarFill, BarFillMID);
 	BarBorderMID = CreateAndAssignMID(BarBorder, BarBorderMID);
 	BarGlowMID = CreateAndAssignMID(BarGlow, BarGlowMID);
@@ -229,6 +258,11 @@ void URPGHealthBar::ResetAnimatedState()
  * ========================= */
 
 void URPGHealthBar::HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
+{
+	BindHealthComponent(URPGHealthComponent::FindHealthComponent(NewPawn));
+}
+
+void URPGHealthBar::BindHealthComponent(URPGHealthComponent* HealthComponent)
 {
 	if (CurrentHealthComponent)
 	{
@@ -236,19 +270,21 @@ void URPGHealthBar::HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
 		CurrentHealthComponent = nullptr;
 	}
 
-	if (NewPawn)
+	if (URPGUITweenSubsystem* TweenSubsystem = URPGUITweenSubsystem::Get(this))
 	{
-		if (URPGHealthComponent* HealthComp = URPGHealthComponent::FindHealthComponent(NewPawn))
-		{
-			CurrentHealthComponent = HealthComp;
-			CurrentHealthComponent->OnHealthChangedDelegate.AddDynamic(
-				this,
-				&ThisClass::HandleHealthChanged
-			);
-
-			const float HealthNorm = CurrentHealthComponent->GetHealthNormalized();
-			UpdateHealthBar(HealthNorm, HealthNorm, true);
-		}
+		TweenSubsystem->StopTween(this);
+	}
+
+	if (HealthComponent)
+	{
+		CurrentHealthComponent = HealthComponent;
+		CurrentHealthComponent->OnHealthChangedDelegate.AddDynamic(
+			this,
+			&ThisClass::HandleHealthChanged
+		);
+
+		const float HealthNorm = CurrentHealthComponent->GetHealthNormalized();
+		UpdateHealthBar(HealthNorm, HealthNorm, true);
 	}
 }
 
@@ -154,3 +154,53 @@ UCommonActivatableWidgetContainerBase* URPGPrimaryGameLayout::GetLayerWidget(FGa
 {
 	return Layers.FindRef(LayerName);
 }
+
+void URPGPrimaryGameLayout::PrewarmWidget(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass)
+{
+	if (!ActivatableWidgetClass || IsDesignTime())
+	{
+		return;
+	}
+
+	const bool bAlreadyPrewarmed = PrewarmedWidgets.ContainsByPredicate([&ActivatableWidgetClass](const UCommonActivatableWidget* Widget)
+	{
+		return Widget && (Widget->GetClass() == ActivatableWidgetClass);
+	});
+
+	if (!bAlreadyPrewarmed)
+	{
+		if (UCommonActivatableWidget* Widget = CreateWidget<UCommonActivatableWidget>(this, ActivatableWidgetClass))
+		{
+			// Building the Slate tree is most of the cost of a first push
+			Widget->TakeWidget();
+			PrewarmedWidgets.Add(Widget);
+
+			UE_LOG(LogRPG, Verbose, TEXT("RPGPrimaryGameLayout: Prewarmed [%s]"), *GetNameSafe(ActivatableWidgetClass));
+		}
+	}
+}
+
+void URPGPrimaryGameLayout::ReleasePrewarmedWidget(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass)
+{
+	PrewarmedWidgets.RemoveAll([&ActivatableWidgetClass](const UCommonActivatableWidget* Widget)
+	{
+		return !Widget || (Widget->GetClass() == ActivatableWidgetClass);
+	});
+}
+
+UCommonActivatableWidget* URPGPrimaryGameLayout::TakePrewarmedWidget(UClass* ActivatableWidgetClass)
+{
+	const int32 WidgetIndex = PrewarmedWidgets.IndexOfByPredicate([ActivatableWidgetClass](const UCommonActivatableWidget* Widget)
+	{
+		return Widget && (Widget->GetClass() == ActivatableWidgetClass);
+	});
+
+	if (WidgetIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	UCommonActivatableWidget* Widget = PrewarmedWidgets[WidgetIndex];
+	PrewarmedWidgets.RemoveAtSwap(WidgetIndex);
+	return Widget;
+}
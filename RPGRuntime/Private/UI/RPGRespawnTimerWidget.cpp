@@ -8,8 +8,8 @@
 #include "System/RPGGameplayTags.h"
 #include "Components/Image.h"
 #include "Materials/MaterialInstanceDynamic.h"
-#include "TimerManager.h"
 #include "GameFramework/PlayerState.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGRespawnTimerWidget)
 
@@ -34,7 +34,7 @@ void URPGRespawnTimerWidget::NativeConstruct()
 
 void URPGRespawnTimerWidget::NativeDestruct()
 {
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_UpdateCountdown);
+	ClearCountdownTimer();
 	
 	Super::NativeDestruct();
 }
@@ -58,7 +58,15 @@ void URPGRespawnTimerWidget::OnRespawnDurationMessage(FGameplayTag Channel, cons
 	}
 
 	// Start local countdown update
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle_UpdateCountdown, this, &ThisClass::UpdateCountdown, 0.1f, true);
+	ClearCountdownTimer();
+	if (URPGTimerWheelSubsystem* TimerWheel = URPGTimerWheelSubsystem::Get(this))
+	{
+		TimerHandle_UpdateCountdown = TimerWheel->SetTimer(this, &ThisClass::UpdateCountdown, 0.1f, /*bLoop=*/ true);
+	}
+	else
+	{
+		GetWorld()->GetTimerManager().SetTimer(FallbackTimerHandle_UpdateCountdown, this, &ThisClass::UpdateCountdown, 0.1f, /*bLoop=*/ true);
+	}
 	
 	// Initial update
 	UpdateCountdown();
@@ -75,7 +83,7 @@ void URPGRespawnTimerWidget::OnRespawnCompletedMessage(FGameplayTag Channel, con
 		return;
 	}
 
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_UpdateCountdown);
+	ClearCountdownTimer();
 	
 	// Play outro
 	if (Outro)
@@ -111,6 +119,16 @@ void URPGRespawnTimerWidget::UpdateCountdown()
 
 	if (TimeRemaining <= 0.0f)
 	{
-		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_UpdateCountdown);
+		ClearCountdownTimer();
+	}
+}
+
+void URPGRespawnTimerWidget::ClearCountdownTimer()
+{
+	URPGTimerWheelSubsystem::ClearWheelTimer(this, TimerHandle_UpdateCountdown);
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(FallbackTimerHandle_UpdateCountdown);
 	}
 }
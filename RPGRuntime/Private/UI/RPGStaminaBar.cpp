@@ -3,10 +3,14 @@
 #include "UI/RPGStaminaBar.h"
 #include "Character/RPGHealthComponent.h"
 #include "AbilitySystem/Attributes/RPGAttributeSet.h"
+#include "UI/RPGUITweenSubsystem.h"
 
 #include "Components/Image.h"
 #include "CommonNumericTextBlock.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGStaminaBar)
@@ -17,7 +21,6 @@ const FName URPGStaminaBar::Param_StaminaUpdated(TEXT("Health_Updated")); // New
 URPGStaminaBar::URPGStaminaBar(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	bHasScriptImplementedTick = true;
 }
 
 void URPGStaminaBar::NativeConstruct()
@@ -42,6 +45,11 @@ void URPGStaminaBar::NativeDestruct()
 		PC->OnPossessedPawnChanged.RemoveAll(this);
 	}
 
+	if (URPGUITweenSubsystem* TweenSubsystem = URPGUITweenSubsystem::Get(this))
+	{
+		TweenSubsystem->StopTween(this);
+	}
+
 	if (CurrentHealthComponent)
 	{
 		CurrentHealthComponent->OnStaminaChangedDelegate.RemoveAll(this);
@@ -52,50 +60,41 @@ void URPGStaminaBar::NativeDestruct()
 	Super::NativeDestruct();
 }
 
-void URPGStaminaBar::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
-{
-	Super::NativeTick(MyGeometry, InDeltaTime);
-
-	if (!bIsAnimating)
-	{
-		return;
-	}
-
-	CurrentVisualStaminaNorm = FMath::FInterpTo(
-		CurrentVisualStaminaNorm,
-		TargetStaminaNorm,
-		InDeltaTime,
-		VisualInterpSpeed
-	);
-
-	UpdateVisuals(CurrentVisualStaminaNorm);
-
-	if (FMath::IsNearlyEqual(CurrentVisualStaminaNorm, TargetStaminaNorm, 0.001f))
-	{
-		CurrentVisualStaminaNorm = TargetStaminaNorm;
-		UpdateVisuals(CurrentVisualStaminaNorm);
-		bIsAnimating = false;
-	}
-}
-
 void URPGStaminaBar::UpdateStaminaBar(float OldValueNorm, float NewValueNorm, bool bSnap)
 {
 	TargetStaminaNorm = NewValueNorm;
 
-	if (bSnap)
+	URPGUITweenSubsystem* TweenSubsystem = URPGUITweenSubsystem::Get(this);
+	if (bSnap || !TweenSubsystem)
 	{
+		if (TweenSubsystem)
+		{
+			TweenSubsystem->StopTween(this);
+		}
+
 		CurrentVisualStaminaNorm = NewValueNorm;
 		UpdateVisuals(NewValueNorm);
-		bIsAnimating = false;
 		return;
 	}
 
-	bIsAnimating = true;
+	TweenSubsystem->PlayTween(this, CurrentVisualStaminaNorm, NewValueNorm, VisualInterpSpeed, 0.0f,
+		FRPGUITweenUpdate::CreateUObject(this, &ThisClass::HandleVisualStaminaChanged));
+}
+
+void URPGStaminaBar::HandleVisualStaminaChanged(float VisualValueNorm)
+{
+	CurrentVisualStaminaNorm = VisualValueNorm;
+	UpdateVisuals(VisualValueNorm);
 }
 
 void URPGStaminaBar::UpdateVisuals(float VisualValueNorm)
 {
-	if (BarFillMID)
+	if (ParameterCollectionInstance)
+	{
+		ParameterCollectionInstance->SetScalarParameterValue(Param_StaminaCurrent, VisualValueNorm);
+		ParameterCollectionInstance->SetScalarParameterValue(Param_StaminaUpdated, TargetStaminaNorm);
+	}
+	else if (BarFillMID)
 	{
 		BarFillMID->SetScalarParameterValue(Param_StaminaCurrent, VisualValueNorm);
 		BarFillMID->SetScalarParameterValue(Param_StaminaUpdated, TargetStaminaNorm);
@@ -115,9 +114,7 @@ void URPGStaminaBar::InitializeBarVisuals()
 		const float MaxStamina = CurrentHealthComponent->GetMaxStamina();
 		const float StaminaNorm = (MaxStamina > 0.0f) ? (Stamina / MaxStamina) : 1.0f;
 
-		CurrentVisualStaminaNorm = StaminaNorm;
-		TargetStaminaNorm = StaminaNorm;
-		UpdateVisuals(StaminaNorm);
+		UpdateStaminaBar(StaminaNorm, StaminaNorm, true);
 	}
 }
 
@@ -169,6 +166,20 @@ void URPGStaminaBar::HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
 
 void URPGStaminaBar::SetDynamicMaterials()
 {
+	// A bar reading a shared collection doesn't need its own material instance
+	if (ParameterCollection)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			ParameterCollectionInstance = World->GetParameterCollectionInstance(ParameterCollection);
+		}
+
+		if (ParameterCollectionInstance)
+		{
+			return;
+		}
+	}
+
 	if (BarFill && !BarFillMID)
 	{
 		BarFillMID = BarFill->GetDynamicMaterial();
@@ -2,7 +2,10 @@
 
 #include "UI/RPGUIManagerSubsystem.h"
 #include "UI/RPGUIPolicy.h"
+#include "UI/RPGPrimaryGameLayout.h"
+#include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
 #include "CommonLocalPlayer.h"
 #include "Engine/LocalPlayer.h"
 #include "System/RPGLogChannels.h"
@@ -13,6 +16,17 @@ URPGUIManagerSubsystem::URPGUIManagerSubsystem()
 {
 }
 
+bool URPGUIManagerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// No UI on dedicated servers
+	if (CastChecked<UGameInstance>(Outer)->IsDedicatedServerInstance())
+	{
+		return false;
+	}
+
+	return Super::ShouldCreateSubsystem(Outer);
+}
+
 void URPGUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -23,12 +37,13 @@ void URPGUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	if (!DefaultPolicyClass.IsNull())
 	{
-		UClass* PolicyClass = DefaultPolicyClass.LoadSynchronous();
-		if (PolicyClass)
+		// Local players are only added later, there is no need to block startup on the policy
+		DefaultPolicyClassHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(DefaultPolicyClass.ToSoftObjectPath(),
+			FStreamableDelegate::CreateUObject(this, &ThisClass::HandleDefaultPolicyClassLoaded));
+
+		if (!DefaultPolicyClassHandle.IsValid() || DefaultPolicyClassHandle->HasLoadCompleted())
 		{
-			UE_LOG(LogRPG, Display, TEXT("RPGUIManagerSubsystem: Loading Default Policy [%s]"), *GetNameSafe(PolicyClass));
-			URPGUIPolicy* NewPolicy = NewObject<URPGUIPolicy>(this, PolicyClass);
-			SwitchToPolicy(NewPolicy);
+			HandleDefaultPolicyClassLoaded();
 		}
 	}
 	else
@@ -39,10 +54,97 @@ void URPGUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void URPGUIManagerSubsystem::Deinitialize()
 {
+	if (DefaultPolicyClassHandle.IsValid())
+	{
+		DefaultPolicyClassHandle->CancelHandle();
+		DefaultPolicyClassHandle.Reset();
+	}
+
+	PendingRootLayoutRequests.Empty();
 	SwitchToPolicy(nullptr);
 	Super::Deinitialize();
 }
 
+void URPGUIManagerSubsystem::HandleDefaultPolicyClassLoaded()
+{
+	if (CurrentPolicy)
+	{
+		return;
+	}
+
+	if (UClass* PolicyClass = DefaultPolicyClass.Get())
+	{
+		UE_LOG(LogRPG, Display, TEXT("RPGUIManagerSubsystem: Loading Default Policy [%s]"), *GetNameSafe(PolicyClass));
+		URPGUIPolicy* NewPolicy = NewObject<URPGUIPolicy>(this, PolicyClass);
+		NewPolicy->PreloadLayoutClass();
+		SwitchToPolicy(NewPolicy);
+	}
+	else
+	{
+		UE_LOG(LogRPG, Error, TEXT("RPGUIManagerSubsystem: Failed to load DefaultPolicyClass [%s]!"), *DefaultPolicyClass.ToString());
+	}
+}
+
+FDelegateHandle URPGUIManagerSubsystem::CallOrRegister_OnRootLayoutReady(ULocalPlayer* LocalPlayer, FOnRPGRootLayoutReady::FDelegate&& Delegate)
+{
+	UCommonLocalPlayer* CommonLocalPlayer = Cast<UCommonLocalPlayer>(LocalPlayer);
+	if (!CommonLocalPlayer)
+	{
+		return FDelegateHandle();
+	}
+
+	if (CurrentPolicy)
+	{
+		// Does nothing if the layout exists or is on its way, creates it right away if its class is resident
+		CurrentPolicy->NotifyPlayerAdded(CommonLocalPlayer);
+
+		if (URPGPrimaryGameLayout* RootLayout = CurrentPolicy->FindRootLayout(CommonLocalPlayer))
+		{
+			Delegate.Execute(CommonLocalPlayer, RootLayout);
+			return FDelegateHandle();
+		}
+	}
+
+	const FDelegateHandle Handle = Delegate.GetHandle();
+	PendingRootLayoutRequests.Emplace(CommonLocalPlayer, MoveTemp(Delegate));
+	return Handle;
+}
+
+void URPGUIManagerSubsystem::UnregisterOnRootLayoutReady(FDelegateHandle Handle)
+{
+	PendingRootLayoutRequests.RemoveAll([Handle](const TPair<TWeakObjectPtr<UCommonLocalPlayer>, FOnRPGRootLayoutReady::FDelegate>& Request)
+	{
+		return Request.Value.GetHandle() == Handle;
+	});
+}
+
+void URPGUIManagerSubsystem::NotifyRootLayoutCreated(UCommonLocalPlayer* LocalPlayer, URPGPrimaryGameLayout* RootLayout)
+{
+	// Pulled out first, delegates are free to register new requests
+	TArray<FOnRPGRootLayoutReady::FDelegate> ReadyDelegates;
+	for (int32 RequestIndex = 0; RequestIndex < PendingRootLayoutRequests.Num();)
+	{
+		const TWeakObjectPtr<UCommonLocalPlayer>& RequestPlayer = PendingRootLayoutRequests[RequestIndex].Key;
+		if (!RequestPlayer.IsValid() || (RequestPlayer.Get() == LocalPlayer))
+		{
+			if (RequestPlayer.IsValid())
+			{
+				ReadyDelegates.Add(MoveTemp(PendingRootLayoutRequests[RequestIndex].Value));
+			}
+			PendingRootLayoutRequests.RemoveAt(RequestIndex);
+		}
+		else
+		{
+			++RequestIndex;
+		}
+	}
+
+	for (FOnRPGRootLayoutReady::FDelegate& Delegate : ReadyDelegates)
+	{
+		Delegate.ExecuteIfBound(LocalPlayer, RootLayout);
+	}
+}
+
 void URPGUIManagerSubsystem::OnLocalPlayerAdded(ULocalPlayer* LocalPlayer)
 {
 	if (CurrentPolicy)
@@ -2,9 +2,12 @@
 
 #include "UI/RPGUIPolicy.h"
 #include "UI/RPGPrimaryGameLayout.h"
+#include "UI/RPGUIManagerSubsystem.h"
 #include "CommonLocalPlayer.h"
 #include "Blueprint/UserWidget.h"
+#include "Engine/AssetManager.h"
 #include "Engine/Engine.h"
+#include "Engine/StreamableManager.h"
 #include "System/RPGLogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGUIPolicy)
@@ -42,6 +45,8 @@ void URPGUIPolicy::NotifyPlayerAdded(UCommonLocalPlayer* LocalPlayer)
 
 void URPGUIPolicy::NotifyPlayerRemoved(UCommonLocalPlayer* LocalPlayer)
 {
+	PendingLayoutPlayers.Remove(LocalPlayer);
+
 	if (URPGPrimaryGameLayout* Layout = RootLayouts.FindRef(LocalPlayer))
 	{
 		Layout->RemoveFromParent();
@@ -69,7 +74,7 @@ void URPGUIPolicy::CreateLayoutWidget(UCommonLocalPlayer* LocalPlayer)
 			return;
 		}
 
-		if (UClass* LayoutWidgetClass = LayoutClass.LoadSynchronous())
+		if (UClass* LayoutWidgetClass = LayoutClass.Get())
 		{
 			UE_LOG(LogRPG, Display, TEXT("RPGUIPolicy: Creating Root Layout [%s] for Player [%s]"), *GetNameSafe(LayoutWidgetClass), *GetNameSafe(LocalPlayer));
 			URPGPrimaryGameLayout* Layout = CreateWidget<URPGPrimaryGameLayout>(PC, LayoutWidgetClass);
@@ -79,8 +84,19 @@ void URPGUIPolicy::CreateLayoutWidget(UCommonLocalPlayer* LocalPlayer)
 			{
 				Layout->SetOwningPlayer(PC);
 				Layout->AddToPlayerScreen();
+				GetOuterURPGUIManagerSubsystem()->NotifyRootLayoutCreated(LocalPlayer, Layout);
 			}
 		}
+		else if (LayoutClassHandle.IsValid() && LayoutClassHandle->HasLoadCompleted())
+		{
+			UE_LOG(LogRPG, Error, TEXT("RPGUIPolicy: Failed to load LayoutClass [%s] in [%s]!"), *LayoutClass.ToString(), *GetName());
+		}
+		else
+		{
+			UE_LOG(LogRPG, Verbose, TEXT("RPGUIPolicy: Root Layout for Player [%s] waits for [%s] to stream in"), *GetNameSafe(LocalPlayer), *LayoutClass.ToString());
+			PendingLayoutPlayers.AddUnique(LocalPlayer);
+			PreloadLayoutClass();
+		}
 	}
 	else
 	{
@@ -96,3 +112,26 @@ void URPGUIPolicy::CreateLayoutWidget(UCommonLocalPlayer* LocalPlayer)
 		}
 	}
 }
+
+void URPGUIPolicy::PreloadLayoutClass()
+{
+	if (LayoutClass.IsNull() || LayoutClassHandle.IsValid())
+	{
+		return;
+	}
+
+	LayoutClassHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(LayoutClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleLayoutClassLoaded));
+}
+
+void URPGUIPolicy::HandleLayoutClassLoaded()
+{
+	TArray<TWeakObjectPtr<UCommonLocalPlayer>> Players = MoveTemp(PendingLayoutPlayers);
+	for (const TWeakObjectPtr<UCommonLocalPlayer>& WeakPlayer : Players)
+	{
+		if (UCommonLocalPlayer* LocalPlayer = WeakPlayer.Get())
+		{
+			CreateLayoutWidget(LocalPlayer);
+		}
+	}
+}
@@ -0,0 +1,195 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UI/RPGUITweenSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RPGUITweenSubsystem)
+
+DECLARE_STATS_GROUP(TEXT("RPG UI"), STATGROUP_RPGUI, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RPGUI Advance Tweens"), STAT_RPGUI_AdvanceTweens, STATGROUP_RPGUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Tweens"), STAT_RPGUI_ActiveTweens, STATGROUP_RPGUI);
+
+namespace RPGConsoleVariables
+{
+	static float UITweenSettleTolerance = 0.001f;
+	static FAutoConsoleVariableRef CVarUITweenSettleTolerance(
+		TEXT("rpg.ui.TweenSettleTolerance"),
+		UITweenSettleTolerance,
+		TEXT("Distance to its target under which a UI tween snaps and stops."),
+		ECVF_Default);
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpRPGUITweens(
+	TEXT("RPG.DumpUITweens"),
+	TEXT("Prints the UI tweens currently advancing."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const URPGUITweenSubsystem* Subsystem = URPGUITweenSubsystem::Get(World))
+		{
+			Subsystem->DumpToOutputDevice(Ar);
+		}
+	}));
+
+//////////////////////////////////////////////////////////////////////
+// URPGUITweenSubsystem
+
+URPGUITweenSubsystem* URPGUITweenSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<URPGUITweenSubsystem>() : nullptr;
+}
+
+bool URPGUITweenSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void URPGUITweenSubsystem::Deinitialize()
+{
+	Tweens.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId URPGUITweenSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGUITweenSubsystem, STATGROUP_Tickables);
+}
+
+bool URPGUITweenSubsystem::IsTickable() const
+{
+	return Tweens.Num() > 0;
+}
+
+void URPGUITweenSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RPGUI_AdvanceTweens);
+	SET_DWORD_STAT(STAT_RPGUI_ActiveTweens, Tweens.Num());
+
+	TGuardValue<bool> TickingGuard(bIsTicking, true);
+
+	// Indexed, callbacks may start new tweens which reallocates the array
+	for (int32 TweenIndex = 0; TweenIndex < Tweens.Num(); ++TweenIndex)
+	{
+		FTween& Tween = Tweens[TweenIndex];
+		if (Tween.bFinished)
+		{
+			continue;
+		}
+
+		if (!Tween.Owner.IsValid())
+		{
+			Tween.bFinished = true;
+			continue;
+		}
+
+		if (Tween.Delay > 0.0f)
+		{
+			Tween.Delay -= DeltaTime;
+			continue;
+		}
+
+		Tween.Current = FMath::FInterpTo(Tween.Current, Tween.Target, DeltaTime, Tween.InterpSpeed);
+		if (FMath::IsNearlyEqual(Tween.Current, Tween.Target, RPGConsoleVariables::UITweenSettleTolerance))
+		{
+			Tween.Current = Tween.Target;
+			Tween.bFinished = true;
+		}
+
+		const FRPGUITweenUpdate OnUpdate = Tween.OnUpdate;
+		OnUpdate.ExecuteIfBound(Tween.Current);
+	}
+
+	Tweens.RemoveAllSwap([](const FTween& Tween) { return Tween.bFinished; });
+}
+
+void URPGUITweenSubsystem::PlayTween(const UObject* Owner, float From, float To, float InterpSpeed, float Delay, FRPGUITweenUpdate&& OnUpdate)
+{
+	if (!Owner)
+	{
+		return;
+	}
+
+	int32 TweenIndex = FindTweenIndex(Owner);
+
+	// Nothing to interpolate, or interpolation disabled
+	if ((InterpSpeed <= 0.0f) || FMath::IsNearlyEqual(From, To, RPGConsoleVariables::UITweenSettleTolerance))
+	{
+		if (TweenIndex != INDEX_NONE)
+		{
+			Tweens[TweenIndex].bFinished = true;
+			if (!bIsTicking)
+			{
+				Tweens.RemoveAtSwap(TweenIndex);
+			}
+		}
+
+		OnUpdate.ExecuteIfBound(To);
+		return;
+	}
+
+	if (TweenIndex == INDEX_NONE)
+	{
+		TweenIndex = Tweens.AddDefaulted();
+	}
+
+	FTween& Tween = Tweens[TweenIndex];
+	Tween.Owner = Owner;
+	Tween.OnUpdate = MoveTemp(OnUpdate);
+	Tween.Current = From;
+	Tween.Target = To;
+	Tween.InterpSpeed = InterpSpeed;
+	Tween.Delay = Delay;
+	Tween.bFinished = false;
+}
+
+void URPGUITweenSubsystem::StopTween(const UObject* Owner)
+{
+	const int32 TweenIndex = FindTweenIndex(Owner);
+	if (TweenIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Removed at the end of the tick when stopped from one of the callbacks
+	if (bIsTicking)
+	{
+		Tweens[TweenIndex].bFinished = true;
+	}
+	else
+	{
+		Tweens.RemoveAtSwap(TweenIndex);
+	}
+}
+
+bool URPGUITweenSubsystem::IsTweening(const UObject* Owner) const
+{
+	return FindTweenIndex(Owner) != INDEX_NONE;
+}
+
+int32 URPGUITweenSubsystem::FindTweenIndex(const UObject* Owner) const
+{
+	if (Owner)
+	{
+		for (int32 TweenIndex = 0; TweenIndex < Tweens.Num(); ++TweenIndex)
+		{
+			const FTween& Tween = Tweens[TweenIndex];
+			if (!Tween.bFinished && (Tween.Owner.Get() == Owner))
+			{
+				return TweenIndex;
+			}
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void URPGUITweenSubsystem::DumpToOutputDevice(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("RPG UI tweens: %d active"), Tweens.Num());
+	for (const FTween& Tween : Tweens)
+	{
+		Ar.Logf(TEXT("  %s: %.3f -> %.3f (speed %.1f, delay %.2f)%s"), *GetNameSafe(Tween.Owner.Get()), Tween.Current, Tween.Target, Tween.InterpSpeed, FMath::Max(Tween.Delay, 0.0f), Tween.bFinished ? TEXT(" finished") : TEXT(""));
+	}
+}
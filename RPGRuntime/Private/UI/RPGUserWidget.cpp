@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UI/RPGUserWidget.h"
+#include "System/RPGCosmeticPolicy.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RPGUserWidget)
 
@@ -8,3 +9,10 @@ URPGUserWidget::URPGUserWidget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 }
+
+void URPGUserWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	RPGCosmeticPolicy::ReportCosmeticPath(this, TEXT("URPGUserWidget::NativeConstruct"));
+}
@@ -3,7 +3,7 @@
 #pragma once
 
 #include "AbilitySystem/RPGGameplayAbility.h"
-#include "TimerManager.h"
+#include "System/RPGTimerWheelSubsystem.h"
 #include "UIExtensionSystem.h"
 #include "RPGGA_AutoRespawn.generated.h"
 
@@ -71,7 +71,10 @@ private:
 	UPROPERTY()
 	TObjectPtr<URPGHealthComponent> LastBoundHealthComponent;
 
-	FTimerHandle RespawnTimerHandle;
+	FRPGTimerWheelHandle RespawnTimerHandle;
+
+	// Used when the world has no timer wheel (e.g. editor preview worlds)
+	FTimerHandle RespawnFallbackTimerHandle;
 
 	FUIExtensionHandle RespawnExtensionHandle;
 };
@@ -2,13 +2,19 @@
 
 #pragma once
 
+#include "AbilitySystem/RPGComboGraph.h"
 #include "AbilitySystem/RPGGameplayAbility.h"
+#include "AbilitySystem/RPGMeleeHitDetection.h"
 #include "RPGGA_Combo.generated.h"
 
+class URPGAbilityTask_ComboGraph;
+class URPGAbilityTask_MeleeTrace;
+
 /**
  * URPGGA_Combo
  *
  * Base class for combo abilities that are driven by animation montages and gameplay events.
+ * The sections, input windows and branches come from a URPGComboGraph.
  */
 UCLASS(Abstract)
 class RPGRUNTIME_API URPGGA_Combo : public URPGGameplayAbility
@@ -22,33 +28,70 @@ protected:
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
 	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 	virtual void InputPressed(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) override;
+	virtual void InputReleased(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo) override;
 
 	// Called when input is pressed during the ability
 	virtual void OnAbilityInputPressed();
 
 	// Handles gameplay events sent from the montage
-	UFUNCTION()
-	void HandleComboEvent(FGameplayEventData Payload);
+	void HandleComboEvent(FGameplayTag EventTag, const FGameplayEventData& Payload);
+	void HandleMontageEnded(bool bInterrupted);
+
+	// Jumps to the specified graph node
+	void AdvanceToNode(int32 NodeIndex);
+
+	// Combos without a graph jump to the section named by the transition tag if input was buffered
+	void HandleLegacyTransition(const FGameplayTag& EventTag);
 
-	// Jumps to the specified montage section
-	void AdvanceToNextSection(FName SectionName);
+	// Builds the damage spec for the swing and starts tracing the blade (authority only)
+	void StartDamageWindow(const FGameplayEventData& Payload);
+	void StopDamageWindow();
+	void HandleMeleeHit(const FHitResult& Hit);
+
+	// Hits of remote players must also connect with the target rewound to what that player saw
+	bool ConfirmHitWithRewind(const FHitResult& Hit) const;
+
+	// Exact tag match first, then the most specific parent tag in DamageEffectMap
+	TSubclassOf<UGameplayEffect> FindDamageEffectForEvent(const FGameplayTag& EventTag) const;
 
 protected:
-	// Montage containing the combo sections (Attack1, Attack2, etc.)
+	// Sections, input windows and branches of the combo
+	UPROPERTY(EditDefaultsOnly, Category = "Combo")
+	TObjectPtr<URPGComboGraph> ComboGraph;
+
+	// Overrides the montage of the combo graph when set. Without a graph the montage starts at Attack1
+	// and each Event.Combo.Transition.<Section> event jumps to <Section> if input was pressed.
 	UPROPERTY(EditDefaultsOnly, Category = "Combo")
 	TObjectPtr<UAnimMontage> ComboMontage;
 
-	// Maps combo state/section to a Gameplay Effect for damage
+	// Damage effect per damage event, used by graph nodes that don't set their own
 	UPROPERTY(EditDefaultsOnly, Category = "Combo")
 	TMap<FGameplayTag, TSubclassOf<UGameplayEffect>> DamageEffectMap;
 
+	// Blade sockets and sweep parameters used during the damage window
+	UPROPERTY(EditDefaultsOnly, Category = "Combo|Damage")
+	FRPGMeleeTraceSettings MeleeTraceSettings;
+
+	// How long the blade is traced after a damage event
+	UPROPERTY(EditDefaultsOnly, Category = "Combo|Damage", meta = (ClampMin = "0.01", Units = "s"))
+	float DamageWindowDuration = 0.2f;
+
 private:
-	// Tracks if the player has pressed the button during the action window
-	bool bInputBuffered = false;
+	// Timestamped presses for the current node
+	FRPGComboInputBuffer InputBuffer;
+
+	// Current node of the combo graph
+	int32 CurrentNodeIndex = INDEX_NONE;
+
+	// Legacy montage path: the player pressed during the current section
+	bool bLegacyInputBuffered = false;
+
+	// One spec per swing, applied to every target hit during the window
+	FGameplayEffectSpecHandle SwingDamageSpec;
 
-	// Current section of the combo
-	FName CurrentSectionName;
+	UPROPERTY()
+	TObjectPtr<URPGAbilityTask_ComboGraph> ComboTask;
 
-	// Handle for the input event listener
-	FDelegateHandle InputPressedHandle;
+	UPROPERTY()
+	TObjectPtr<URPGAbilityTask_MeleeTrace> ActiveMeleeTrace;
 };
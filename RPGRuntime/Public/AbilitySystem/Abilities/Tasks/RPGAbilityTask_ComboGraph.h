@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Abilities/Tasks/AbilityTask.h"
+#include "RPGAbilityTask_ComboGraph.generated.h"
+
+class UAnimMontage;
+struct FGameplayEventData;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FRPGComboGraphEventDelegate, FGameplayTag /*EventTag*/, const FGameplayEventData& /*Payload*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FRPGComboGraphMontageEndedDelegate, bool /*bInterrupted*/);
+
+/**
+ * URPGAbilityTask_ComboGraph
+ *
+ *	Single task driving a combo for the whole activation: plays the montage, jumps between its sections
+ *	and forwards every Event.Combo.* gameplay event. Replaces a PlayMontageAndWait plus one WaitGameplayEvent per event type.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGAbilityTask_ComboGraph : public UAbilityTask
+{
+	GENERATED_BODY()
+
+public:
+	static URPGAbilityTask_ComboGraph* CreateComboGraphTask(UGameplayAbility* OwningAbility, UAnimMontage* Montage, FName StartSection, const FGameplayTagContainer& EventTags, float PlayRate = 1.0f);
+
+	//~UGameplayTask interface
+	virtual void Activate() override;
+	virtual void OnDestroy(bool bInOwnerFinished) override;
+	//~End of UGameplayTask interface
+
+	/** Jumps the playing montage to the section. Returns false if the montage is no longer playing. */
+	bool JumpToSection(FName SectionName);
+
+	/** Montage time elapsed since the start of the current section, or -1 if the montage is not playing. */
+	float GetCurrentSectionTime() const;
+
+	FRPGComboGraphEventDelegate OnComboEvent;
+	FRPGComboGraphMontageEndedDelegate OnMontageEnded;
+
+private:
+	void HandleGameplayEvent(FGameplayTag EventTag, const FGameplayEventData* Payload);
+	void HandleMontageEnded(UAnimMontage* EndedMontage, bool bInterrupted);
+	bool IsMontagePlaying() const;
+
+	UPROPERTY()
+	TObjectPtr<UAnimMontage> Montage;
+
+	FName StartSection;
+	float PlayRate = 1.0f;
+
+	FGameplayTagContainer EventTags;
+	FDelegateHandle EventHandle;
+};
@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Abilities/Tasks/AbilityTask.h"
+#include "AbilitySystem/RPGMeleeHitDetection.h"
+#include "RPGAbilityTask_MeleeTrace.generated.h"
+
+class USkeletalMeshComponent;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FRPGMeleeTraceHitDelegate, const FHitResult& /*Hit*/);
+DECLARE_MULTICAST_DELEGATE(FRPGMeleeTraceFinishedDelegate);
+
+/**
+ * URPGAbilityTask_MeleeTrace
+ *
+ *	Samples the blade sockets of the avatar mesh every tick for the duration of a damage window,
+ *	sub-steps the motion between samples and issues the sweeps as async traces, collected on the next tick.
+ *	Each target is reported at most once per swing, hits arrive one frame after the blade passed.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGAbilityTask_MeleeTrace : public UAbilityTask
+{
+	GENERATED_BODY()
+
+public:
+	URPGAbilityTask_MeleeTrace(const FObjectInitializer& ObjectInitializer);
+
+	static URPGAbilityTask_MeleeTrace* CreateMeleeTrace(UGameplayAbility* OwningAbility, const FRPGMeleeTraceSettings& Settings, float WindowDuration);
+
+	//~UGameplayTask interface
+	virtual void Activate() override;
+	virtual void TickTask(float DeltaTime) override;
+	virtual void OnDestroy(bool bInOwnerFinished) override;
+	//~End of UGameplayTask interface
+
+	// Fired once per new target hit during the swing
+	FRPGMeleeTraceHitDelegate OnHit;
+
+	// Fired when the damage window elapsed and its last sweeps were collected
+	FRPGMeleeTraceFinishedDelegate OnFinished;
+
+private:
+	bool SampleBladePose(FRPGMeleeBladePose& OutPose) const;
+	void FlushAndBroadcast();
+
+	FRPGMeleeTraceSettings Settings;
+	FRPGMeleeSwing Swing;
+
+	UPROPERTY()
+	TObjectPtr<USkeletalMeshComponent> TracedMesh;
+
+	float WindowDuration = 0.0f;
+	float ElapsedTime = 0.0f;
+
+	// Restored when the task ends
+	EVisibilityBasedAnimTickOption SavedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	bool bOverrodeAnimTickOption = false;
+};
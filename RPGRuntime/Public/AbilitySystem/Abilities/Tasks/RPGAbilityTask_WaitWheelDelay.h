@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Abilities/Tasks/AbilityTask.h"
+#include "System/RPGTimerWheelSubsystem.h"
+#include "RPGAbilityTask_WaitWheelDelay.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FRPGWaitWheelDelayDelegate);
+
+/**
+ * URPGAbilityTask_WaitWheelDelay
+ *
+ *	Drop-in replacement for WaitDelay that schedules on the world timer wheel instead of FTimerManager.
+ *	The timer is cancelled when the task ends with its ability. Falls back to FTimerManager in worlds without a timer wheel.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGAbilityTask_WaitWheelDelay : public UAbilityTask
+{
+	GENERATED_BODY()
+
+public:
+	URPGAbilityTask_WaitWheelDelay(const FObjectInitializer& ObjectInitializer);
+
+	/** Waits the specified time, rounded up to the timer wheel granularity. */
+	UFUNCTION(BlueprintCallable, Category = "Ability|Tasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
+	static URPGAbilityTask_WaitWheelDelay* WaitWheelDelay(UGameplayAbility* OwningAbility, float Time);
+
+	//~UGameplayTask interface
+	virtual void Activate() override;
+	virtual void OnDestroy(bool bInOwnerFinished) override;
+	virtual FString GetDebugString() const override;
+	//~End of UGameplayTask interface
+
+	UPROPERTY(BlueprintAssignable)
+	FRPGWaitWheelDelayDelegate OnFinish;
+
+private:
+	void OnTimeFinish();
+
+	FRPGTimerWheelHandle TimerHandle;
+	FTimerHandle FallbackTimerHandle;
+	float Time = 0.0f;
+};
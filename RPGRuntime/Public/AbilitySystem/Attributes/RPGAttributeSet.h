@@ -13,6 +13,7 @@ class AActor;
 class UObject;
 struct FFrame;
 struct FGameplayEffectSpec;
+struct FRPGDamageContribution;
 
 /**
  * Macro used to generate setter and getter functions for attributes.
@@ -28,6 +29,11 @@ struct FGameplayEffectSpec;
   */
 DECLARE_MULTICAST_DELEGATE_SixParams(FRPGAttributeEvent, AActor* /*EffectInstigator*/, AActor* /*EffectCauser*/, const FGameplayEffectSpec* /*EffectSpec*/, float /*EffectMagnitude*/, float /*OldValue*/, float /*NewValue*/);
 
+/**
+ * Delegate used to broadcast damage merged from several executions, with every contributing instigator.
+ */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FRPGCoalescedDamageEvent, TConstArrayView<FRPGDamageContribution> /*Contributions*/, float /*OldValue*/, float /*NewValue*/);
+
 /**
  * FRPGAttributeChangedMessage
  *
@@ -73,6 +79,9 @@ public:
 
 	URPGAbilitySystemComponent* GetRPGAbilitySystemComponent() const;
 
+	// Applies damage buffered by URPGDamageAccumulatorSubsystem as a single health change.
+	void ApplyCoalescedDamage(TConstArrayView<FRPGDamageContribution> Contributions);
+
 public:
 	// Attribute: Health
 	UPROPERTY(BlueprintReadOnly, Category = "RPG|Attributes", ReplicatedUsing = OnRep_Health)
@@ -134,6 +143,9 @@ public:
 	// Delegate to broadcast when the health attribute reaches zero.
 	mutable FRPGAttributeEvent OnOutOfHealth;
 
+	// Delegate to broadcast when coalesced damage was applied, lists every instigator.
+	mutable FRPGCoalescedDamageEvent OnDamageCoalesced;
+
 protected:
 	UFUNCTION()
 	void OnRep_Health(const FGameplayAttributeData& OldValue);
@@ -153,6 +165,9 @@ protected:
 	UFUNCTION()
 	void OnRep_MaxStamina(const FGameplayAttributeData& OldValue);
 
+	// Broadcasts the health change and handles running out of health.
+	void HandleHealthChanged(AActor* Instigator, AActor* Causer, const FGameplayEffectSpec& EffectSpec, float Magnitude, float OldHealth);
+
 	void AdjustAttributeForMaxChange(FGameplayAttributeData& AffectedAttribute, const FGameplayAttributeData& MaxAttribute, float NewMaxValue, const FGameplayAttribute& AffectedAttributeProperty);
 
 private:
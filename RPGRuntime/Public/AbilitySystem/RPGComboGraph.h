@@ -0,0 +1,216 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "RPGComboGraph.generated.h"
+
+class UAnimMontage;
+class UGameplayEffect;
+
+/**
+ * ERPGComboInputType
+ *
+ *	Which kind of buffered input a combo branch requires.
+ */
+UENUM(BlueprintType)
+enum class ERPGComboInputType : uint8
+{
+	// Pressed and released before the hold threshold
+	Tap,
+
+	// Held for at least the hold threshold
+	Hold,
+
+	// Any press
+	Any
+};
+
+/**
+ * FRPGComboGraphBranch
+ *
+ *	Leaves a node when the transition event is received and the buffered input matches.
+ */
+USTRUCT(BlueprintType)
+struct FRPGComboGraphBranch
+{
+	GENERATED_BODY()
+
+	// Transition event sent by the montage (Event.Combo.Transition.*)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combo", meta = (Categories = "Event.Combo.Transition"))
+	FGameplayTag TransitionTag;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combo")
+	ERPGComboInputType InputType = ERPGComboInputType::Any;
+
+	// Node (montage section) to jump to
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combo")
+	FName TargetSection;
+};
+
+/**
+ * FRPGComboGraphNode
+ *
+ *	One montage section of the combo, with its input window, damage and outgoing branches.
+ */
+USTRUCT(BlueprintType)
+struct FRPGComboGraphNode
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combo")
+	FName SectionName;
+
+	// Input is buffered only when pressed inside [InputWindowStart, InputWindowEnd], in seconds of montage time from the section start
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combo", meta = (ClampMin = "0.0", Units = "s"))
+	float InputWindowStart = 0.0f;
+
+	// Negative means until the end of the section
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combo", meta = (Units = "s"))
+	float InputWindowEnd = -1.0f;
+
+	// Presses held at least this long count as Hold
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combo", meta = (ClampMin = "0.0", Units = "s"))
+	float HoldThreshold = 0.25f;
+
+	// Damage applied by this node's damage window. Falls back to the ability's DamageEffectMap when empty
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combo")
+	TSubclassOf<UGameplayEffect> DamageEffect;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combo", meta = (TitleProperty = "TargetSection"))
+	TArray<FRPGComboGraphBranch> Branches;
+};
+
+/** Runtime node, referenced by index. */
+struct FRPGCompiledComboNode
+{
+	FName SectionName;
+	float InputWindowStart = 0.0f;
+	float InputWindowEnd = -1.0f;
+	float HoldThreshold = 0.0f;
+	TSubclassOf<UGameplayEffect> DamageEffect;
+
+	bool IsInInputWindow(float SectionTime) const
+	{
+		return (SectionTime >= InputWindowStart) && ((InputWindowEnd < 0.0f) || (SectionTime <= InputWindowEnd));
+	}
+};
+
+/**
+ * FRPGComboInputBuffer
+ *
+ *	Timestamped input for the current node. Presses outside the node's input window are dropped
+ *	when they happen, so the result does not depend on when the transition event arrives.
+ */
+struct RPGRUNTIME_API FRPGComboInputBuffer
+{
+	void Reset();
+
+	/** Returns true if the press landed in the node's input window and was buffered. */
+	bool RecordPress(const FRPGCompiledComboNode& Node, float SectionTime, double WorldTime);
+	void RecordRelease(double WorldTime);
+
+	/**
+	 * Consumes the buffered press and classifies it as Tap or Hold. Returns false if nothing usable is buffered.
+	 * The age of the press is measured in montage time of the section (SectionTime is the time of the transition event),
+	 * so it is exact to the animation frame regardless of hitches. A press on the frame of the event is always fresh.
+	 */
+	bool Consume(const FRPGCompiledComboNode& Node, float SectionTime, double WorldTime, float MaxAge, ERPGComboInputType& OutInputType);
+
+	bool HasBufferedPress() const { return bHasPress; }
+
+private:
+	double PressWorldTime = 0.0;
+	double ReleaseWorldTime = 0.0;
+	float PressSectionTime = 0.0f;
+	uint64 PressFrame = 0;
+	bool bHasPress = false;
+	bool bReleased = false;
+};
+
+/**
+ * URPGComboGraph
+ *
+ *	Data driven combo: nodes are montage sections, branches are (transition event, input type) pairs.
+ *	The nodes are compiled on load into a flat table so a transition is a single hash lookup.
+ */
+UCLASS(BlueprintType, Const)
+class RPGRUNTIME_API URPGComboGraph : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	//~UObject interface
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~End of UObject interface
+
+	UAnimMontage* GetMontage() const { return Montage; }
+	float GetInputBufferLifetime() const { return InputBufferLifetime; }
+
+	/** Index of the entry node, INDEX_NONE if the graph is empty. */
+	int32 GetEntryNode() const;
+
+	const FRPGCompiledComboNode* GetNode(int32 NodeIndex) const;
+
+	/** Returns the node to jump to, or INDEX_NONE if no branch of the node matches. */
+	int32 FindTransition(int32 NodeIndex, const FGameplayTag& TransitionTag, ERPGComboInputType InputType) const;
+
+private:
+	void CompileGraph();
+	void EnsureCompiled() const;
+
+	struct FTransitionKey
+	{
+		int32 NodeIndex = INDEX_NONE;
+		FGameplayTag TransitionTag;
+
+		bool operator==(const FTransitionKey& Other) const
+		{
+			return (NodeIndex == Other.NodeIndex) && (TransitionTag == Other.TransitionTag);
+		}
+
+		friend uint32 GetTypeHash(const FTransitionKey& Key)
+		{
+			return HashCombine(::GetTypeHash(Key.NodeIndex), GetTypeHash(Key.TransitionTag));
+		}
+	};
+
+	struct FCompiledBranch
+	{
+		ERPGComboInputType InputType = ERPGComboInputType::Any;
+		int32 TargetNode = INDEX_NONE;
+	};
+
+	// Range of CompiledBranches leaving a node on a given transition event
+	struct FBranchRange
+	{
+		int32 First = 0;
+		int32 Num = 0;
+	};
+
+protected:
+	UPROPERTY(EditDefaultsOnly, Category = "Combo")
+	TObjectPtr<UAnimMontage> Montage;
+
+	// Section the combo starts with. Defaults to the first node
+	UPROPERTY(EditDefaultsOnly, Category = "Combo")
+	FName EntrySection;
+
+	// Buffered presses older than this are discarded, in seconds of montage time
+	UPROPERTY(EditDefaultsOnly, Category = "Combo", meta = (ClampMin = "0.0", Units = "s"))
+	float InputBufferLifetime = 0.5f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Combo", meta = (TitleProperty = "SectionName"))
+	TArray<FRPGComboGraphNode> Nodes;
+
+private:
+	TArray<FRPGCompiledComboNode> CompiledNodes;
+	TArray<FCompiledBranch> CompiledBranches;
+	TMap<FTransitionKey, FBranchRange> TransitionTable;
+	int32 CompiledEntryNode = INDEX_NONE;
+	bool bCompiled = false;
+};
@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameplayEffect.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RPGDamageAccumulator.generated.h"
+
+class URPGAttributeSet;
+
+/**
+ * FRPGDamageContribution
+ *
+ *	Damage merged from every execution of the same effect by the same instigator against one target.
+ */
+struct FRPGDamageContribution
+{
+	TWeakObjectPtr<AActor> Instigator;
+	TWeakObjectPtr<AActor> Causer;
+	TObjectKey<UGameplayEffect> EffectDef;
+
+	// Copy of the first merged spec, used for the health and death events
+	FGameplayEffectSpec Spec;
+
+	float Damage = 0.0f;
+	int32 NumHits = 0;
+};
+
+/**
+ * URPGDamageAccumulatorSubsystem
+ *
+ *	Buffers the damage executed against each attribute set during a frame (or rpg.damage.CoalesceWindow)
+ *	and applies it as one health change per target. Contributions are merged by instigator and effect.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGDamageAccumulatorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URPGDamageAccumulatorSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+	//~End of FTickableGameObject interface
+
+	/** Buffers the damage. Returns false when coalescing is disabled, in which case the caller applies it immediately. */
+	bool QueueDamage(URPGAttributeSet* Target, const FGameplayEffectSpec& Spec, float Damage);
+
+	/** Applies everything buffered against the target now. */
+	void FlushTarget(URPGAttributeSet* Target);
+
+	/** Applies everything buffered. */
+	void FlushAll();
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	struct FPendingTarget
+	{
+		TWeakObjectPtr<URPGAttributeSet> Target;
+
+		// Key of Target in PendingIndexByTarget, still usable once Target has gone stale
+		TObjectKey<URPGAttributeSet> TargetKey;
+
+		TArray<FRPGDamageContribution, TInlineAllocator<4>> Contributions;
+	};
+
+	void FlushPendingTarget(FPendingTarget& Pending);
+
+private:
+	TArray<FPendingTarget> PendingTargets;
+	TMap<TObjectKey<URPGAttributeSet>, int32> PendingIndexByTarget;
+
+	float TimeSinceLastFlush = 0.0f;
+	bool bIsFlushing = false;
+};
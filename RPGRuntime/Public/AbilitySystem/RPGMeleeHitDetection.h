@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/HitResult.h"
+#include "WorldCollision.h"
+#include "RPGMeleeHitDetection.generated.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * FRPGMeleeTraceSettings
+ *
+ *	Describes the blade to trace during a melee damage window.
+ *	The blade runs between two sockets on the avatar's skeletal mesh.
+ */
+USTRUCT(BlueprintType)
+struct FRPGMeleeTraceSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Melee")
+	FName BladeStartSocket = TEXT("WeaponTrace_Start");
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Melee")
+	FName BladeEndSocket = TEXT("WeaponTrace_End");
+
+	// Radius of every sphere swept along the blade
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Melee", meta = (ClampMin = "0.0"))
+	float TraceRadius = 10.0f;
+
+	// Number of points swept along the blade (2 = just the start and end sockets)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Melee", meta = (ClampMin = "2", ClampMax = "8"))
+	int32 PointsAlongBlade = 3;
+
+	// A new sub-step is inserted whenever the blade tip would move further than this between two samples
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Melee", meta = (ClampMin = "1.0"))
+	float MaxSubstepDistance = 30.0f;
+
+	// Upper bound on sub-steps per sample, keeps low server frame rates from exploding the sweep count
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Melee", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 MaxSubsteps = 8;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Melee")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Pawn;
+};
+
+/**
+ * FRPGMeleeBladePose
+ *
+ *	Blade sockets in the actor's local space plus the actor transform at sample time.
+ *	Interpolating in local space follows the swing arc much better than interpolating world positions.
+ */
+struct FRPGMeleeBladePose
+{
+	FVector LocalStart = FVector::ZeroVector;
+	FVector LocalEnd = FVector::ZeroVector;
+	FTransform ActorTransform = FTransform::Identity;
+
+	FVector GetWorldStart() const { return ActorTransform.TransformPosition(LocalStart); }
+	FVector GetWorldEnd() const { return ActorTransform.TransformPosition(LocalEnd); }
+
+	static FRPGMeleeBladePose Lerp(const FRPGMeleeBladePose& A, const FRPGMeleeBladePose& B, float Alpha);
+};
+
+/** One sphere sweep produced from two consecutive (sub-stepped) blade poses. */
+struct FRPGMeleeSweepSegment
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+};
+
+/**
+ * FRPGMeleeSwing
+ *
+ *	State for one swing: the last blade pose, the segments waiting to be swept, the async sweeps in flight
+ *	and the targets already hit. The segment generation is pure math so a scripted sequence of poses always yields the same sweeps.
+ */
+class RPGRUNTIME_API FRPGMeleeSwing
+{
+public:
+	void Begin(const FRPGMeleeTraceSettings& InSettings, const FRPGMeleeBladePose& InitialPose);
+
+	/** Adds a new pose sample and queues the sub-stepped segments from the previous one. */
+	void AddSample(const FRPGMeleeBladePose& Pose);
+
+	/**
+	 * Collects the results of the sweeps issued by the previous call, then issues every queued segment as an async sweep
+	 * so the scene queries run with the world's async trace batch instead of blocking the game thread.
+	 * Returns the hits on actors not already hit this swing, one frame after their segment was queued.
+	 */
+	void FlushSweeps(UWorld* World, const TArray<const AActor*>& IgnoredActors, TArray<FHitResult>& OutNewHits);
+
+	/** True while sweeps issued by FlushSweeps have not been collected yet. */
+	bool HasSweepsInFlight() const { return InFlightSweeps.Num() > 0; }
+
+	bool IsActive() const { return bActive; }
+	void End();
+
+	int32 GetNumPendingSegments() const { return PendingSegments.Num(); }
+	int32 GetNumHitActors() const { return HitActors.Num(); }
+
+	/** Builds the segments between two poses. Exposed for deterministic tests of a scripted timeline. */
+	static void BuildSegments(const FRPGMeleeTraceSettings& Settings, const FRPGMeleeBladePose& From, const FRPGMeleeBladePose& To, TArray<FRPGMeleeSweepSegment>& OutSegments);
+
+private:
+	/** Returns true if the actor was not hit yet during this swing. */
+	bool RegisterHit(const AActor* Actor);
+
+	FRPGMeleeTraceSettings Settings;
+	FRPGMeleeBladePose LastPose;
+	TArray<FRPGMeleeSweepSegment> PendingSegments;
+
+	// Issued last flush, in segment order
+	TArray<FTraceHandle> InFlightSweeps;
+
+	// Swings rarely hit more than a handful of targets, a linear search beats hashing here
+	TArray<TWeakObjectPtr<const AActor>, TInlineAllocator<8>> HitActors;
+
+	bool bActive = false;
+};
@@ -43,6 +43,25 @@ struct FRPGCardinalDirectionAnimations
     }
 };
 
+class URPGEquipmentManagerComponent;
+class URPGWeaponInstance;
+
+// Plain-data copy of the equipment state the anim graph needs, rebuilt only when equipment events fire
+USTRUCT(BlueprintType)
+struct FRPGAnimEquipmentSnapshot
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    bool bIsWeaponEquipped = false;
+
+    UPROPERTY(BlueprintReadOnly)
+    FGameplayTagContainer CosmeticTags;
+
+    UPROPERTY(BlueprintReadOnly)
+    TSubclassOf<UAnimInstance> WeaponAnimLayer;
+};
+
 UCLASS()
 class RPGRUNTIME_API URPGAnimInstance : public UAnimInstance
 {
@@ -53,9 +72,21 @@ public:
 
 protected:
     virtual void NativeInitializeAnimation() override;
+    virtual void NativeBeginPlay() override;
+    virtual void NativeUninitializeAnimation() override;
     virtual void NativeUpdateAnimation(float DeltaSeconds) override;
     virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 
+    /** Đăng ký một lần vào sự kiện trang bị của pawn (thay cho việc tìm component mỗi frame) */
+    void BindToEquipmentEvents();
+    void UnbindFromEquipmentEvents();
+
+    void HandleEquipmentOfClassChanged(URPGEquipmentManagerComponent* EquipmentManager, TSubclassOf<URPGWeaponInstance> InstanceType);
+    void HandleWeaponCosmeticStateChanged(URPGWeaponInstance* WeaponInstance);
+
+    /** Dựng lại snapshot trang bị trên game thread, chỉ khi có sự kiện */
+    void RefreshEquipmentSnapshot();
+
     /** Cập nhật thông tin vận tốc từ Character (Thread Safe) */
     UFUNCTION(BlueprintCallable, Category = "Animation", meta = (BlueprintThreadSafe))
     void UpdateVelocityData(float DeltaSeconds);
@@ -152,6 +183,13 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation|Weapon")
     FGameplayTagContainer CurrentWeaponTags;
 
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation|Weapon")
+    TSubclassOf<UAnimInstance> CurrentWeaponAnimLayer;
+
+    // Stance
+    UPROPERTY(BlueprintReadOnly, Category = "Locomotion|Status", Transient)
+    bool bIsCrouching = false;
+
 private:
     float GetCurrentAnimationSpeed() const;
 
@@ -162,5 +200,15 @@ private:
 
     UPROPERTY(Transient)
     TObjectPtr<class ACharacter> OwningCharacter;
+
+    // Equipment event bindings
+    TWeakObjectPtr<URPGEquipmentManagerComponent> BoundEquipmentManager;
+    TWeakObjectPtr<URPGWeaponInstance> BoundWeapon;
+    FDelegateHandle EquipmentChangedHandle;
+    FDelegateHandle WeaponCosmeticChangedHandle;
+
+    // Written by equipment events on the game thread, published to the anim variables at the start of the next update
+    FRPGAnimEquipmentSnapshot PendingEquipmentSnapshot;
+    bool bEquipmentSnapshotDirty = false;
 };
 
@@ -28,4 +28,8 @@ protected:
 	// The tag to send as a gameplay event
 	UPROPERTY(EditAnywhere, Category = "AnimNotify", Meta = (Categories = "Event"))
 	FGameplayTag EventTag;
+
+	// If set, the event only drives cosmetics and is skipped on dedicated servers
+	UPROPERTY(EditAnywhere, Category = "AnimNotify")
+	bool bIsCosmetic = false;
 };
@@ -14,6 +14,7 @@ class ARPGPlayerController;
 class ARPGPlayerState;
 class FLifetimeProperty;
 class IRepChangedPropertyTracker;
+class UAnimSequence;
 class UAbilitySystemComponent;
 class UInputComponent;
 class URPGAbilitySystemComponent;
@@ -115,6 +116,22 @@ public:
 
 	void ToggleCrouch();
 
+	UAnimSequence* GetBakedDeathPose() const { return BakedDeathPose; }
+
+	/** Puts the dead character aside (hidden, uninitialized, unpossessed) instead of destroying it. Server only. */
+	void ParkForRecycling();
+
+	/** Brings a parked character back at the spawn transform, ready to be possessed again. Server only. */
+	void UnparkForRecycling(const FTransform& SpawnTransform);
+
+	bool IsParkedForRecycling() const { return bIsParkedForRecycling; }
+
+	/**
+	 * Ends the death sequence now instead of on the next tick: leaves the corpse, then parks the character
+	 * for its player or destroys it. Does nothing if the death sequence already ended.
+	 */
+	void DestroyDueToDeath();
+
 	//~AActor interface
 	virtual void PreInitializeComponents() override;
 	virtual void BeginPlay() override;
@@ -164,9 +181,20 @@ protected:
 	virtual void OnDeathFinished(AActor* OwningActor);
 
 	void DisableMovementAndCollision();
-	void DestroyDueToDeath();
 	void UninitAndDestroy();
 
+	// Deferred end of the death sequence, ignored if the character started another life since it was queued
+	void DestroyDueToDeathForLife(uint32 DeathLifeSerial);
+
+	// Applies the parked state locally, on the server and on clients
+	virtual void OnParkedStateChanged(bool bParked);
+
+	UFUNCTION()
+	void OnRep_IsParkedForRecycling();
+
+	void RegisterWithCharacterSubsystems();
+	void UnregisterFromCharacterSubsystems();
+
 	// Called when the death sequence for the character has completed
 	UFUNCTION(BlueprintImplementableEvent, meta=(DisplayName="OnDeathFinished"))
 	void K2_OnDeathFinished();
@@ -180,6 +208,12 @@ protected:
 
 	virtual bool CanJumpInternal_Implementation() const;
 
+protected:
+
+	// Pose used by the corpse when the character dies without a ragdoll (low significance or ragdoll budget exhausted)
+	UPROPERTY(EditDefaultsOnly, Category = "RPG|Death")
+	TObjectPtr<UAnimSequence> BakedDeathPose;
+
 private:
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RPG|Character", Meta = (AllowPrivateAccess = "true"))
@@ -194,6 +228,16 @@ private:
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_ReplicatedAcceleration)
 	FRPGReplicatedAcceleration ReplicatedAcceleration;
 
+	// True while the character is dead and kept by the pawn recycle subsystem
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_IsParkedForRecycling)
+	bool bIsParkedForRecycling = false;
+
+	// Set once DestroyDueToDeath ran, until the character is unparked for a new life
+	bool bDeathSequenceEnded = false;
+
+	// Incremented every time the character is unparked for a new life
+	uint32 LifeSerial = 0;
+
 private:
 	UFUNCTION()
 	void OnRep_ReplicatedAcceleration();
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Chaos/ChaosEngineInterface.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "NativeGameplayTags.h"
 #include "RPGCharacterMovementComponent.generated.h"
@@ -24,6 +25,7 @@ struct FRPGCharacterGroundInfo
 	FRPGCharacterGroundInfo()
 		: LastUpdateFrame(0)
 		, GroundDistance(0.0f)
+		, SurfaceType(SurfaceType_Default)
 	{}
 
 	uint64 LastUpdateFrame;
@@ -33,6 +35,10 @@ struct FRPGCharacterGroundInfo
 
 	UPROPERTY(BlueprintReadOnly)
 	float GroundDistance;
+
+	// Physical surface of the ground, used by context effects so footsteps don't need their own trace
+	UPROPERTY(BlueprintReadOnly)
+	TEnumAsByte<EPhysicalSurface> SurfaceType;
 };
 
 
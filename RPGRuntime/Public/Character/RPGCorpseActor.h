@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "RPGCorpseActor.generated.h"
+
+class UAnimSequence;
+class USkeletalMeshComponent;
+
+/**
+ * ARPGCorpseActor
+ *
+ *	Pooled, client side stand-in for a dead character. Takes over the mesh and pose of the character
+ *	so the character itself can be destroyed right away.
+ */
+UCLASS(NotPlaceable, Transient)
+class RPGRUNTIME_API ARPGCorpseActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ARPGCorpseActor(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** Copies the mesh, materials and current pose of the source. Plays the baked pose instead when given. */
+	void InitializeFrom(const USkeletalMeshComponent* SourceMesh, UAnimSequence* BakedDeathPose);
+
+	/** Hides the corpse and drops every reference so it can go back to the pool. */
+	void ResetCorpse();
+
+	USkeletalMeshComponent* GetCorpseMesh() const { return CorpseMesh; }
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = "Corpse")
+	TObjectPtr<USkeletalMeshComponent> CorpseMesh;
+};
@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RPGCorpseSubsystem.generated.h"
+
+class ARPGCharacter;
+class ARPGCorpseActor;
+class FOutputDevice;
+class USkeletalMeshComponent;
+
+/**
+ * URPGCorpseSubsystem
+ *
+ *	Bounds the physics cost of deaths. Caps the number of simulating ragdolls, puts settled ones to sleep,
+ *	gives low significance deaths a baked pose instead, and keeps corpses in a fixed size pool.
+ *	Corpses are cosmetic and never exist on a dedicated server.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGCorpseSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URPGCorpseSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+	//~End of FTickableGameObject interface
+
+	/**
+	 * Starts simulating the mesh as a ragdoll if the budget and the owner's significance allow it.
+	 * Returns false when the owner should keep (or bake) its animated death pose instead.
+	 */
+	bool RequestRagdoll(USkeletalMeshComponent* Mesh, const AActor* Owner);
+
+	/** Hands the character's mesh and pose over to a pooled corpse. Called right before the character is destroyed. */
+	void CreateCorpse(ARPGCharacter* Character);
+
+	void DumpToOutputDevice(FOutputDevice& Ar) const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	struct FRagdollEntry
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		float SimulatedTime = 0.0f;
+		float SettledTime = 0.0f;
+	};
+
+	struct FCorpseEntry
+	{
+		TWeakObjectPtr<ARPGCorpseActor> Corpse;
+		double ExpireTime = 0.0;
+	};
+
+	void StartSimulating(USkeletalMeshComponent* Mesh);
+	void FreezeRagdoll(USkeletalMeshComponent* Mesh);
+	int32 FindRagdoll(const USkeletalMeshComponent* Mesh) const;
+	ARPGCorpseActor* AcquireCorpse();
+	void ReleaseCorpse(ARPGCorpseActor* Corpse);
+
+private:
+	// Oldest first
+	TArray<FRagdollEntry> ActiveRagdolls;
+
+	// Oldest first
+	TArray<FCorpseEntry> ActiveCorpses;
+
+	// Every corpse ever spawned, active or not
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ARPGCorpseActor>> CorpsePool;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ARPGCorpseActor>> FreeCorpses;
+
+	// Debug counters
+	int32 NumRagdollsStarted = 0;
+	int32 NumRagdollsDenied = 0;
+	int32 NumRagdollsEvicted = 0;
+	int32 NumRagdollsSettled = 0;
+	int32 NumCorpsesRecycled = 0;
+};
@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RPGCrowdSubsystem.generated.h"
+
+class ARPGEnemy_Character;
+class FOutputDevice;
+
+/**
+ * ERPGCrowdBehavior
+ */
+enum class ERPGCrowdBehavior : uint8
+{
+	Idle,
+	Wander
+};
+
+/**
+ * FRPGCrowdAgent
+ *
+ *	Packed state of an enemy that is simulated without an actor.
+ *	The same state is carried over when the agent is promoted to a full enemy character and back.
+ */
+struct FRPGCrowdAgent
+{
+	FVector3f Location = FVector3f::ZeroVector;
+	FVector3f HomeLocation = FVector3f::ZeroVector;
+	FVector3f MoveTarget = FVector3f::ZeroVector;
+	float Health = 0.0f;
+	float MaxHealth = 0.0f;
+	float StateTimeRemaining = 0.0f;
+	int32 RandomSeed = 0;
+	uint16 ClassIndex = 0;
+	uint8 TeamId = 0xFF;
+	ERPGCrowdBehavior Behavior = ERPGCrowdBehavior::Idle;
+	uint8 bActive : 1;
+	uint8 bPromoted : 1;
+
+	FRPGCrowdAgent() : bActive(false), bPromoted(false) {}
+};
+
+/**
+ * URPGCrowdSubsystem
+ *
+ *	Server side simulation of large enemy populations. Agents far from every player are updated in batched
+ *	parallel passes over packed structs, and promoted to ARPGEnemy_Character actors when a player comes in range.
+ */
+UCLASS(Config = Game)
+class RPGRUNTIME_API URPGCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URPGCrowdSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+	//~End of FTickableGameObject interface
+
+	/** Adds a simulated enemy. Returns its agent id. */
+	int32 SpawnAgent(TSubclassOf<ARPGEnemy_Character> EnemyClass, const FVector& Location, int32 TeamId, float Health, float MaxHealth);
+
+	/** Removes the agent, destroying its actor if promoted. */
+	void RemoveAgent(int32 AgentId);
+
+	/** Called by promoted enemies when they start dying, the agent is not simulated any more. */
+	void NotifyPromotedEnemyDied(int32 AgentId);
+
+	int32 GetNumAgents() const { return NumActiveAgents; }
+	int32 GetNumPromoted() const { return PromotedActors.Num(); }
+
+	/** Spawns agents around the players and reports the server frame time for the duration. */
+	void StartSoak(int32 NumAgents, float Duration, TSubclassOf<ARPGEnemy_Character> EnemyClass, FOutputDevice& Ar);
+
+	void DumpToOutputDevice(FOutputDevice& Ar) const;
+
+	TSubclassOf<ARPGEnemy_Character> GetDefaultEnemyClass() const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	enum class ETransition : uint8
+	{
+		None,
+		Promote,
+		Demote
+	};
+
+	void GatherPlayerLocations();
+	void SimulateAgents(float DeltaTime);
+	void ProcessTransitions();
+	bool PromoteAgent(int32 AgentId);
+	void DemoteAgent(int32 AgentId);
+	void UpdateSoak(float DeltaTime);
+
+protected:
+	// A simulated agent is promoted when a player gets closer than this
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd")
+	float PromotionRadius = 3000.0f;
+
+	// A promoted enemy is demoted when every player is further than this (must be larger than PromotionRadius)
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd")
+	float DemotionRadius = 4000.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd")
+	float WanderRadius = 1000.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd")
+	float MoveSpeed = 150.0f;
+
+	// Class used by the soak test when none is given
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd")
+	TSoftClassPtr<ARPGEnemy_Character> DefaultEnemyClass;
+
+private:
+	TArray<FRPGCrowdAgent> Agents;
+	TArray<ETransition> PendingTransitions;
+	TArray<int32> FreeAgentIds;
+	int32 NumActiveAgents = 0;
+
+	UPROPERTY(Transient)
+	TArray<TSubclassOf<ARPGEnemy_Character>> EnemyClasses;
+
+	TMap<int32, TWeakObjectPtr<ARPGEnemy_Character>> PromotedActors;
+	TArray<FVector3f> PlayerLocations;
+
+	struct FSoakState
+	{
+		bool bActive = false;
+		float TimeRemaining = 0.0f;
+		int32 NumFrames = 0;
+		double TotalFrameMs = 0.0;
+		double TotalSimulationMs = 0.0;
+		TArray<float> FrameTimesMs;
+	};
+
+	FSoakState Soak;
+	double LastSimulationMs = 0.0;
+
+	// Debug counters
+	int32 NumPromotions = 0;
+	int32 NumDemotions = 0;
+};
@@ -21,4 +21,23 @@ public:
 	//~ARPGCharacter interface
 	virtual void OnDeathStarted(AActor* OwningActor) override;
 	//~End of ARPGCharacter interface
+
+	// Called by URPGCrowdSubsystem before the promoted enemy finishes spawning
+	void InitializeFromCrowd(int32 AgentId, float Health);
+
+	void SetCrowdAgentId(int32 AgentId) { CrowdAgentId = AgentId; }
+	int32 GetCrowdAgentId() const { return CrowdAgentId; }
+
+protected:
+	//~ARPGCharacter interface
+	virtual void OnAbilitySystemInitialized() override;
+	//~End of ARPGCharacter interface
+
+private:
+	// Crowd agent this enemy was promoted from, INDEX_NONE when spawned directly
+	int32 CrowdAgentId = INDEX_NONE;
+
+	// Health carried over from the crowd agent, applied once the ability system is ready
+	float PendingCrowdHealth = 0.0f;
+	bool bHasPendingCrowdHealth = false;
 };
@@ -94,6 +94,9 @@ public:
 	// Applies enough damage to kill the owner.
 	virtual void DamageSelfDestruct(bool bFellOutOfWorld = false);
 
+	// Brings a dead owner back to NotDead, used when the pawn is recycled instead of destroyed.
+	virtual void ResetDeathState();
+
 public:
 
 	// Delegate fired when the health value has changed.
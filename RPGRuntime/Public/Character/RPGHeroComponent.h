@@ -78,6 +78,9 @@ protected:
 
 	virtual void InitializePlayerInput(UInputComponent* PlayerInputComponent);
 
+	/** Follows the pawn extension back to Spawned when the pawn is recycled. */
+	void ResetInitState();
+
 	void Input_AbilityInputTagPressed(FGameplayTag InputTag);
 	void Input_AbilityInputTagReleased(FGameplayTag InputTag);
 
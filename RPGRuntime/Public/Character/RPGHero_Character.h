@@ -10,6 +10,7 @@ class UAnimMontage;
 class USceneComponent;
 class URPGHeroComponent;
 class URPGInventoryItemDefinition;
+struct FActorInitStateChangedParams;
 
 /**
  * ARPGHero_Character
@@ -27,6 +28,8 @@ public:
 	//~ARPGCharacter interface
 	virtual void OnDeathStarted(AActor* OwningActor) override;
 	virtual void PossessedBy(AController* NewController) override;
+	virtual void OnParkedStateChanged(bool bParked) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	//~End of ARPGCharacter interface
 
 	const TArray<TObjectPtr<UAnimMontage>>& GetDeathMontages() const { return DeathMontages; }
@@ -63,13 +66,13 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<AActor> FootStepActor;
 
-	/** Starts ragdoll physics */
+	/** Starts ragdoll physics, within the corpse subsystem budget */
 	void StartRagdoll();
 
 	/** Hides all equipped weapons */
 	void HideEquippedWeapons();
 
-	/** Attempts to add initial inventory, uses polling if components aren't ready */
+	/** Adds the initial inventory once the pawn and the controller's inventory are ready, waits for their init state otherwise */
 	void TryAddInitialInventory();
 
 	/** Actually grants the items */
@@ -79,7 +82,16 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RPG|Hero", Meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<URPGHeroComponent> HeroComponent;
 
+	void OnInventoryDependencyReady(const FActorInitStateChangedParams& Params);
+	void ClearInventoryReadyListeners();
+
 	bool bInventoryInitialized = false;
 
-	FTimerHandle TimerHandle_InventoryReady;
+	// Init state listeners waiting for the pawn extension and the controller's quickbar to be ready
+	FDelegateHandle PawnReadyHandle;
+	FDelegateHandle InventoryReadyHandle;
+	TWeakObjectPtr<AController> InventoryReadyController;
+
+	// When the pawn was possessed, to measure how long it takes to get fully equipped
+	double PossessedTime = 0.0;
 };
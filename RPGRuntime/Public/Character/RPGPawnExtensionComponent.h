@@ -73,6 +73,12 @@ public:
 	/** Should be called by the owning pawn when the input component is setup. */
 	void SetupPlayerInputComponent();
 
+	/**
+	 * Removes the pawn from the ability system and rolls the init state back to Spawned, so a recycled pawn goes
+	 * through the whole init state chain again when it is possessed. Dependent features react to the rollback.
+	 */
+	void ResetInitState();
+
 	/** Register with the OnAbilitySystemInitialized delegate and broadcast if our pawn has been registered with the ability system component */
 	void OnAbilitySystemInitialized_RegisterAndCall(FSimpleMulticastDelegate::FDelegate Delegate);
 
@@ -101,4 +107,7 @@ protected:
 	/** Pointer to the ability system component that is cached for convenience. */
 	UPROPERTY(Transient)
 	TObjectPtr<URPGAbilitySystemComponent> AbilitySystemComponent;
+
+	/** Initial equipment is granted once per pawn, a recycled pawn keeps the equipment it already has. */
+	bool bInitialEquipmentGranted = false;
 };
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RPGPawnRecycleSubsystem.generated.h"
+
+class AController;
+class ARPGCharacter;
+class FOutputDevice;
+class URPGPawnData;
+
+/**
+ * FRPGRespawnLatencySample
+ *
+ *	One measured respawn, from the death of the previous pawn to the controller possessing the next one.
+ */
+struct FRPGRespawnLatencySample
+{
+	// Wall clock time between the death starting and the controller getting a pawn back, respawn delay included
+	double DeathToControlSeconds = 0.0;
+
+	// Time spent inside RestartPlayer (spawn or recycle, possession and initialization)
+	double RestartMilliseconds = 0.0;
+
+	bool bRecycledPawn = false;
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnRPGRespawnLatencyMeasured, AController* /*Controller*/, const FRPGRespawnLatencySample& /*Sample*/);
+
+/**
+ * URPGPawnRecycleSubsystem
+ *
+ *	Server side pool that keeps a dead player's character parked instead of destroying it, and hands it back to the
+ *	same controller on respawn. The parked character keeps its mesh, components and equipment and only goes through
+ *	the init state chain again, which is much cheaper than spawning a new one.
+ *	Also measures the death to control latency of every respawn.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGPawnRecycleSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URPGPawnRecycleSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Parks the dead character for its controller. Returns false if it should be destroyed as usual. */
+	bool TryParkPawn(ARPGCharacter* Character);
+
+	/**
+	 * Returns the character parked for this controller, unparked at the spawn transform, or nullptr if there is none.
+	 * A parked character that doesn't match the wanted class or pawn data is destroyed.
+	 */
+	ARPGCharacter* TakeParkedPawn(AController* Controller, UClass* PawnClass, const URPGPawnData* PawnData, const FTransform& SpawnTransform);
+
+	/** Destroys the character parked for this controller, if any. */
+	void ReleaseParkedPawn(AController* Controller);
+
+	/** Forgets everything about a controller that is leaving the game. */
+	void HandleControllerLogout(AController* Controller);
+
+	/** Starts the death to control measurement for the character's controller. */
+	void NotifyPawnDied(ARPGCharacter* Character);
+
+	/** Ends the death to control measurement once the controller got its pawn back. */
+	void NotifyPlayerRestarted(AController* Controller, double RestartSeconds);
+
+	/** Called for every measured respawn. */
+	FOnRPGRespawnLatencyMeasured OnRespawnLatencyMeasured;
+
+	void DumpToOutputDevice(FOutputDevice& Ar) const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	struct FRespawnRecord
+	{
+		double DeathTime = 0.0;
+		bool bRecycledPawn = false;
+	};
+
+	struct FLatencyStats
+	{
+		int32 NumSamples = 0;
+		double TotalDeathToControl = 0.0;
+		double MaxDeathToControl = 0.0;
+		double TotalRestartMs = 0.0;
+		double MaxRestartMs = 0.0;
+
+		void AddSample(const FRPGRespawnLatencySample& Sample);
+	};
+
+private:
+	TMap<TObjectKey<AController>, TWeakObjectPtr<ARPGCharacter>> ParkedPawns;
+	TMap<TObjectKey<AController>, FRespawnRecord> PendingRespawns;
+
+	FLatencyStats RecycledStats;
+	FLatencyStats SpawnedStats;
+
+	// Debug counters
+	int32 NumParked = 0;
+	int32 NumRecycled = 0;
+	int32 NumDiscarded = 0;
+};
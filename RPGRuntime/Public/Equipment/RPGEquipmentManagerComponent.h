@@ -3,6 +3,7 @@
 #include "Components/PawnComponent.h"
 #include "Net/Serialization/FastArraySerializer.h"
 #include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
 #include "RPGEquipmentManagerComponent.generated.h"
 
 class URPGEquipmentDefinition;
@@ -10,6 +11,9 @@ class URPGWeaponInstance;
 class URPGEquipmentManagerComponent;
 struct FRPGEquipmentList;
 
+/** Fired when an instance of (or derived from) the watched class is equipped or unequipped. */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FRPGEquipmentOfClassChanged, URPGEquipmentManagerComponent* /*EquipmentManager*/, TSubclassOf<URPGWeaponInstance> /*InstanceType*/);
+
 /**
  * FRPGAppliedEquipmentEntry
  * A single piece of applied equipment.
@@ -66,6 +70,32 @@ private:
 	TObjectPtr<UActorComponent> OwnerComponent;
 };
 
+/**
+ * FRPGEquipmentInstanceBucket
+ * All equipped instances that are of a given class (including subclasses), in equip order.
+ */
+USTRUCT()
+struct FRPGEquipmentInstanceBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<URPGWeaponInstance>> Instances;
+};
+
+/**
+ * FRPGEquipmentClassChain
+ * Cached class hierarchy of an instance class, from the class itself up to URPGWeaponInstance.
+ */
+USTRUCT()
+struct FRPGEquipmentClassChain
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UClass>> Classes;
+};
+
 template<>
 struct TStructOpsTypeTraits<FRPGEquipmentList> : public TStructOpsTypeTraitsBase2<FRPGEquipmentList>
 {
@@ -90,9 +120,17 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment")
 	void UnequipItem(URPGWeaponInstance* ItemInstance);
 
+	/** Returns the first equipped instance of the given type (or a subclass of it). O(1), served from the class index. */
 	UFUNCTION(BlueprintCallable, Category = "Equipment")
 	URPGWeaponInstance* GetFirstInstanceOfType(TSubclassOf<URPGWeaponInstance> InstanceType);
 
+	/** Returns all equipped instances of the given type (or a subclass of it), in equip order. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Equipment")
+	TArray<URPGWeaponInstance*> GetEquipmentInstancesOfType(TSubclassOf<URPGWeaponInstance> InstanceType) const;
+
+	/** Event fired whenever an instance of InstanceType (or a subclass) is added or removed, on server and clients. */
+	FRPGEquipmentOfClassChanged& OnEquipmentOfClassChanged(TSubclassOf<URPGWeaponInstance> InstanceType);
+
 	UFUNCTION(BlueprintCallable, Category = "Equipment")
 	void SetAllWeaponsHidden(bool bHidden);
 
@@ -103,7 +141,26 @@ public:
 	// Lifecycle
 	virtual void UninitializeComponent() override;
 
+private:
+	friend struct FRPGEquipmentList;
+
+	// Class index maintenance, called from equip/unequip and the replication callbacks
+	void AddInstanceToIndex(URPGWeaponInstance* Instance);
+	void RemoveInstanceFromIndex(URPGWeaponInstance* Instance);
+	const TArray<TObjectPtr<UClass>>& GetClassChain(UClass* InstanceClass);
+	void BroadcastClassChanged(const TArray<TObjectPtr<UClass>>& ClassChain);
+
 private:
 	UPROPERTY(Replicated)
 	FRPGEquipmentList EquipmentList;
+
+	// Class -> equipped instances of that class or any subclass
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FRPGEquipmentInstanceBucket> InstancesByClass;
+
+	// Instance class -> its parent chain, resolved once per class
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FRPGEquipmentClassChain> ClassChainCache;
+
+	TMap<TObjectKey<UClass>, FRPGEquipmentOfClassChanged> ClassChangedDelegates;
 };
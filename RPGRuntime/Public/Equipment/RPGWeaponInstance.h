@@ -10,6 +10,10 @@ class AActor;
 class APawn;
 class USkeletalMeshComponent;
 class UAnimInstance;
+class URPGWeaponInstance;
+
+/** Fired when the equipped state or cosmetic tags of a weapon instance change. */
+DECLARE_MULTICAST_DELEGATE_OneParam(FRPGWeaponCosmeticStateChanged, URPGWeaponInstance* /*WeaponInstance*/);
 
 USTRUCT(BlueprintType)
 struct FRPGWeaponActorToSpawn
@@ -89,6 +93,13 @@ public:
         return Cast<T>(GetPawn());
     }
 
+    // Replaces the cosmetic tags and notifies listeners (anim instances cache these)
+    UFUNCTION(BlueprintCallable, Category = "RPG|Weapon|Animation")
+    void SetCosmeticTags(const FGameplayTagContainer& InCosmeticTags);
+
+    // Broadcast after Equip/Unequip and SetCosmeticTags
+    FRPGWeaponCosmeticStateChanged OnCosmeticStateChanged;
+
     // Cosmetic Tags
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RPG|Weapon|Animation")
     FGameplayTagContainer CosmeticTags;
@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "GameplayTagContainer.h"
+#include "Feedback/ContextEffects/RPGContextEffectsInterface.h"
+#include "RPGContextEffectComponent.generated.h"
+
+class URPGContextEffectsLibrary;
+
+/**
+ * URPGContextEffectComponent
+ *
+ *	Pooled implementation of IRPGContextEffectsInterface. Resolves effect tag + contexts through the
+ *	compiled lookup tables of its libraries and plays the results through URPGContextEffectsSubsystem.
+ *	When no hit is supplied, the surface context comes from the movement component's cached ground info.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class RPGRUNTIME_API URPGContextEffectComponent : public UActorComponent, public IRPGContextEffectsInterface
+{
+	GENERATED_BODY()
+
+public:
+	URPGContextEffectComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	//~UActorComponent interface
+	virtual void BeginPlay() override;
+	//~End of UActorComponent interface
+
+	//~IRPGContextEffectsInterface
+	virtual void AnimMotionEffect_Implementation(const FName Bone
+		, const FGameplayTag MotionEffect
+		, USceneComponent* StaticMeshComponent
+		, const FVector LocationOffset
+		, const FRotator RotationOffset
+		, const UAnimSequenceBase* AnimationSequence
+		, const bool bHitSuccess
+		, const FHitResult HitResult
+		, FGameplayTagContainer Contexts
+		, FVector VFXScale = FVector(1)
+		, float AudioVolume = 1
+		, float AudioPitch = 1) override;
+	//~End of IRPGContextEffectsInterface
+
+	UFUNCTION(BlueprintCallable, Category = "RPG|ContextEffects")
+	void UpdateEffectContexts(FGameplayTagContainer NewEffectContexts);
+
+	UFUNCTION(BlueprintCallable, Category = "RPG|ContextEffects")
+	void UpdateLibraries(const TSet<TSoftObjectPtr<URPGContextEffectsLibrary>>& NewLibraries);
+
+protected:
+	/** Returns the surface context for this effect, from the hit if there is one, otherwise from the ground info. */
+	FGameplayTag GetSurfaceContext(bool bHitSuccess, const FHitResult& HitResult) const;
+
+	void LoadLibraries();
+
+protected:
+	// Contexts always added to every effect played by this component
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RPG|ContextEffects")
+	FGameplayTagContainer DefaultEffectContexts;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RPG|ContextEffects")
+	TSet<TSoftObjectPtr<URPGContextEffectsLibrary>> DefaultContextEffectsLibraries;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RPG|ContextEffects")
+	ERPGContextMatchType MatchType = ERPGContextMatchType::BestMatch;
+
+	// Adds the surface under the hit (or the character) as a context
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RPG|ContextEffects")
+	bool bConvertPhysicalSurfaceToContext = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RPG|ContextEffects", meta = (EditCondition = "bConvertPhysicalSurfaceToContext"))
+	TMap<TEnumAsByte<EPhysicalSurface>, FGameplayTag> SurfaceTypeToContext;
+
+private:
+	UPROPERTY(Transient)
+	FGameplayTagContainer CurrentContexts;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<URPGContextEffectsLibrary>> ActiveLibraries;
+
+	TSet<TSoftObjectPtr<URPGContextEffectsLibrary>> CurrentLibraries;
+};
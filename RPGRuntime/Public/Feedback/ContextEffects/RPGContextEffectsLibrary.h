@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "Feedback/ContextEffects/RPGContextEffectsInterface.h"
+#include "RPGContextEffectsLibrary.generated.h"
+
+class UNiagaraSystem;
+class USoundBase;
+struct FStreamableHandle;
+
+/**
+ * ERPGContextEffectsLibraryLoadState
+ */
+UENUM()
+enum class ERPGContextEffectsLibraryLoadState : uint8
+{
+	Unloaded,
+	Loading,
+	Loaded
+};
+
+/**
+ * FRPGContextEffects
+ *
+ *	Authoring entry: the effects to play for an effect tag under a set of contexts (surface, etc...).
+ */
+USTRUCT(BlueprintType)
+struct FRPGContextEffects
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FGameplayTag EffectTag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FGameplayTagContainer Context;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (AllowedClasses = "/Script/Engine.SoundBase, /Script/Niagara.NiagaraSystem"))
+	TArray<FSoftObjectPath> Effects;
+};
+
+/**
+ * FRPGCompiledContextEffects
+ *
+ *	Runtime entry with the effects resolved and split by type.
+ */
+USTRUCT()
+struct FRPGCompiledContextEffects
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTagContainer Context;
+
+	UPROPERTY()
+	TArray<TObjectPtr<USoundBase>> Sounds;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UNiagaraSystem>> NiagaraSystems;
+};
+
+/**
+ * URPGContextEffectsLibrary
+ *
+ *	Maps effect tags and contexts to sounds and Niagara systems. Once loaded the entries are compiled
+ *	into a table indexed by effect tag, and every resolved (tag, contexts) query is cached.
+ */
+UCLASS(BlueprintType)
+class RPGRUNTIME_API URPGContextEffectsLibrary : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Context Effects")
+	TArray<FRPGContextEffects> ContextEffects;
+
+	/** Starts an async load of every effect, then compiles the lookup table. */
+	UFUNCTION(BlueprintCallable, Category = "Context Effects")
+	void LoadEffects();
+
+	UFUNCTION(BlueprintPure, Category = "Context Effects")
+	ERPGContextEffectsLibraryLoadState GetLoadState() const { return LoadState; }
+
+	/** Returns the compiled entry matching the query, or nullptr. Only valid once loaded. */
+	const FRPGCompiledContextEffects* FindEffects(const FGameplayTag& EffectTag, const FGameplayTagContainer& Contexts, ERPGContextMatchType MatchType);
+
+private:
+	void CompileEffects();
+
+	struct FQueryKey
+	{
+		FGameplayTag EffectTag;
+		FGameplayTagContainer Contexts;
+		ERPGContextMatchType MatchType = ERPGContextMatchType::BestMatch;
+
+		bool operator==(const FQueryKey& Other) const
+		{
+			return (EffectTag == Other.EffectTag) && (MatchType == Other.MatchType) && (Contexts == Other.Contexts);
+		}
+
+		friend uint32 GetTypeHash(const FQueryKey& Key)
+		{
+			// Order independent so equal containers built in a different order share a cache entry
+			uint32 ContextHash = 0;
+			for (const FGameplayTag& Tag : Key.Contexts)
+			{
+				ContextHash ^= GetTypeHash(Tag);
+			}
+			return HashCombine(HashCombine(GetTypeHash(Key.EffectTag), ContextHash), (uint32)Key.MatchType);
+		}
+	};
+
+	UPROPERTY(Transient)
+	TArray<FRPGCompiledContextEffects> CompiledEffects;
+
+	// Effect tag -> indices into CompiledEffects
+	TMap<FGameplayTag, TArray<int32>> CompiledEffectsByTag;
+
+	// Resolved queries, INDEX_NONE when nothing matched
+	TMap<FQueryKey, int32> QueryCache;
+
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
+	ERPGContextEffectsLibraryLoadState LoadState = ERPGContextEffectsLibraryLoadState::Unloaded;
+};
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RPGContextEffectsSubsystem.generated.h"
+
+class FOutputDevice;
+class UAudioComponent;
+class UNiagaraComponent;
+class UNiagaraSystem;
+class USoundBase;
+
+/**
+ * URPGContextEffectsSubsystem
+ *
+ *	Per-world pool for context effect playback. Audio components are recycled from a capped pool,
+ *	Niagara components come from the engine world pool with a cap on concurrently active systems (released back
+ *	to the pool by hand once they finish, so the cap counts the ones still playing),
+ *	and effects further than the cull distance from every local viewer are skipped.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGContextEffectsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URPGContextEffectsSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Plays a sound at a location using a pooled audio component. Returns false if it was culled or the pool is full. */
+	bool PlaySoundAtLocation(USoundBase* Sound, const FVector& Location, float VolumeMultiplier, float PitchMultiplier);
+
+	/** Spawns a pooled Niagara system at a location. Returns false if it was culled or the cap was reached. */
+	bool SpawnNiagaraAtLocation(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation, const FVector& Scale);
+
+	/** Returns true if the location is close enough to a local viewer to be worth playing effects at. */
+	bool IsWithinCullDistance(const FVector& Location);
+
+	/** Call once per effect before playing its sounds and systems. Same as IsWithinCullDistance, but counts the culled effects. */
+	bool ShouldPlayEffectAt(const FVector& Location);
+
+	void DumpToOutputDevice(FOutputDevice& Ar) const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	UAudioComponent* AcquireAudioComponent();
+
+	UFUNCTION()
+	void HandleNiagaraSystemFinished(UNiagaraComponent* FinishedComponent);
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAudioComponent>> AudioPool;
+
+	// Spawned with ManualRelease, removed and released to the world pool from OnSystemFinished
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UNiagaraComponent>> ActiveNiagaraComponents;
+
+	// Local viewer locations, refreshed once per frame
+	TArray<FVector, TInlineAllocator<4>> CachedViewerLocations;
+	uint64 ViewerCacheFrame = 0;
+
+	// Debug counters
+	int32 NumSoundsPlayed = 0;
+	int32 NumNiagaraSpawned = 0;
+	int32 NumCulledByDistance = 0;
+	int32 NumDroppedByCap = 0;
+};
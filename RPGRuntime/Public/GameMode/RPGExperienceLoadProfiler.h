@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "UObject/PrimaryAssetId.h"
+
+class FOutputDevice;
+class UWorld;
+
+/** Phases an experience goes through between being set and being fully loaded. */
+enum class ERPGExperienceLoadPhase : uint8
+{
+	// Loading the experience definition itself (server only, clients receive it replicated)
+	Definition,
+
+	// Bundle loading of the experience and its action sets
+	Bundles,
+
+	// Loading and activating the game feature plugins
+	GameFeatures,
+
+	// Artificial delay added by rpg.chaos.ExperienceDelayLoad
+	ChaosDelay,
+
+	// Batched load of everything the actions reference softly
+	ActionPreload,
+
+	// Activating the experience actions, one batch per step
+	Actions,
+
+	// Running the OnExperienceLoaded listeners
+	Callbacks,
+
+	MAX
+};
+
+RPGRUNTIME_API const TCHAR* LexToString(ERPGExperienceLoadPhase Phase);
+
+/**
+ * FRPGExperienceLoadTiming
+ */
+struct FRPGExperienceLoadTiming
+{
+	FString Name;
+
+	// Seconds since the start of the experience load
+	double StartOffset = -1.0;
+	double Duration = -1.0;
+
+	bool bSucceeded = true;
+	FString Error;
+
+	bool HasStarted() const { return StartOffset >= 0.0; }
+	bool HasCompleted() const { return Duration >= 0.0; }
+};
+
+/**
+ * FRPGExperienceLoadSummary
+ *
+ *	Timeline of one experience load: every phase, every game feature plugin and every action activation.
+ */
+struct FRPGExperienceLoadSummary
+{
+	FPrimaryAssetId ExperienceId;
+	FString WorldName;
+	FString NetMode;
+	FDateTime Time;
+	double TotalSeconds = 0.0;
+
+	// Whether the experience had been preloaded before the transition started
+	bool bWarm = false;
+
+	// From the end of the previous experience to this one being loaded, negative for the first experience
+	double TransitionSeconds = -1.0;
+
+	// Indexed by ERPGExperienceLoadPhase, phases that didn't run have a negative duration
+	FRPGExperienceLoadTiming Phases[(int32)ERPGExperienceLoadPhase::MAX];
+
+	TArray<FRPGExperienceLoadTiming> Plugins;
+	TArray<FRPGExperienceLoadTiming> Actions;
+
+	/** Returns the slowest entry of the list, or null if it is empty. */
+	static const FRPGExperienceLoadTiming* FindSlowest(const TArray<FRPGExperienceLoadTiming>& Timings);
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnRPGExperienceLoadProfiled, const FRPGExperienceLoadSummary& /*Summary*/);
+
+/**
+ * FRPGExperienceLoadProfiler
+ *
+ *	Records the timeline of an experience load for the experience manager component.
+ *	Phases and plugin loads are emitted as Insights timing regions, action activations as CPU events.
+ *	Completed loads are kept in a short history printed by RPG.DumpExperienceLoads.
+ */
+class RPGRUNTIME_API FRPGExperienceLoadProfiler
+{
+public:
+	void Begin(const FPrimaryAssetId& ExperienceId, const UWorld* World);
+	bool IsActive() const { return bActive; }
+
+	/** Marks the load as warm or cold. TransitionStartTime is the time the previous experience ended, if any. */
+	void SetTransitionInfo(bool bWarm, double TransitionStartTime);
+
+	void BeginPhase(ERPGExperienceLoadPhase Phase);
+	void EndPhase(ERPGExperienceLoadPhase Phase);
+
+	void BeginPlugin(const FString& PluginURL);
+	void EndPlugin(const FString& PluginURL, bool bSucceeded, const FString& Error = FString());
+
+	/** Records an action activation that took Duration seconds and ended now. */
+	void AddAction(const FString& ActionName, double Duration);
+
+	/** Closes the timeline, stores it in the history and broadcasts OnExperienceLoadProfiled. */
+	void Finish();
+
+	/** Drops the load in progress without recording it (e.g. the world ended while loading). */
+	void Abort();
+
+	static void WriteSummary(const FRPGExperienceLoadSummary& Summary, FOutputDevice& Ar);
+	static void DumpHistory(int32 NumLoads, FOutputDevice& Ar);
+	static const TArray<FRPGExperienceLoadSummary>& GetHistory();
+
+	/** Called with the timeline of every completed experience load. */
+	static FOnRPGExperienceLoadProfiled OnExperienceLoadProfiled;
+
+private:
+	double GetOffset() const;
+	FString GetRegionName(const TCHAR* Category, const FString& Name) const;
+
+	FRPGExperienceLoadSummary Current;
+	double StartTime = 0.0;
+	double TransitionStartTime = 0.0;
+	bool bActive = false;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
 
 /**
  * URPGExperienceManager
@@ -18,6 +19,9 @@ public:
 	// Tracks that a plugin is no longer needed by an experience, returns true if it should actually be deactivated
 	static bool RequestToDeactivatePlugin(const FString& PluginURL);
 
+	// Bundles an experience and its action sets load with in the given net mode
+	static TArray<FName> GetBundlesToLoad(ENetMode NetMode);
+
 private:
 	// Tracking map for plugin URLs and their reference counts
 	static TMap<FString, int32> ActivatedPluginCounts;
@@ -3,12 +3,15 @@
 #pragma once
 
 #include "Components/GameStateComponent.h"
+#include "GameMode/RPGExperienceLoadProfiler.h"
 #include "LoadingProcessInterface.h"
 #include "RPGExperienceManagerComponent.generated.h"
 
 namespace UE::GameFeatures { struct FResult; }
 
+class UGameFeatureAction;
 class URPGExperienceDefinition;
+struct FStreamableHandle;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnRPGExperienceLoaded, const URPGExperienceDefinition* /*Experience*/);
 
@@ -19,6 +22,7 @@ enum class ERPGExperienceLoadState : uint8
 	Loading,
 	LoadingGameFeatures,
 	LoadingChaosTestingDelay,
+	PreloadingActions,
 	ExecutingActions,
 	Loaded,
 	Deactivating
@@ -70,9 +74,13 @@ private:
 
 	void StartExperienceLoad();
 	void OnExperienceLoadComplete();
-	void OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result);
+	void OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result, FString PluginURL);
 	void OnExperienceFullLoadCompleted();
 
+	void GatherExperienceActions(TArray<UGameFeatureAction*>& OutActions) const;
+	void StartActionPreload();
+	void ActivateExperienceActions();
+
 	void OnActionDeactivationCompleted();
 	void OnAllActionsDeactivated();
 
@@ -88,6 +96,12 @@ private:
 	int32 NumObservedPausers = 0;
 	int32 NumExpectedPausers = 0;
 
+	// Timeline of the load in progress, see RPG.DumpExperienceLoads
+	FRPGExperienceLoadProfiler LoadProfiler;
+
+	// Soft references of every action, loaded in one batch before activation and kept for the experience lifetime
+	TSharedPtr<FStreamableHandle> ActionPreloadHandle;
+
 	/**
 	 * Delegate called when the experience has finished loading just before others
 	 * (e.g., subsystems that set up for regular gameplay)
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/PrimaryAssetId.h"
+#include "RPGExperiencePreloadSubsystem.generated.h"
+
+namespace UE::GameFeatures { struct FResult; }
+
+class URPGExperienceDefinition;
+struct FStreamableHandle;
+
+/**
+ * URPGExperiencePreloadSubsystem
+ *
+ *	Warms up the experience the next match transition goes to while the current match is still running.
+ *	The definition, its action sets and their bundles are streamed in at default priority and the game feature
+ *	plugins are loaded (not activated). On transition the experience manager component picks up the resident
+ *	definition, and plugins shared by both experiences stay active instead of being deactivated and reactivated.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGExperiencePreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URPGExperiencePreloadSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/** Announces the experience of the next match so it can be loaded in the background. Replaces any previous preload. */
+	UFUNCTION(BlueprintCallable, Category = "RPG|Experience")
+	void PreloadExperience(FPrimaryAssetId ExperienceId);
+
+	/** Drops the preload and the assets it kept resident. */
+	UFUNCTION(BlueprintCallable, Category = "RPG|Experience")
+	void CancelPreload();
+
+	UFUNCTION(BlueprintPure, Category = "RPG|Experience")
+	FPrimaryAssetId GetPreloadedExperienceId() const { return PreloadedExperienceId; }
+
+	/** Returns true once the definition, bundles and plugins of the preloaded experience are all resident. */
+	UFUNCTION(BlueprintPure, Category = "RPG|Experience")
+	bool IsPreloadComplete() const;
+
+	/** Returns true if the experience is the preloaded one and its preload has completed. */
+	bool IsWarm(const FPrimaryAssetId& ExperienceId) const { return (ExperienceId == PreloadedExperienceId) && IsPreloadComplete(); }
+
+	/** Returns the preloaded definition if it is resident. */
+	const URPGExperienceDefinition* FindPreloadedExperience(const FPrimaryAssetId& ExperienceId) const;
+
+	// Called by the experience manager component when its experience ends.
+	// Returns true if the plugin is used by the preloaded experience and should stay active through the transition.
+	bool HoldPluginForTransition(const FString& PluginURL);
+
+	// Called once the next experience knows its plugins: held plugins it doesn't use are deactivated now.
+	void ReleaseHeldPlugins(const TArray<FString>& PluginURLsInUse);
+
+	// Called by the experience manager component, the preload is consumed once its experience is loaded
+	void NotifyExperienceEnded();
+	void NotifyExperienceLoaded(const FPrimaryAssetId& ExperienceId);
+
+	/** Time the previous experience ended, used to measure transition times. Zero before the first transition. */
+	double GetTransitionStartTime() const { return TransitionStartTime; }
+
+private:
+	void HandleDefinitionLoaded();
+	void HandleActionSetsLoaded();
+	void HandlePluginLoaded(const UE::GameFeatures::FResult& Result, FString PluginURL, int32 Serial);
+
+	// Drops the preload and unloads what it loaded itself, content already used by the running experience stays
+	void UnloadOwnedContent();
+	void ResetPreloadState();
+
+	FPrimaryAssetId PreloadedExperienceId;
+	double PreloadStartTime = 0.0;
+
+	// Bumped by every preload, plugin load callbacks can't be cancelled
+	int32 PreloadSerial = 0;
+
+	TSharedPtr<FStreamableHandle> DefinitionHandle;
+	TSharedPtr<FStreamableHandle> ActionSetsHandle;
+	bool bAssetsLoaded = false;
+
+	// Primary assets and plugins that weren't loaded before the preload, unloaded if it is dropped
+	TArray<FPrimaryAssetId> OwnedAssetIds;
+	TArray<FString> OwnedPluginURLs;
+
+	TArray<FString> PreloadPluginURLs;
+	int32 NumPluginsLoading = 0;
+
+	// Plugins kept active through the transition, deactivated if the next experience doesn't use them after all
+	TArray<FString> HeldPluginURLs;
+
+	double TransitionStartTime = 0.0;
+};
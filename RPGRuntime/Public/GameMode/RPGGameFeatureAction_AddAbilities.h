@@ -9,6 +9,7 @@
 class UAttributeSet;
 class UDataTable;
 class URPGAbilitySystemComponent;
+struct FStreamableHandle;
 
 /**
  * FRPGAbilityGrant
@@ -78,6 +79,8 @@ struct FRPGGameFeatureAbilitiesEntry
 /**
  * GameFeatureAction that adds gameplay abilities, attribute sets, and ability sets to actors.
  * Standalone version of Lyra's GameFeatureAction_AddAbilities.
+ * Everything the entries reference is streamed in once when the action activates and held until it deactivates,
+ * actors that show up before the load finished are granted in a budgeted pass once it completes.
  */
 UCLASS(meta = (DisplayName = "Add Abilities (RPG)"))
 class RPGRUNTIME_API URPGGameFeatureAction_AddAbilities final : public URPGGameFeatureAction_WorldActionBase
@@ -100,21 +103,50 @@ private:
 
 	struct FActorExtensions
 	{
+		TWeakObjectPtr<URPGAbilitySystemComponent> AbilitySystemComponent;
 		TArray<FGameplayAbilitySpecHandle> Abilities;
 		TArray<TObjectPtr<UAttributeSet>> Attributes;
 		TArray<FRPGAbilitySet_GrantedHandles> AbilitySetHandles;
 	};
 
+	// Resident version of an AbilitiesList entry, kept alive by the preload handle
+	struct FResolvedAbilitiesEntry
+	{
+		TArray<TPair<TSubclassOf<URPGGameplayAbility>, int32>> Abilities;
+		TArray<TPair<TSubclassOf<UAttributeSet>, UDataTable*>> AttributeSets;
+		TArray<const URPGAbilitySet*> AbilitySets;
+	};
+
+	struct FPendingGrant
+	{
+		TWeakObjectPtr<AActor> Actor;
+		int32 EntryIndex = INDEX_NONE;
+	};
+
 	struct FPerContextData
 	{
 		TMap<AActor*, FActorExtensions> ActiveExtensions;
 		TArray<TSharedPtr<struct FComponentRequestHandle>> ComponentRequests;
+
+		TSharedPtr<FStreamableHandle> PreloadHandle;
+		TArray<FResolvedAbilitiesEntry> ResolvedEntries;
+		bool bPreloadComplete = false;
+		double PreloadStartTime = 0.0;
+
+		// Actors that asked for their grants while the preload was in flight
+		TArray<FPendingGrant> PendingGrants;
 	};
 
+	void StartPreload(const FGameFeatureStateChangeContext& ChangeContext);
+	void HandlePreloadComplete(FGameFeatureStateChangeContext ChangeContext);
+	void FlushPendingGrants(FGameFeatureStateChangeContext ChangeContext);
+
 	void HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext);
-	void AddActorAbilities(AActor* Actor, const FRPGGameFeatureAbilitiesEntry& AbilitiesEntry, FPerContextData& ActiveData);
+	void AddActorAbilities(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData);
 	void RemoveActorAbilities(AActor* Actor, FPerContextData& ActiveData);
 
+	static URPGAbilitySystemComponent* FindAbilitySystemComponent(AActor* Actor);
+
 	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;
 
 	UPROPERTY(EditAnywhere, Category="Abilities", meta=(TitleProperty="ActorClass"))
@@ -7,8 +7,13 @@
 #include "UObject/SoftObjectPtr.h"
 #include "RPGGameFeatureAction_AddWidgets.generated.h"
 
+class ARPGHUD;
 class UCommonActivatableWidget;
+class UCommonLocalPlayer;
+class UGameInstance;
+class URPGPrimaryGameLayout;
 struct FComponentRequestHandle;
+struct FStreamableHandle;
 
 USTRUCT()
 struct FRPGHUDLayoutRequest
@@ -22,10 +27,16 @@ struct FRPGHUDLayoutRequest
 	/** The layer to add the widget to. */
 	UPROPERTY(EditAnywhere, Category=UI, meta=(Categories="UI.Layer"))
 	FGameplayTag LayerID;
+
+	/** Construct an instance while the experience is loading, so the first push doesn't pay for it. */
+	UPROPERTY(EditAnywhere, Category=UI)
+	bool bPrewarm = false;
 };
 
 /**
  * GameFeatureAction that adds widgets to the player's UI.
+ * Layout classes are streamed in as soon as the action is added to a world with a HUD, pushes that arrive before
+ * a class is resident go through an async push instead of loading it on the spot.
  */
 UCLASS(meta = (DisplayName = "Add Widgets"))
 class RPGRUNTIME_API URPGGameFeatureAction_AddWidgets final : public URPGGameFeatureAction_WorldActionBase
@@ -48,20 +59,40 @@ private:
 	struct FPerActorData
 	{
 		TArray<TWeakObjectPtr<UCommonActivatableWidget>> LayoutsAdded;
+
+		// Async pushes of layout classes that weren't resident yet
+		TArray<TSharedPtr<FStreamableHandle>> PendingPushes;
+
+		// Set while waiting for the UI policy to create the player's root layout
+		FDelegateHandle RootLayoutReadyHandle;
 	};
 
 	struct FPerContextData
 	{
 		TArray<TSharedPtr<FComponentRequestHandle>> ComponentRequests;
 		TMap<FObjectKey, FPerActorData> ActorData;
+
+		TSharedPtr<FStreamableHandle> PreloadHandle;
+		TArray<TWeakObjectPtr<UGameInstance>> PendingPrewarms;
+		TArray<TWeakObjectPtr<URPGPrimaryGameLayout>> PrewarmedLayouts;
+
+		// Prewarms waiting for the UI policy to create a local player's root layout
+		TArray<TPair<TWeakObjectPtr<UGameInstance>, FDelegateHandle>> PrewarmLayoutReadyHandles;
 	};
 
 	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;
 
 	void HandleActorExtension(AActor* Actor, FName EventName, FGameFeatureStateChangeContext ChangeContext);
 
-	void AddWidgets(AActor* Actor, FPerContextData& ActiveData);
+	void AddWidgets(AActor* Actor, FPerContextData& ActiveData, const FGameFeatureStateChangeContext& ChangeContext);
 	void RemoveWidgets(AActor* Actor, FPerContextData& ActiveData);
 
+	void HandleRootLayoutReady(UCommonLocalPlayer* LocalPlayer, URPGPrimaryGameLayout* RootLayout, TWeakObjectPtr<ARPGHUD> WeakHUD, FGameFeatureStateChangeContext ChangeContext);
+
+	void StartPreload(UGameInstance* GameInstance, const FGameFeatureStateChangeContext& ChangeContext);
+	void HandlePreloadComplete(FGameFeatureStateChangeContext ChangeContext);
+	void PrewarmWidgets(UGameInstance* GameInstance, const FGameFeatureStateChangeContext& ChangeContext);
+	void HandlePrewarmLayoutReady(UCommonLocalPlayer* LocalPlayer, URPGPrimaryGameLayout* RootLayout, FGameFeatureStateChangeContext ChangeContext);
+
 	void Reset(FPerContextData& ActiveData);
 };
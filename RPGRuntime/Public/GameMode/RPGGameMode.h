@@ -11,6 +11,7 @@ class AGameModeBase;
 class APawn;
 class APlayerController;
 class URPGExperienceDefinition;
+class URPGExperienceManagerComponent;
 class URPGPawnData;
 
 /**
@@ -51,6 +52,8 @@ public:
 	virtual bool UpdatePlayerStartSpot(AController* Player, const FString& Portal, FString& OutErrorMessage) override;
 	virtual void GenericPlayerInitialization(AController* NewPlayer) override;
 	virtual void FailedToRestartPlayer(AController* NewPlayer) override;
+	virtual void RestartPlayer(AController* NewPlayer) override;
+	virtual void Logout(AController* Exiting) override;
 	//~End of AGameModeBase interface
 
 	// Restart (respawn) the specified player or bot next frame
@@ -63,11 +66,28 @@ public:
 	// Delegate called on player initialization
 	FOnRPGGameModePlayerInitialized OnGameModePlayerInitialized;
 
+	// Returns the experience manager of the game state, resolved once in InitGameState
+	URPGExperienceManagerComponent* GetExperienceManagerComponent() const { return ExperienceManagerComponent; }
+
 protected:	
 	void OnExperienceLoaded(const URPGExperienceDefinition* CurrentExperience);
 	bool IsExperienceLoaded() const;
 
+	// Resolves the spawn data of the experience before any other OnExperienceLoaded listener runs
+	void CacheExperienceSpawnData(const URPGExperienceDefinition* CurrentExperience);
+
 	void OnMatchAssignmentGiven(FPrimaryAssetId ExperienceId, const FString& ExperienceIdSource);
 
 	void HandleMatchAssignmentIfNotExpectingOne();
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<URPGExperienceManagerComponent> ExperienceManagerComponent;
+
+	// Pawn data and pawn class used by controllers without pawn data of their own, null until the experience has loaded
+	UPROPERTY(Transient)
+	TObjectPtr<const URPGPawnData> ExperiencePawnData;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UClass> ExperiencePawnClass;
 };
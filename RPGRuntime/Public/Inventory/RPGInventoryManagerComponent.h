@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Components/ActorComponent.h"
+#include "Components/GameFrameworkInitStateInterface.h"
 #include "Net/Serialization/FastArraySerializer.h"
 #include "Templates/SubclassOf.h"
 #include "RPGInventoryManagerComponent.generated.h"
@@ -104,15 +105,25 @@ struct TStructOpsTypeTraits<FRPGInventoryList> : public TStructOpsTypeTraitsBase
 /**
  * URPGInventoryManagerComponent
  * Manages an inventory of items.
+ * Registers the "Inventory" init state feature on its owner, it reaches GameplayReady once the component has begun play.
  */
 UCLASS(BlueprintType)
-class RPGRUNTIME_API URPGInventoryManagerComponent : public UActorComponent
+class RPGRUNTIME_API URPGInventoryManagerComponent : public UActorComponent, public IGameFrameworkInitStateInterface
 {
 	GENERATED_BODY()
 
 public:
 	URPGInventoryManagerComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	/** The name of this component-implemented feature */
+	static const FName NAME_ActorFeatureName;
+
+	//~ Begin IGameFrameworkInitStateInterface interface
+	virtual FName GetFeatureName() const override { return NAME_ActorFeatureName; }
+	virtual bool CanChangeInitState(UGameFrameworkComponentManager* Manager, FGameplayTag CurrentState, FGameplayTag DesiredState) const override;
+	virtual void CheckDefaultInitialization() override;
+	//~ End IGameFrameworkInitStateInterface interface
+
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
 	bool CanAddItemDefinition(TSubclassOf<URPGInventoryItemDefinition> ItemDef, int32 StackCount = 1);
 
@@ -132,6 +143,11 @@ public:
 	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 	virtual void ReadyForReplication() override;
 
+protected:
+	virtual void OnRegister() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 	UPROPERTY(Replicated)
 	FRPGInventoryList InventoryList;
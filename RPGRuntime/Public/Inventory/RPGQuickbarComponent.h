@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Components/ControllerComponent.h"
+#include "Components/GameFrameworkInitStateInterface.h"
 #include "RPGQuickbarComponent.generated.h"
 
 class URPGInventoryItemInstance;
@@ -10,15 +11,30 @@ class URPGEquipmentManagerComponent;
 /**
  * URPGQuickbarComponent
  * Manages quick-access slots for items.
+ * Registers the "Quickbar" init state feature on its controller. It reaches GameplayReady once its slots exist and
+ * the controller's inventory is ready too, so waiting on it means waiting for the whole controller side inventory.
  */
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent))
-class RPGRUNTIME_API URPGQuickbarComponent : public UControllerComponent
+class RPGRUNTIME_API URPGQuickbarComponent : public UControllerComponent, public IGameFrameworkInitStateInterface
 {
 	GENERATED_BODY()
 
 public:
 	URPGQuickbarComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	/** The name of this component-implemented feature */
+	static const FName NAME_ActorFeatureName;
+
+	//~ Begin IGameFrameworkInitStateInterface interface
+	virtual FName GetFeatureName() const override { return NAME_ActorFeatureName; }
+	virtual bool CanChangeInitState(UGameFrameworkComponentManager* Manager, FGameplayTag CurrentState, FGameplayTag DesiredState) const override;
+	virtual void OnActorInitStateChanged(const FActorInitStateChangedParams& Params) override;
+	virtual void CheckDefaultInitialization() override;
+	//~ End IGameFrameworkInitStateInterface interface
+
+	/** True once the quickbar and the inventory of the controller are both ready. */
+	static bool IsInventoryReady(const AController* Controller);
+
 	UFUNCTION(BlueprintCallable, Category = "RPG|Quickbar")
 	void CycleActiveSlotForward();
 
@@ -43,7 +59,9 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "RPG|Quickbar")
 	URPGInventoryItemInstance* RemoveItemFromSlot(int32 SlotIndex);
 
+	virtual void OnRegister() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	void UnequipItemInSlot();
@@ -79,6 +79,7 @@ public:
 	//~IRPGTeamAgentInterface interface
 	virtual void SetGenericTeamId(const FGenericTeamId& NewTeamID) override;
 	virtual FGenericTeamId GetGenericTeamId() const override;
+	virtual FOnRPGTeamIndexChangedDelegate* GetOnTeamIndexChangedDelegate() override;
 	//~End of IRPGTeamAgentInterface interface
 
 	static const FName NAME_RPGAbilityReady;
@@ -146,6 +147,9 @@ private:
 	UPROPERTY(Replicated)
 	ERPGPlayerConnectionType MyPlayerConnectionType;
 
+	UPROPERTY()
+	FOnRPGTeamIndexChangedDelegate OnTeamChangedDelegate;
+
 	UPROPERTY(ReplicatedUsing=OnRep_MyTeamID)
 	FGenericTeamId MyTeamID;
 
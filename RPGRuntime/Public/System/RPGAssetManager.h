@@ -5,10 +5,12 @@
 #include "System/LyraAssetManager.h"
 #include "System/RPGLogChannels.h"
 #include "System/RPGAssetManagerStartupJob.h"
+#include "System/RPGLoadedAssetTracker.h"
 #include "Templates/SubclassOf.h"
 #include "RPGAssetManager.generated.h"
 
 class UPrimaryDataAsset;
+class URPGExperienceDefinition;
 class URPGGameData;
 class URPGPawnData;
 
@@ -17,6 +19,9 @@ struct FRPGBundles
 	static const FName Equipped;
 };
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FRPGInitialGameContentLoadProgressDelegate, float /*GameContentPercent*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnRPGGameDataReady, const URPGGameData& /*GameData*/);
+
 /**
  * URPGAssetManager
  *
@@ -46,9 +51,40 @@ public:
 	// Logs all assets currently loaded and tracked by the asset manager.
 	static void DumpLoadedAssets();
 
+	// Args: [Sort=Inclusive|Exclusive|Name] [CSV] [Refs=N]
+	void DumpLoadedAssetsToOutputDevice(const TArray<FString>& Args, FOutputDevice& Ar);
+	void SnapshotLoadedAssets(const FString& SnapshotName, FOutputDevice& Ar);
+
+	// Diffs two stored snapshots, or a stored snapshot against the current state if AfterName is empty
+	void DiffLoadedAssets(const FString& BeforeName, const FString& AfterName, FOutputDevice& Ar);
+
+	// Records an asset the RPG asset manager keeps in memory and what pinned it
+	void TrackLoadedAsset(const UObject* Asset, const TCHAR* PinnedBy) { LoadedAssetTracker.TrackAsset(Asset, PinnedBy); }
+
+	// Snapshots the loaded assets and diffs them against the previous experience when rpg.assets.SnapshotOnExperienceLoad is set
+	void HandleExperienceLoaded(const URPGExperienceDefinition* Experience);
+
+	// Blocks until the game data is loaded. Outside of startup prefer CallOrRegister_OnGameDataReady.
 	const URPGGameData& GetGameData();
 	const URPGPawnData* GetDefaultPawnData() const;
 
+	// Returns the game data if it is already in memory, never loads
+	const URPGGameData* GetGameDataIfLoaded() const;
+	bool IsGameDataReady() const { return GetGameDataIfLoaded() != nullptr; }
+
+	// Ensures the delegate is called once the game data has been loaded, streaming it in if needed
+	// If the game data has already loaded, calls the delegate immediately
+	void CallOrRegister_OnGameDataReady(FOnRPGGameDataReady::FDelegate&& Delegate);
+
+	// True once every startup job completed, blocking loads after this point hitch gameplay
+	bool HasFinishedStartupJobs() const { return bStartupJobsComplete; }
+
+	// Logs the blocking load with a callstack when rpg.assets.LogSyncLoads is enabled and startup is over
+	void ReportSynchronousLoad(const FString& AssetName, const TCHAR* Context);
+
+	// Broadcast while the startup jobs run with the weighted completion in [0, 1], for the early loading screen
+	static FRPGInitialGameContentLoadProgressDelegate OnInitialGameContentLoadProgress;
+
 protected:
 	template <typename GameDataClass>
 	const GameDataClass& GetOrLoadTypedGameData(const TSoftObjectPtr<GameDataClass>& DataPath)
@@ -80,6 +116,14 @@ protected:
 
 	UPrimaryDataAsset* LoadGameDataOfClass(TSubclassOf<UPrimaryDataAsset> DataClass, const TSoftObjectPtr<UPrimaryDataAsset>& DataClassPath, FPrimaryAssetType PrimaryAssetType);
 
+	// Starts streaming the game data and default pawn data so they load while the other startup jobs run
+	TSharedPtr<FStreamableHandle> RequestGameDataLoad();
+	TSharedPtr<FStreamableHandle> RequestDefaultPawnDataLoad();
+
+	void HandleGameDataLoaded();
+	void BroadcastGameDataReady(const URPGGameData& GameData);
+	void HandleSyncLoadPackage(const FString& PackageName);
+
 protected:
 	// Global game data asset to use for the RPG plugin.
 	UPROPERTY(Config)
@@ -90,7 +134,7 @@ protected:
 	TSoftObjectPtr<URPGPawnData> RPGDefaultPawnData;
 
 private:
-	// Flushes the StartupJobs array. Processes all startup work.
+	// Flushes the StartupJobs array. Runs independent jobs concurrently and respects their prerequisites.
 	void DoAllStartupJobs();
 
 	// Called periodically during loads, could be used to feed the status to a loading screen
@@ -98,6 +142,19 @@ private:
 
 	// The list of tasks to execute on startup. Used to track startup progress.
 	TArray<FRPGAssetManagerStartupJob> StartupJobs;
+
+	FOnRPGGameDataReady OnGameDataReady;
+	TSharedPtr<FStreamableHandle> GameDataLoadHandle;
+
+	// Packages already reported by the sync load debug mode, each one is only logged once
+	TSet<FString> ReportedSyncLoads;
+	FDelegateHandle SyncLoadPackageHandle;
+
+	bool bStartupJobsComplete = false;
+
+	FRPGLoadedAssetTracker LoadedAssetTracker;
+	FString LastExperienceSnapshotName;
+	int32 NumExperienceSnapshots = 0;
 };
 
 
@@ -113,6 +170,7 @@ AssetType* URPGAssetManager::GetAsset(const TSoftObjectPtr<AssetType>& AssetPoin
 		LoadedAsset = AssetPointer.Get();
 		if (!LoadedAsset)
 		{
+			Get().ReportSynchronousLoad(AssetPath.GetLongPackageName(), TEXT("GetAsset"));
 			LoadedAsset = Cast<AssetType>(SynchronousLoadAsset(AssetPath));
 			ensureAlwaysMsgf(LoadedAsset, TEXT("Failed to load asset [%s]"), *AssetPointer.ToString());
 		}
@@ -120,6 +178,7 @@ AssetType* URPGAssetManager::GetAsset(const TSoftObjectPtr<AssetType>& AssetPoin
 		if (LoadedAsset && bKeepInMemory)
 		{
 			Get().AddLoadedAsset(Cast<UObject>(LoadedAsset));
+			Get().TrackLoadedAsset(Cast<UObject>(LoadedAsset), TEXT("GetAsset"));
 		}
 	}
 
@@ -138,6 +197,7 @@ TSubclassOf<AssetType> URPGAssetManager::GetSubclass(const TSoftClassPtr<AssetTy
 		LoadedSubclass = AssetPointer.Get();
 		if (!LoadedSubclass)
 		{
+			Get().ReportSynchronousLoad(AssetPath.GetLongPackageName(), TEXT("GetSubclass"));
 			LoadedSubclass = Cast<UClass>(SynchronousLoadAsset(AssetPath));
 			ensureAlwaysMsgf(LoadedSubclass, TEXT("Failed to load asset class [%s]"), *AssetPointer.ToString());
 		}
@@ -145,6 +205,7 @@ TSubclassOf<AssetType> URPGAssetManager::GetSubclass(const TSoftClassPtr<AssetTy
 		if (LoadedSubclass && bKeepInMemory)
 		{
 			Get().AddLoadedAsset(Cast<UObject>(LoadedSubclass));
+			Get().TrackLoadedAsset(Cast<UObject>(LoadedSubclass), TEXT("GetSubclass"));
 		}
 	}
 
@@ -7,11 +7,23 @@
 struct FStreamableHandle;
 class URPGAssetManager;
 
+/** Where a startup job is allowed to run. */
+enum class ERPGStartupJobThread : uint8
+{
+	// Default, the job can touch UObjects and start streamable loads
+	GameThread,
+
+	// Pure CPU work dispatched to the task graph, must not touch UObjects or start loads
+	AnyThread,
+};
+
 /**
  * FRPGAssetManagerStartupJob
- * 
+ *
  * Represents a task to be executed during the RPGAssetManager's initial loading phase.
  * Standalone version of LyraAssetManagerStartupJob.
+ * Jobs only wait for the jobs listed in Prerequisites, independent ones run concurrently.
+ * A job that hands back a streamable handle is complete once that load finished.
  */
 struct FRPGAssetManagerStartupJob
 {
@@ -22,9 +34,15 @@ struct FRPGAssetManagerStartupJob
 	float JobWeight;
 	TSharedPtr<FStreamableHandle> Handle;
 
+	// Names of the jobs that must be complete before this one starts
+	TArray<FString> Prerequisites;
+
+	ERPGStartupJobThread Thread;
+
 	FRPGAssetManagerStartupJob()
 		: JobName(TEXT("Unknown"))
 		, JobWeight(1.0f)
+		, Thread(ERPGStartupJobThread::GameThread)
 	{
 	}
 
@@ -32,12 +50,27 @@ struct FRPGAssetManagerStartupJob
 		: JobDelegate(InJobDelegate)
 		, JobName(InJobName)
 		, JobWeight(InJobWeight)
+		, Thread(ERPGStartupJobThread::GameThread)
+	{
+	}
+
+	FRPGAssetManagerStartupJob& DependsOn(const FString& PrerequisiteJobName)
+	{
+		Prerequisites.Add(PrerequisiteJobName);
+		return *this;
+	}
+
+	FRPGAssetManagerStartupJob& RunOn(ERPGStartupJobThread InThread)
 	{
+		Thread = InThread;
+		return *this;
 	}
 
-	void DoJob() const
+	/** Runs the job and returns the handle of the async load it started, if any. */
+	TSharedPtr<FStreamableHandle> DoJob() const
 	{
 		TSharedPtr<FStreamableHandle> MutableHandle;
 		JobDelegate.ExecuteIfBound(*this, MutableHandle);
+		return MutableHandle;
 	}
 };
@@ -5,9 +5,11 @@
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "RPGAsyncAction_WaitForInventoryReady.generated.h"
 
+class AController;
 class APawn;
 class URPGInventoryManagerComponent;
 class URPGQuickbarComponent;
+struct FActorInitStateChangedParams;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FRPGInventoryReadyDelegate);
 
@@ -15,6 +17,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FRPGInventoryReadyDelegate);
  * URPGAsyncAction_WaitForInventoryReady
  *
  *	Async action to wait for the inventory and quickbar components to be ready on a pawn's controller.
+ *	Listens to the pawn's controller changes and to the quickbar init state, nothing is polled.
  */
 UCLASS()
 class RPGRUNTIME_API URPGAsyncAction_WaitForInventoryReady : public UBlueprintAsyncActionBase
@@ -31,16 +34,26 @@ public:
 	static URPGAsyncAction_WaitForInventoryReady* WaitForInventoryReady(APawn* Pawn);
 
 	virtual void Activate() override;
+	virtual void SetReadyToDestroy() override;
 
 public:
 	UPROPERTY(BlueprintAssignable)
 	FRPGInventoryReadyDelegate OnReady;
 
 private:
-	void Step();
+	void WaitForController(AController* Controller);
+
+	UFUNCTION()
+	void HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+	void HandleInventoryReady(const FActorInitStateChangedParams& Params);
+
+	void Finish();
+	void StopListening();
 
 	UPROPERTY()
 	TWeakObjectPtr<APawn> BoundPawn;
 
-	FTimerHandle TimerHandle;
+	TWeakObjectPtr<AController> WatchedController;
+	FDelegateHandle InventoryReadyHandle;
 };
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FOutputDevice;
+class UObject;
+
+/**
+ * RPGCosmeticPolicy
+ *
+ *	Decides where cosmetic-only work (context effects, cosmetic anim notifies, HUD widgets) runs.
+ *	Cosmetics run on clients and listen-server hosts, never on dedicated servers.
+ *	With rpg.cosmetics.StrictServerMode enabled, a dedicated server reports every cosmetic path that still executes.
+ */
+namespace RPGCosmeticPolicy
+{
+	/** Returns true if cosmetic-only work should run in the world of the given object. */
+	RPGRUNTIME_API bool ShouldRunCosmetics(const UObject* WorldContextObject);
+
+	/** Call from the top of a cosmetic path. In strict mode on a dedicated server, the path is logged once and counted. */
+	RPGRUNTIME_API void ReportCosmeticPath(const UObject* WorldContextObject, const TCHAR* PathName);
+
+	RPGRUNTIME_API void DumpCosmeticPaths(FOutputDevice& Ar);
+}
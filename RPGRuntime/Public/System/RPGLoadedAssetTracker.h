@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "UObject/PrimaryAssetId.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "HAL/CriticalSection.h"
+
+class FOutputDevice;
+class UAssetManager;
+
+/** Sort order of a loaded asset report. */
+enum class ERPGLoadedAssetSort : uint8
+{
+	Inclusive,
+	Exclusive,
+	Name,
+};
+
+/**
+ * FRPGLoadedAssetRecord
+ *
+ *	One asset kept in memory by the asset manager, as captured in a snapshot.
+ */
+struct FRPGLoadedAssetRecord
+{
+	FSoftObjectPath Path;
+	FName ClassName;
+	FPrimaryAssetId PrimaryAssetId;
+
+	// What asked the asset manager to keep the asset (GetAsset, GameDataMap, primary asset handle...)
+	FString PinnedBy;
+
+	// Active bundles of primary assets loaded through the asset manager
+	FString Bundles;
+
+	// Objects outside of the asset package referencing it, only filled on request because it is a full reference search
+	FString Referencers;
+
+	int64 ExclusiveBytes = 0;
+	int64 InclusiveBytes = 0;
+};
+
+/**
+ * FRPGLoadedAssetSnapshot
+ */
+struct FRPGLoadedAssetSnapshot
+{
+	FString Name;
+	FDateTime Time;
+	TArray<FRPGLoadedAssetRecord> Records;
+
+	int64 GetTotalExclusiveBytes() const;
+	int64 GetTotalInclusiveBytes() const;
+};
+
+/**
+ * FRPGLoadedAssetTracker
+ *
+ *	Keeps track of the assets the RPG asset manager pinned in memory and captures snapshots of them,
+ *	together with the primary assets loaded through the asset manager and their bundle state.
+ *	Snapshots can be printed sorted, written to CSV or diffed against each other to find leaks.
+ */
+class RPGRUNTIME_API FRPGLoadedAssetTracker
+{
+public:
+	/** Records that the asset is kept in memory because of PinnedBy. */
+	void TrackAsset(const UObject* Asset, const TCHAR* PinnedBy);
+
+	/** Captures every tracked asset still alive and every loaded primary asset. */
+	FRPGLoadedAssetSnapshot Capture(const UAssetManager& AssetManager, const FString& SnapshotName, int32 NumReferencerSearches = 0) const;
+
+	/** Keeps the snapshot for later diffs, replacing any snapshot with the same name. */
+	void StoreSnapshot(FRPGLoadedAssetSnapshot&& Snapshot);
+	const FRPGLoadedAssetSnapshot* FindSnapshot(const FString& SnapshotName) const;
+	const TArray<FRPGLoadedAssetSnapshot>& GetSnapshots() const { return Snapshots; }
+
+	static void SortRecords(TArray<FRPGLoadedAssetRecord>& Records, ERPGLoadedAssetSort SortMode);
+	static void WriteText(const FRPGLoadedAssetSnapshot& Snapshot, FOutputDevice& Ar);
+	static FString WriteCsv(const FRPGLoadedAssetSnapshot& Snapshot);
+	static void WriteDiff(const FRPGLoadedAssetSnapshot& Before, const FRPGLoadedAssetSnapshot& After, FOutputDevice& Ar);
+
+private:
+	struct FTrackedAsset
+	{
+		TWeakObjectPtr<const UObject> Asset;
+		FString PinnedBy;
+	};
+
+	// GetAsset can be called from loading threads
+	mutable FCriticalSection TrackedAssetsCritical;
+	TMap<FSoftObjectPath, FTrackedAsset> TrackedAssets;
+
+	TArray<FRPGLoadedAssetSnapshot> Snapshots;
+};
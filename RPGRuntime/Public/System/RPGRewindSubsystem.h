@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RPGRewindSubsystem.generated.h"
+
+class ARPGCharacter;
+class FOutputDevice;
+
+/** One recorded pose of a character. Capsules are always upright so no rotation is stored. */
+struct FRPGRewindFrame
+{
+	static constexpr int32 MaxKeyBones = 4;
+
+	float Timestamp = 0.0f;
+	FVector3f CapsuleCenter = FVector3f::ZeroVector;
+	float CapsuleHalfHeight = 0.0f;
+	float CapsuleRadius = 0.0f;
+	FVector3f KeyBoneLocations[MaxKeyBones];
+	uint8 NumKeyBones = 0;
+
+	static FRPGRewindFrame Lerp(const FRPGRewindFrame& A, const FRPGRewindFrame& B, float Alpha);
+};
+
+/**
+ * FRPGRewindHistory
+ *
+ *	Fixed-size ring buffer of frames, ordered by timestamp.
+ *	Storage is allocated once in Init() and reused for the lifetime of the slot.
+ */
+struct RPGRUNTIME_API FRPGRewindHistory
+{
+	void Init(int32 InCapacity);
+	void Reset();
+
+	/** Pushes a frame, overwriting the oldest one when full. Frames older than the newest are dropped. */
+	void Push(const FRPGRewindFrame& Frame);
+
+	/** Interpolates the pose at the timestamp, clamped to the recorded range. Returns false if empty. */
+	bool Sample(float Timestamp, FRPGRewindFrame& OutFrame) const;
+
+	int32 Num() const { return NumFrames; }
+	int32 GetCapacity() const { return Frames.Num(); }
+	SIZE_T GetAllocatedSize() const { return Frames.GetAllocatedSize(); }
+
+	float GetOldestTimestamp() const { return NumFrames > 0 ? GetFrame(0).Timestamp : 0.0f; }
+	float GetNewestTimestamp() const { return NumFrames > 0 ? GetFrame(NumFrames - 1).Timestamp : 0.0f; }
+
+private:
+	// Logical index, 0 is the oldest frame
+	const FRPGRewindFrame& GetFrame(int32 Index) const { return Frames[(Head + Index) % Frames.Num()]; }
+
+	TArray<FRPGRewindFrame> Frames;
+	int32 Head = 0;
+	int32 NumFrames = 0;
+};
+
+/** Result of validating a sweep against a rewound target. */
+struct FRPGRewindValidationResult
+{
+	bool bHit = false;
+	float Distance = 0.0f;
+	float RewoundTimestamp = 0.0f;
+	FVector ClosestPoint = FVector::ZeroVector;
+};
+
+/**
+ * URPGRewindSubsystem
+ *
+ *	Server side lag compensation. Records the capsule and a few key bones of every character
+ *	on the subsystem tick, at most MaxRecordRate times per second and stamped with server world time,
+ *	so hits traced against what a client saw can be validated against the targets rewound to that time.
+ */
+UCLASS(Config = Game)
+class RPGRUNTIME_API URPGRewindSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	URPGRewindSubsystem();
+
+	static URPGRewindSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+	//~End of FTickableGameObject interface
+
+	void RegisterCharacter(ARPGCharacter* Character);
+	void UnregisterCharacter(ARPGCharacter* Character);
+
+	/**
+	 * Validates a sphere swept from Start to End against the target as it was at ClientTimestamp (server world time).
+	 * Timestamps older than the max rewind time are clamped. Returns false if the target has no history.
+	 */
+	bool ValidateSweep(const AActor* Target, float ClientTimestamp, const FVector& Start, const FVector& End, float SweepRadius, FRPGRewindValidationResult& OutResult) const;
+
+	/** Same as ValidateSweep against a raw history, used by the benchmark. */
+	static bool ValidateSweepAgainstHistory(const FRPGRewindHistory& History, float Timestamp, const FVector& Start, const FVector& End, float SweepRadius, float BoneRadius, float Tolerance, FRPGRewindValidationResult& OutResult);
+
+	/** Number of frames each history holds. */
+	int32 GetHistoryCapacity() const;
+
+	void DumpToOutputDevice(FOutputDevice& Ar) const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	struct FTrackedCharacter
+	{
+		TWeakObjectPtr<ARPGCharacter> Character;
+		int32 HistoryIndex = INDEX_NONE;
+		float NextRecordTime = -1.0f;
+	};
+
+	int32 AcquireHistory();
+	void RecordCharacter(FTrackedCharacter& Tracked, float WorldTime);
+
+protected:
+	// Seconds of history kept per character
+	UPROPERTY(Config, EditAnywhere, Category = "Rewind")
+	float HistoryDuration = 1.0f;
+
+	// Maximum recording rate, decides the ring buffer capacity
+	UPROPERTY(Config, EditAnywhere, Category = "Rewind")
+	float MaxRecordRate = 60.0f;
+
+	// Bones recorded in addition to the capsule, at most FRPGRewindFrame::MaxKeyBones
+	UPROPERTY(Config, EditAnywhere, Category = "Rewind")
+	TArray<FName> KeyBones;
+
+	// Radius of the sphere around each key bone
+	UPROPERTY(Config, EditAnywhere, Category = "Rewind")
+	float KeyBoneRadius = 15.0f;
+
+private:
+	TArray<FTrackedCharacter> TrackedCharacters;
+	TMap<TObjectKey<AActor>, int32> TrackedIndexByActor;
+
+	// Ring buffers are pooled so characters coming and going don't allocate
+	TArray<FRPGRewindHistory> Histories;
+	TArray<int32> FreeHistories;
+
+	// Debug counters
+	mutable int32 NumQueries = 0;
+	mutable int32 NumRejectedQueries = 0;
+};
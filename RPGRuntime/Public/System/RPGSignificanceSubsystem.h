@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
+#include "RPGSignificanceSubsystem.generated.h"
+
+class AAIController;
+class ARPGCharacter;
+class FOutputDevice;
+
+/**
+ * FRPGSignificanceBucketSettings
+ *
+ *	Update rates applied to every character that falls into a significance bucket.
+ *	Bucket 0 is the most significant (full rate); higher buckets are cheaper.
+ */
+USTRUCT()
+struct FRPGSignificanceBucketSettings
+{
+	GENERATED_BODY()
+
+	// Minimum score needed to enter this bucket
+	UPROPERTY(EditAnywhere, Category = "Significance")
+	float MinScore = 0.0f;
+
+	// Tick interval for the character actor (0 = every frame)
+	UPROPERTY(EditAnywhere, Category = "Significance")
+	float ActorTickInterval = 0.0f;
+
+	// Tick interval for the movement component of AI driven characters
+	UPROPERTY(EditAnywhere, Category = "Significance")
+	float MovementTickInterval = 0.0f;
+
+	// Tick interval for the skeletal mesh, which drives the anim instance update rate
+	UPROPERTY(EditAnywhere, Category = "Significance")
+	float AnimTickInterval = 0.0f;
+
+	// Tick interval for the AI controller, its brain and its perception component
+	UPROPERTY(EditAnywhere, Category = "Significance")
+	float AIUpdateInterval = 0.0f;
+
+	// Whether context effects (footsteps, etc...) are emitted for characters in this bucket
+	UPROPERTY(EditAnywhere, Category = "Significance")
+	bool bEmitContextEffects = true;
+};
+
+/**
+ * URPGSignificanceSubsystem
+ *
+ *	Scores every registered character by distance to the viewers (local cameras, or connected
+ *	players' pawns on a dedicated server), on-screen state and combat relevance, then throttles
+ *	its actor, movement, animation and AI update rates by bucket.
+ */
+UCLASS(Config = Game)
+class RPGRUNTIME_API URPGSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	URPGSignificanceSubsystem();
+
+	static URPGSignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+	void RegisterCharacter(ARPGCharacter* Character);
+	void UnregisterCharacter(ARPGCharacter* Character);
+
+	/** Returns the current bucket of the actor, 0 if it is not tracked. */
+	int32 GetSignificanceBucket(const AActor* Actor) const;
+
+	/** Returns true if context effects should be emitted for the actor. Untracked actors always emit. */
+	bool ShouldEmitContextEffects(const AActor* Actor) const;
+
+	/** Convenience wrapper usable from anywhere that has an actor. */
+	static bool ShouldEmitContextEffectsFor(const AActor* Actor);
+
+	void DumpToOutputDevice(FOutputDevice& Ar) const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	struct FViewerInfo
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Direction = FVector::ForwardVector;
+		float CosHalfFOV = 0.0f;
+		bool bIsLocalView = false;
+	};
+
+	// Tick intervals authored on the character and its controller, restored in bucket 0
+	struct FAuthoredTickIntervals
+	{
+		float Actor = 0.0f;
+		float Movement = 0.0f;
+		float Anim = 0.0f;
+
+		// Captured the first time the AI controller is throttled, the character can be possessed after registering
+		TWeakObjectPtr<AAIController> AIController;
+		float AIControllerActor = 0.0f;
+		float Brain = 0.0f;
+		float Perception = 0.0f;
+	};
+
+	struct FSignificanceEntry
+	{
+		TWeakObjectPtr<ARPGCharacter> Character;
+		FAuthoredTickIntervals AuthoredIntervals;
+		float Score = 0.0f;
+		int32 Bucket = 0;
+		int32 AppliedBucket = INDEX_NONE;
+		bool bIsPlayerControlled = false;
+	};
+
+	void GatherViewers(TArray<FViewerInfo>& OutViewers) const;
+	float CalculateScore(const FSignificanceEntry& Entry, const TArray<FViewerInfo>& Viewers) const;
+	int32 SelectBucket(float Score, int32 PreviousBucket) const;
+	void UpdateSignificance();
+	void ApplyBucket(ARPGCharacter* Character, FSignificanceEntry& Entry, int32 BucketIndex) const;
+
+protected:
+	// Ordered from most to least significant
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	TArray<FRPGSignificanceBucketSettings> Buckets;
+
+	// Characters with any of these tags get the combat bonus
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	FGameplayTagContainer CombatRelevanceTags;
+
+	// Distance at which the distance score reaches zero
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	float MaxSignificanceDistance = 10000.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	float OnScreenBonus = 0.5f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	float CombatBonus = 0.75f;
+
+private:
+	TArray<FSignificanceEntry> Entries;
+	TMap<TObjectKey<AActor>, int32> EntryIndexByActor;
+
+	float TimeSinceLastUpdate = 0.0f;
+
+	// Debug counters, refreshed every update
+	TArray<int32> BucketCounts;
+	int32 NumBudgetDemotions = 0;
+	int32 NumBucketChanges = 0;
+};
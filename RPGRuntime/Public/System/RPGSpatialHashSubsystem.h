@@ -0,0 +1,173 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/SparseArray.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RPGSpatialHashSubsystem.generated.h"
+
+class ARPGCharacter;
+class FOutputDevice;
+class URPGHealthComponent;
+
+/**
+ * FRPGSpatialHashGrid
+ *
+ *	Uniform 2D grid of ids. Stores no positions, callers test the candidates against their own data.
+ */
+class RPGRUNTIME_API FRPGSpatialHashGrid
+{
+public:
+	void Init(float InCellSize);
+	void Reset();
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	void Insert(int32 Id, const FIntPoint& Cell);
+	void Remove(int32 Id, const FIntPoint& Cell);
+	void Move(int32 Id, const FIntPoint& FromCell, const FIntPoint& ToCell);
+
+	/** Calls Func(Id) for every id in the cells overlapping the circle. */
+	template <typename FuncType>
+	void ForEachCandidate(const FVector& Center, float Radius, FuncType&& Func) const
+	{
+		const FIntPoint MinCell = GetCell(Center - FVector(Radius, Radius, 0.0));
+		const FIntPoint MaxCell = GetCell(Center + FVector(Radius, Radius, 0.0));
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				if (const TArray<int32>* Ids = Cells.Find(FIntPoint(X, Y)))
+				{
+					for (const int32 Id : *Ids)
+					{
+						Func(Id);
+					}
+				}
+			}
+		}
+	}
+
+	float GetCellSize() const { return CellSize; }
+	int32 GetNumCells() const { return Cells.Num(); }
+
+private:
+	TMap<FIntPoint, TArray<int32>> Cells;
+	float CellSize = 500.0f;
+	float InvCellSize = 1.0f / 500.0f;
+};
+
+/**
+ * ERPGSpatialTeamFilter
+ */
+enum class ERPGSpatialTeamFilter : uint8
+{
+	Any,
+	SameTeam,
+	OtherTeams
+};
+
+/**
+ * FRPGSpatialQueryFilter
+ *
+ *	Filter shared by every spatial query.
+ */
+struct FRPGSpatialQueryFilter
+{
+	// Team the filter is relative to (INDEX_NONE = no team)
+	int32 TeamId = INDEX_NONE;
+	ERPGSpatialTeamFilter TeamFilter = ERPGSpatialTeamFilter::Any;
+
+	// Skip characters that are dead or dying
+	bool bAliveOnly = true;
+
+	// Usually the querying character
+	const AActor* IgnoredActor = nullptr;
+};
+
+/**
+ * URPGSpatialHashSubsystem
+ *
+ *	Keeps every registered character in a uniform grid so targeting, aggro, area effects and interaction
+ *	can run radius, cone and nearest queries without touching the physics scene.
+ *	Characters are only moved between cells when they cross a cell boundary.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGSpatialHashSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URPGSpatialHashSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+	void RegisterCharacter(ARPGCharacter* Character);
+	void UnregisterCharacter(ARPGCharacter* Character);
+
+	/** Re-resolves the cached team of a character, call when its controller or player state changes. */
+	void RefreshCharacterTeam(ARPGCharacter* Character);
+
+	/** Characters within Radius of Center. */
+	void QueryRadius(const FVector& Center, float Radius, const FRPGSpatialQueryFilter& Filter, TArray<ARPGCharacter*>& OutCharacters) const;
+
+	/** Characters within Radius of Origin and HalfAngleDegrees of Direction (2D). */
+	void QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, const FRPGSpatialQueryFilter& Filter, TArray<ARPGCharacter*>& OutCharacters) const;
+
+	/** Up to Count characters within MaxRadius of Center, nearest first. */
+	void QueryNearest(const FVector& Center, float MaxRadius, int32 Count, const FRPGSpatialQueryFilter& Filter, TArray<ARPGCharacter*>& OutCharacters) const;
+
+	/** Resolves the team of a character from itself, its player state or its controller. */
+	static int32 ResolveTeamId(const ARPGCharacter* Character);
+
+	/** Returns the object ResolveTeamId reads the team from, null if the character has no team yet. */
+	static UObject* FindTeamSource(const ARPGCharacter* Character);
+
+	void DumpToOutputDevice(FOutputDevice& Ar) const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	struct FAgent
+	{
+		TWeakObjectPtr<ARPGCharacter> Character;
+		TWeakObjectPtr<URPGHealthComponent> HealthComponent;
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+
+		// Cached, updated from the team changed delegate of TeamSource instead of resolved every frame
+		int32 TeamId = INDEX_NONE;
+		TWeakObjectPtr<UObject> TeamSource;
+	};
+
+	bool PassesFilter(const FAgent& Agent, const FRPGSpatialQueryFilter& Filter) const;
+
+	void UpdateAgentTeam(FAgent& Agent);
+	void UnbindTeamSource(UObject* TeamSource);
+
+	UFUNCTION()
+	void HandleTeamChanged(UObject* ObjectChangingTeam, int32 OldTeamID, int32 NewTeamID);
+
+private:
+	FRPGSpatialHashGrid Grid;
+
+	// Sparse so ids stored in the grid stay valid when characters unregister
+	TSparseArray<FAgent> Agents;
+	TMap<TObjectKey<AActor>, int32> AgentIdByActor;
+
+	// Debug counters
+	int32 NumCellChanges = 0;
+	mutable int32 NumQueries = 0;
+};
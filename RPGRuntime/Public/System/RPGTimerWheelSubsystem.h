@@ -0,0 +1,208 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "RPGTimerWheelSubsystem.generated.h"
+
+class FOutputDevice;
+
+DECLARE_DYNAMIC_DELEGATE(FRPGTimerWheelDynamicDelegate);
+
+/**
+ * FRPGTimerWheelHandle
+ *
+ *	Cancellation token for a timer scheduled on the timer wheel.
+ *	The serial makes stale handles harmless once their slot has been recycled.
+ */
+USTRUCT(BlueprintType)
+struct RPGRUNTIME_API FRPGTimerWheelHandle
+{
+	GENERATED_BODY()
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+
+	bool operator==(const FRPGTimerWheelHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FRPGTimerWheelHandle& Other) const { return !(*this == Other); }
+
+private:
+	friend class FRPGTimerWheel;
+
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+};
+
+/**
+ * FRPGTimerWheel
+ *
+ *	Hierarchical hashed timer wheel with a fixed tick granularity.
+ *	Level 0 holds the timers due within the next NumSlots ticks, each higher level covers NumSlots times
+ *	the range of the one below and is cascaded down when the lower level wraps around.
+ *	Insert and cancel are O(1), every bucket is fired as one batch when the wheel reaches it.
+ */
+class RPGRUNTIME_API FRPGTimerWheel
+{
+public:
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 NumSlots = 1 << SlotBits;
+	static constexpr int32 NumLevels = 4;
+
+	explicit FRPGTimerWheel(double InTickInterval = 0.01);
+
+	/**
+	 * Schedules a callback Delay seconds from now, rounded up to the wheel granularity.
+	 * A positive Rate re-arms the timer every Rate seconds until it is cancelled.
+	 * When an owner is given the timer is silently dropped once the owner has been destroyed.
+	 */
+	FRPGTimerWheelHandle Schedule(FTimerDelegate&& Callback, double Delay, double Rate = 0.0, const UObject* Owner = nullptr);
+
+	/** Cancels the timer and invalidates the handle. Returns true if the timer was still pending. */
+	bool Cancel(FRPGTimerWheelHandle& Handle);
+
+	/** Cancels every pending timer owned by the object. Linear in the number of pending timers. */
+	int32 CancelAllForOwner(const UObject* Owner);
+
+	bool IsPending(const FRPGTimerWheelHandle& Handle) const;
+
+	/** Returns the seconds left before the timer fires, or -1 if it is not pending. */
+	double GetRemainingTime(const FRPGTimerWheelHandle& Handle) const;
+
+	/** Moves the wheel forward, fires every bucket reached on the way and returns the number of callbacks executed. */
+	int32 Advance(double DeltaTime);
+
+	/** Drops every pending timer without firing it. */
+	void Reset();
+
+	int32 GetNumPending() const { return NumPending; }
+	double GetTickInterval() const { return TickInterval; }
+	uint64 GetCurrentTick() const { return CurrentTick; }
+
+	/** Number of timers stored in every level of the wheel. */
+	void GetLevelCounts(int32 OutCounts[NumLevels]) const;
+
+private:
+	struct FEntry
+	{
+		FTimerDelegate Callback;
+		TWeakObjectPtr<const UObject> Owner;
+		uint64 ExpireTick = 0;
+		uint64 RateTicks = 0;
+		uint32 Serial = 0;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		int8 Level = INDEX_NONE;
+		uint8 Slot = 0;
+		bool bPending = false;
+		bool bHasOwner = false;
+	};
+
+	uint64 SecondsToTicks(double Seconds) const;
+	int32 AllocateEntry();
+	void FreeEntry(int32 Index);
+	void Link(int32 Index);
+	void Unlink(int32 Index);
+	bool IsHandleCurrent(const FRPGTimerWheelHandle& Handle) const;
+
+	/** Cascades the higher levels that wrapped, then fires the level 0 bucket of the current tick. */
+	int32 ProcessTick();
+	void CascadeSlot(int32 Level, int32 Slot);
+	int32 FireSlot(int32 Slot);
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeList;
+	int32 Heads[NumLevels][NumSlots];
+
+	// Reused between batches so firing a bucket doesn't allocate
+	TArray<TPair<int32, uint32>> FireBatch;
+
+	double TickInterval = 0.01;
+	double AccumulatedTime = 0.0;
+	uint64 CurrentTick = 0;
+	uint32 NextSerial = 1;
+	int32 NumPending = 0;
+};
+
+/**
+ * URPGTimerWheelSubsystem
+ *
+ *	Per world timer wheel for short lived gameplay delays (respawn countdowns, next tick deferrals,
+ *	ability waits) so they don't each add an entry to the FTimerManager heap.
+ *	Timers bound to a UObject are tied to its lifetime and never fire after it is destroyed.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGTimerWheelSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	URPGTimerWheelSubsystem();
+
+	static URPGTimerWheelSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+	/** Schedules the delegate. The object the delegate is bound to, if any, owns the timer. */
+	FRPGTimerWheelHandle SetTimer(FTimerDelegate Delegate, float Delay, bool bLoop = false);
+
+	template<class UserClass>
+	FRPGTimerWheelHandle SetTimer(UserClass* Object, typename FTimerDelegate::template TMethodPtr<UserClass> Method, float Delay, bool bLoop = false)
+	{
+		return SetTimer(FTimerDelegate::CreateUObject(Object, Method), Delay, bLoop);
+	}
+
+	/** Runs the delegate at the start of the next frame, batched with every other deferral of this frame. */
+	void SetTimerForNextTick(FTimerDelegate Delegate);
+
+	template<class UserClass>
+	void SetTimerForNextTick(UserClass* Object, typename FTimerDelegate::template TMethodPtr<UserClass> Method)
+	{
+		SetTimerForNextTick(FTimerDelegate::CreateUObject(Object, Method));
+	}
+
+	void ClearTimer(FRPGTimerWheelHandle& Handle);
+	void ClearAllTimersForObject(const UObject* Object);
+
+	bool IsTimerActive(const FRPGTimerWheelHandle& Handle) const;
+	float GetTimerRemaining(const FRPGTimerWheelHandle& Handle) const;
+
+	// Blueprint and ability friendly wrappers
+	UFUNCTION(BlueprintCallable, Category = "RPG|Timers", meta = (WorldContext = "WorldContextObject", DisplayName = "Set Wheel Timer by Event"))
+	static FRPGTimerWheelHandle SetWheelTimerByEvent(UObject* WorldContextObject, FRPGTimerWheelDynamicDelegate Event, float Time, bool bLooping = false);
+
+	UFUNCTION(BlueprintCallable, Category = "RPG|Timers", meta = (WorldContext = "WorldContextObject"))
+	static void ClearWheelTimer(UObject* WorldContextObject, UPARAM(ref) FRPGTimerWheelHandle& Handle);
+
+	UFUNCTION(BlueprintPure, Category = "RPG|Timers", meta = (WorldContext = "WorldContextObject"))
+	static float GetWheelTimerRemaining(UObject* WorldContextObject, FRPGTimerWheelHandle Handle);
+
+	void DumpToOutputDevice(FOutputDevice& Ar) const;
+
+	/** Compares insert and fire cost of the wheel against a standalone FTimerManager. */
+	static void RunBenchmark(int32 NumTimers, FOutputDevice& Ar);
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	FRPGTimerWheel Wheel;
+
+	TArray<FTimerDelegate> NextTickQueue;
+	TArray<FTimerDelegate> NextTickBatch;
+
+	// Debug counters
+	int32 NumFiredLastFrame = 0;
+	int32 NumDeferredLastFrame = 0;
+	uint64 TotalFired = 0;
+};
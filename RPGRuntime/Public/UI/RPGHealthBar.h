@@ -10,14 +10,16 @@ class UImage;
 class UCommonNumericTextBlock;
 class URPGHealthComponent;
 class UMaterialInstanceDynamic;
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
 class UWidgetAnimation;
 
 /**
  * RPG Health Bar
  * - Giữ nguyên material Lyra
- * - Nội suy mượt bằng C++ (Tick thông minh)
+ * - Không Tick: chỉ cập nhật khi máu thay đổi, nội suy qua URPGUITweenSubsystem
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class RPGRUNTIME_API URPGHealthBar : public UCommonUserWidget
 {
 	GENERATED_BODY()
@@ -25,11 +27,15 @@ class RPGRUNTIME_API URPGHealthBar : public UCommonUserWidget
 public:
 	URPGHealthBar(const FObjectInitializer& ObjectInitializer);
 
+	// Binds the bar to a specific health component (e.g. overhead bars of enemies) instead of the possessed pawn
+	UFUNCTION(BlueprintCallable, Category = "Health Bar")
+	void SetHealthComponent(URPGHealthComponent* InHealthComponent);
+
 protected:
 	//~UUserWidget interface
 	virtual void NativeConstruct() override;
 	virtual void NativeDestruct() override;
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	//~End of UUserWidget interface
 
 protected:
 	/* =========================
@@ -38,6 +44,8 @@ protected:
 	void UpdateHealthBar(float OldValueNorm, float NewValueNorm, bool bSnap = false);
 	void UpdateVisuals(float VisualValueNorm);
 	void InitializeBarVisuals();
+	void HandleVisualHealthChanged(float VisualValueNorm);
+	void BindHealthComponent(URPGHealthComponent* HealthComponent);
 
 	UFUNCTION()
 	void HandleHealthChanged(URPGHealthComponent* HealthComponent, float OldValue, float NewValue, AActor* Instigator);
@@ -79,7 +87,10 @@ protected:
 
 	float CurrentVisualHealthNorm = 1.0f;
 	float TargetHealthNorm = 1.0f;
-	bool bIsAnimating = false;
+
+	// Follow the pawn possessed by the owning player, off once SetHealthComponent has been called
+	UPROPERTY(EditAnywhere, Category = "Health Bar")
+	bool bFollowPossessedPawn = true;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Health Bar")
 	float VisualInterpSpeed = 6.0f;
@@ -87,7 +98,6 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Health Bar")
 	float AnimationDelay = 0.5f;
 
-	float CurrentAnimationWaitTimer = 0.0f;
 	float CurrentDamageOrHealingState = -1.0f; // -1.0 for damage, 1.0 for healing
 
 protected:
@@ -103,6 +113,14 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<UMaterialInstanceDynamic> BarGlowMID = nullptr;
 
+	// Optional, the bar materials read the parameters from this collection instead of per widget MIDs.
+	// The collection is shared by the whole world, use it for the local player's bar only.
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bar")
+	TObjectPtr<UMaterialParameterCollection> ParameterCollection = nullptr;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialParameterCollectionInstance> ParameterCollectionInstance = nullptr;
+
 protected:
 	/* =========================
 	 *  Material Parameters (Lyra)
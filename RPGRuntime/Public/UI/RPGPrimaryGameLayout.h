@@ -112,12 +112,26 @@ public:
 
 		if (UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName))
 		{
+			if (ActivatableWidgetT* PrewarmedWidget = Cast<ActivatableWidgetT>(TakePrewarmedWidget(ActivatableWidgetClass)))
+			{
+				InitInstanceFunc(*PrewarmedWidget);
+				Layer->AddWidgetInstance(*PrewarmedWidget);
+				return PrewarmedWidget;
+			}
+
 			return Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, InitInstanceFunc);
 		}
 
 		return nullptr;
 	}
 
+	// Constructs an instance of the widget class ahead of its first push, typically while the loading screen is up.
+	// The next push of that exact class onto any layer takes the instance instead of constructing one.
+	void PrewarmWidget(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass);
+
+	// Drops the prewarmed instance of the class, if it was never pushed.
+	void ReleasePrewarmedWidget(TSubclassOf<UCommonActivatableWidget> ActivatableWidgetClass);
+
 	// Find the widget if it exists on any of the layers and remove it from the layer.
 	void FindAndRemoveWidgetFromLayer(UCommonActivatableWidget* ActivatableWidget);
 
@@ -134,6 +148,8 @@ protected:
 
 	void OnWidgetStackTransitioning(UCommonActivatableWidgetContainerBase* Widget, bool bIsTransitioning);
 
+	UCommonActivatableWidget* TakePrewarmedWidget(UClass* ActivatableWidgetClass);
+
 	UPROPERTY(meta = (BindWidget))
 	TObjectPtr<UCommonActivatableWidgetContainerBase> GameLayer_Stack;
 
@@ -156,4 +172,8 @@ private:
 	// The registered layers for the primary layout.
 	UPROPERTY(Transient)
 	TMap<FGameplayTag, TObjectPtr<UCommonActivatableWidgetContainerBase>> Layers;
+
+	// Constructed ahead of their first push, at most one per class
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonActivatableWidget>> PrewarmedWidgets;
 };
@@ -3,6 +3,7 @@
 
 #include "UI/RPGUserWidget.h"
 #include "GameplayTagContainer.h"
+#include "System/RPGTimerWheelSubsystem.h"
 #include "RPGRespawnTimerWidget.generated.h"
 
 struct FRPGRespawnTimerDurationMessage;
@@ -40,6 +41,7 @@ protected:
 
 private:
 	void UpdateCountdown();
+	void ClearCountdownTimer();
 
 	UPROPERTY(meta = (BindWidgetOptional))
 	TObjectPtr<UCommonTextBlock> Time;
@@ -53,7 +55,10 @@ private:
 	UPROPERTY(Transient, meta = (BindWidgetAnimOptional))
 	TObjectPtr<UWidgetAnimation> Outro;
 
-	FTimerHandle TimerHandle_UpdateCountdown;
+	FRPGTimerWheelHandle TimerHandle_UpdateCountdown;
+
+	// Used when the world has no timer wheel
+	FTimerHandle FallbackTimerHandle_UpdateCountdown;
 	
 	float TargetRespawnTime = 0.0f;
 	float TotalRespawnDuration = 0.0f;
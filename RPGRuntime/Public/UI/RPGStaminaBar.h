@@ -10,12 +10,15 @@ class UImage;
 class UCommonNumericTextBlock;
 class URPGHealthComponent;
 class UMaterialInstanceDynamic;
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
 
 /**
  * RPG Stamina Bar
  * Specialized widget for stamina display following Lyra patterns.
+ * Doesn't tick, updates on stamina changes and interpolates through URPGUITweenSubsystem.
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class RPGRUNTIME_API URPGStaminaBar : public UCommonUserWidget
 {
 	GENERATED_BODY()
@@ -26,12 +29,12 @@ public:
 protected:
 	virtual void NativeConstruct() override;
 	virtual void NativeDestruct() override;
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
 protected:
 	void UpdateStaminaBar(float OldValueNorm, float NewValueNorm, bool bSnap = false);
 	void UpdateVisuals(float VisualValueNorm);
 	void InitializeBarVisuals();
+	void HandleVisualStaminaChanged(float VisualValueNorm);
 
 	UFUNCTION()
 	void HandleStaminaChanged(URPGHealthComponent* HealthComponent, float OldValue, float NewValue, AActor* Instigator);
@@ -59,7 +62,6 @@ protected:
 
 	float CurrentVisualStaminaNorm = 1.0f;
 	float TargetStaminaNorm = 1.0f;
-	bool bIsAnimating = false;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Stamina Bar")
 	float VisualInterpSpeed = 15.0f; // Stamina usually interps faster than health
@@ -68,6 +70,13 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<UMaterialInstanceDynamic> BarFillMID = nullptr;
 
+	// Optional, the bar material reads the parameters from this collection instead of a per widget MID
+	UPROPERTY(EditDefaultsOnly, Category = "Stamina Bar")
+	TObjectPtr<UMaterialParameterCollection> ParameterCollection = nullptr;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialParameterCollectionInstance> ParameterCollectionInstance = nullptr;
+
 	static const FName Param_StaminaCurrent;
 	static const FName Param_StaminaUpdated;
 };
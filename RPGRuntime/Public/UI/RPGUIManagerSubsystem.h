@@ -5,12 +5,19 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "RPGUIManagerSubsystem.generated.h"
 
+class UCommonLocalPlayer;
+class ULocalPlayer;
+class URPGPrimaryGameLayout;
 class URPGUIPolicy;
+struct FStreamableHandle;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnRPGRootLayoutReady, UCommonLocalPlayer* /*LocalPlayer*/, URPGPrimaryGameLayout* /*RootLayout*/);
 
 /**
  * URPGUIManagerSubsystem
  *
  * The manager subsystem for the game UI.
+ * The policy class is streamed in at startup, root layouts only exist once the policy created them.
  */
 UCLASS(Config = Game)
 class RPGRUNTIME_API URPGUIManagerSubsystem : public UGameInstanceSubsystem
@@ -20,14 +27,24 @@ class RPGRUNTIME_API URPGUIManagerSubsystem : public UGameInstanceSubsystem
 public:
 	URPGUIManagerSubsystem();
 
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
 	const URPGUIPolicy* GetCurrentUIPolicy() const { return CurrentPolicy; }
 	URPGUIPolicy* GetCurrentUIPolicy() { return CurrentPolicy; }
 
+	// Calls the delegate with the player's root layout if it already exists, or once the policy created it.
+	// Returns a handle to unregister with while the delegate is still waiting, invalid if it was called immediately.
+	FDelegateHandle CallOrRegister_OnRootLayoutReady(ULocalPlayer* LocalPlayer, FOnRPGRootLayoutReady::FDelegate&& Delegate);
+	void UnregisterOnRootLayoutReady(FDelegateHandle Handle);
+
+	/** Called by the policy once it created and displayed the root layout of a player. */
+	void NotifyRootLayoutCreated(UCommonLocalPlayer* LocalPlayer, URPGPrimaryGameLayout* RootLayout);
+
 protected:
 	void SwitchToPolicy(URPGUIPolicy* NewPolicy);
+	void HandleDefaultPolicyClassLoaded();
 
 	void OnLocalPlayerAdded(ULocalPlayer* LocalPlayer);
 	void OnLocalPlayerRemoved(ULocalPlayer* LocalPlayer);
@@ -38,4 +55,9 @@ protected:
 private:
 	UPROPERTY(Transient)
 	TObjectPtr<URPGUIPolicy> CurrentPolicy;
+
+	TSharedPtr<FStreamableHandle> DefaultPolicyClassHandle;
+
+	// Waiting for the root layout of a player, in request order
+	TArray<TPair<TWeakObjectPtr<UCommonLocalPlayer>, FOnRPGRootLayoutReady::FDelegate>> PendingRootLayoutRequests;
 };
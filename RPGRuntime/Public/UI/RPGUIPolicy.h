@@ -8,11 +8,13 @@
 class URPGPrimaryGameLayout;
 class ULocalPlayer;
 class UCommonLocalPlayer;
+struct FStreamableHandle;
 
 /**
  * URPGUIPolicy
  *
  * The policy for how to layout the game UI.
+ * The layout class is streamed in asynchronously, layouts of players added before it arrived are created once it did.
  */
 UCLASS(Abstract, Blueprintable, Within = RPGUIManagerSubsystem)
 class RPGRUNTIME_API URPGUIPolicy : public UObject
@@ -24,8 +26,15 @@ public:
 
 	virtual UWorld* GetWorld() const override;
 	
+	/** Returns the player's root layout, starting its creation if there is none. May return null while the layout class streams in. */
 	URPGPrimaryGameLayout* GetRootLayout(const UCommonLocalPlayer* LocalPlayer) const;
 
+	/** Returns the player's root layout if it has been created. */
+	URPGPrimaryGameLayout* FindRootLayout(const UCommonLocalPlayer* LocalPlayer) const { return RootLayouts.FindRef(LocalPlayer); }
+
+	/** Starts streaming the layout class so the first player doesn't wait for it. */
+	void PreloadLayoutClass();
+
 	/** Notification that a local player has been added. */
 	void NotifyPlayerAdded(UCommonLocalPlayer* LocalPlayer);
 
@@ -37,6 +46,7 @@ public:
 
 protected:
 	void CreateLayoutWidget(UCommonLocalPlayer* LocalPlayer);
+	void HandleLayoutClassLoaded();
 
 	UPROPERTY(EditAnywhere, Category = "Layout")
 	TSoftClassPtr<URPGPrimaryGameLayout> LayoutClass;
@@ -44,4 +54,10 @@ protected:
 private:
 	UPROPERTY(Transient)
 	TMap<TObjectPtr<const UCommonLocalPlayer>, TObjectPtr<URPGPrimaryGameLayout>> RootLayouts;
+
+	// Keeps the layout class resident for the lifetime of the policy
+	TSharedPtr<FStreamableHandle> LayoutClassHandle;
+
+	// Players whose layout waits for the layout class
+	TArray<TWeakObjectPtr<UCommonLocalPlayer>> PendingLayoutPlayers;
 };
@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RPGUITweenSubsystem.generated.h"
+
+class FOutputDevice;
+
+DECLARE_DELEGATE_OneParam(FRPGUITweenUpdate, float /*Value*/);
+
+/**
+ * URPGUITweenSubsystem
+ *
+ *	Shared scheduler for UI value interpolation (health and stamina bars, counters).
+ *	Widgets start a tween when their value changes instead of ticking; only the active tweens are advanced
+ *	and the subsystem stops ticking once all of them have settled, so idle widgets cost nothing.
+ *	Every widget owns at most one tween, starting a new one retargets it.
+ */
+UCLASS()
+class RPGRUNTIME_API URPGUITweenSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static URPGUITweenSubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	//~End of FTickableGameObject interface
+
+	/**
+	 * Interpolates from From to To at InterpSpeed (see FMath::FInterpTo) after waiting Delay seconds.
+	 * OnUpdate is called with the value of every step and a last time with To once it has settled.
+	 * Replaces the tween the owner already had. The tween is dropped if the owner is destroyed.
+	 */
+	void PlayTween(const UObject* Owner, float From, float To, float InterpSpeed, float Delay, FRPGUITweenUpdate&& OnUpdate);
+
+	/** Drops the tween of the owner without calling it again. */
+	void StopTween(const UObject* Owner);
+
+	bool IsTweening(const UObject* Owner) const;
+
+	int32 GetNumActiveTweens() const { return Tweens.Num(); }
+
+	void DumpToOutputDevice(FOutputDevice& Ar) const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+	struct FTween
+	{
+		TWeakObjectPtr<const UObject> Owner;
+		FRPGUITweenUpdate OnUpdate;
+		float Current = 0.0f;
+		float Target = 0.0f;
+		float InterpSpeed = 0.0f;
+		float Delay = 0.0f;
+		bool bFinished = false;
+	};
+
+	int32 FindTweenIndex(const UObject* Owner) const;
+
+private:
+	TArray<FTween> Tweens;
+	bool bIsTicking = false;
+};
@@ -18,4 +18,9 @@ class RPGRUNTIME_API URPGUserWidget : public UCommonUserWidget
 
 public:
 	URPGUserWidget(const FObjectInitializer& ObjectInitializer);
+
+protected:
+	//~UUserWidget interface
+	virtual void NativeConstruct() override;
+	//~End of UUserWidget interface
 };
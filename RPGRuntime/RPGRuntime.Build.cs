@@ -49,6 +49,10 @@ public class RPGRuntime : ModuleRules
 			// Animation runtime (OK)
 			"AnimGraphRuntime",
 
+			// Context effects (surface lookup + pooled Niagara)
+			"PhysicsCore",
+			"Niagara",
+
 			// Optional nhưng an toàn
 			"MotionWarping",
 			"ContextualAnimation"